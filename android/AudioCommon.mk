@@ -18,6 +18,7 @@ LOCAL_SRC_FILES := \
     ../private/src/common/IasDataProbeHelper.cpp \
     ../private/src/common/IasIntProcCondVar.cpp \
     ../private/src/common/IasIntProcMutex.cpp \
+    ../private/src/common/IasIntProcFutex.cpp \
     ../private/src/common/IasFdSignal.cpp \
     ../private/src/common/IasCommonVersion.cpp
 
@@ -32,6 +33,9 @@ LOCAL_SRC_FILES += \
     ../private/src/audiobuffer/IasAudioRingBufferResult.cpp \
     ../private/src/audiobuffer/IasAudioRingBufferReal.cpp \
     ../private/src/audiobuffer/IasAudioRingBufferMirror.cpp \
+    ../private/src/audiobuffer/IasAudioRingBufferGroup.cpp \
+    ../private/src/audiobuffer/IasAudioRingBufferPool.cpp \
+    ../private/src/audiobuffer/IasAudioRingBufferRegistry.cpp \
     ../private/src/audiobuffer/IasAudioRingBufferFactory.cpp
 
 LOCAL_SRC_FILES += \
@@ -41,7 +45,8 @@ LOCAL_SRC_FILES += \
     ../private/src/samplerateconverter/IasSrcWrapper.cpp
 
 LOCAL_SRC_FILES += \
-    ../private/src/helper/IasCopyAudioAreaBuffers.cpp
+    ../private/src/helper/IasCopyAudioAreaBuffers.cpp \
+    ../private/src/helper/IasCpuFeatures.cpp
 
 LOCAL_C_INCLUDES := \
     $(LOCAL_PATH)/../public/inc \
@@ -63,10 +63,13 @@ class IasSrcFarrowFirFilter
      * @param[in] maxFilterLength      Maximum length of the FIR filters.
      * @param[in] numImpulseResponses  Number of different impulse responses.
      * @param[in] maxNumInputChannels  Maximum number of input channels.
+     * @param[in] maxBlockLength       Maximum number of input samples that can be inserted
+     *                                 by one call of multiInputInsertBlock().
      */
     int init(uint32_t  maxFilterLength,
              uint32_t  numImpulseResponses,
-             uint32_t  maxNumInputChannels);
+             uint32_t  maxNumInputChannels,
+             uint32_t  maxBlockLength);
 
     /*!
      * @brief Set the filter length
@@ -169,7 +172,8 @@ class IasSrcFarrowFirFilter
      *
      * For this function, multiple versions (with and without SSE optimization)
      * have been implemented. The flag IASSRCFARROWCONFIG_USE_SSE controls
-     * which implementation is used.
+     * which implementation is used. The SSE variant switches to an AVX2/FMA
+     * kernel at runtime, if the CPU supports it (see getSimdLevel()).
      *
      * @param[out] outputBuffers     Vector with pointers to the M output buffers.
      *                               The current output sample of the M parallel
@@ -186,6 +190,92 @@ class IasSrcFarrowFirFilter
                                 uint32_t    outputBufferIndex,
                                 uint32_t    numChannels);
 
+    /*!
+     * @brief Insert a block of new input samples (of M input channels) into
+     *        the internal ring buffers.
+     *
+     * This function shall be used together with
+     * IasSrcFarrowFirFilter::multiInputProcessBlock(), which processes the
+     * output samples that belong to the inserted input samples.
+     *
+     * @param[in]  inputBuffers     Vector with pointers to the M input buffers.
+     * @param[in]  inputBufferIndex Index of the first sample inside @a inputBuffers
+     *                              (in samples, not multiplied by @a inputStride).
+     * @param[in]  inputStride      Distance between two samples of one channel.
+     * @param[in]  numSamples       Number of samples to insert, must not be greater
+     *                              than @a maxBlockLength, as defined during the
+     *                              initialization of the module.
+     * @param[in]  numInputChannels Actual number of input channels.
+     */
+    template <typename T>
+    int multiInputInsertBlock(T            const **inputBuffers,
+                              uint32_t          inputBufferIndex,
+                              uint32_t          inputStride,
+                              uint32_t          numSamples,
+                              uint32_t          numInputChannels);
+
+    /*!
+     * @brief Process the FIR filter for a block of output samples. Each output
+     *        sample has its own impulse response, which is jointly used for
+     *        all channels.
+     *
+     * The output samples refer to input samples that have been inserted by the last
+     * call of multiInputInsertBlock(). For each output sample, @a inputDelays
+     * specifies how many of the inserted samples are newer than this output sample,
+     * i.e., 0 means that the output sample is calculated after all inserted samples.
+     *
+     * @param[out] outputBuffers        Vector with pointers to the M output buffers.
+     * @param[in]  outputBufferIndices  Position (inside outputBuffers) of each output sample.
+     * @param[in]  inputDelays          Input delay of each output sample, not greater than
+     *                                  @a maxBlockLength.
+     * @param[in]  impulseResponses     Vector with pointers to the impulse responses of the output
+     *                                  samples, each of them 16-byte aligned and padded with zeros
+     *                                  to a multiple of 4 coefficients. Output samples may share
+     *                                  one impulse response.
+     * @param[in]  numOutputSamples     Number of output samples to generate.
+     * @param[in]  numChannels          Actual number of channels.
+     */
+    template <typename T>
+    int multiInputProcessBlock(T              **outputBuffers,
+                               uint32_t const  *outputBufferIndices,
+                               uint32_t const  *inputDelays,
+                               float    const * const *impulseResponses,
+                               uint32_t         numOutputSamples,
+                               uint32_t         numChannels);
+
+    /*!
+     * @brief Process the FIR filter for a block of output samples by means of the
+     *        classic Farrow structure: each channel is filtered by all sub-filters
+     *        and the output sample is the polynomial in its t value, whose coefficients
+     *        are the outputs of the sub-filters (evaluated by Horner's method).
+     *
+     * This is the counterpart of multiInputProcessBlock() for the case that the output
+     * samples do not provide their own impulse responses. The sub-filter outputs are
+     * calculated only once for all output samples with the same input delay, which
+     * must follow each other.
+     *
+     * @param[out] outputBuffers        Vector with pointers to the M output buffers.
+     * @param[in]  outputBufferIndices  Position (inside outputBuffers) of each output sample.
+     * @param[in]  inputDelays          Input delay of each output sample, see multiInputProcessBlock().
+     * @param[in]  tValues              The t value of each output sample.
+     * @param[in]  subFilters           Vector with pointers to the sub-filters, each of them
+     *                                  16-byte aligned and with the current filter length.
+     * @param[in]  numSubFilters        Number of sub-filters, not greater than cMaxNumSubFilters.
+     * @param[in]  numOutputSamples     Number of output samples to generate.
+     * @param[in]  numChannels          Actual number of channels.
+     */
+    template <typename T>
+    int multiInputProcessBlockFarrow(T                   **outputBuffers,
+                                     uint32_t const       *outputBufferIndices,
+                                     uint32_t const       *inputDelays,
+                                     float    const       *tValues,
+                                     float    const * const *subFilters,
+                                     uint32_t              numSubFilters,
+                                     uint32_t              numOutputSamples,
+                                     uint32_t              numChannels);
+
+    uint32_t static const cMaxNumSubFilters = 8; //!< maximum number of sub-filters of multiInputProcessBlockFarrow()
+
 #if IASSRCFARROWCONFIG_USE_SSE
     inline uint32_t getPaddingForSSE() { return mPaddingForSSE; }
 #endif // #if IASSRCFARROWCONFIG_USE_SSE
@@ -201,6 +291,42 @@ class IasSrcFarrowFirFilter
      */
     IasSrcFarrowFirFilter& operator=(IasSrcFarrowFirFilter const &other); //lint !e1704
 
+#if IASSRCFARROWCONFIG_USE_SSE
+    /*!
+     *  @brief Calculate one output sample of all channels, using the SSE or the AVX2/FMA
+     *         kernel (selected at runtime).
+     *
+     *  The AVX2/FMA kernel processes the channels in passes of 8 (and 4, 3, 2, 1 for
+     *  the remaining channels) with one accumulator per channel. It is used for three
+     *  or more channels only.
+     *
+     *  @param[in] index           Position of the newest input sample inside the ring buffers.
+     *  @param[in] impulseResponse The impulse response, 16-byte aligned.
+     *  @param[in] numBlocks       Number of 4-tap blocks to process.
+     */
+    template <typename T>
+    void multiInputConvolve(T            **outputBuffers,
+                            uint32_t    outputBufferIndex,
+                            uint32_t    index,
+                            float const *impulseResponse,
+                            uint32_t    numBlocks,
+                            uint32_t    numChannels);
+
+    /*!
+     *  @brief Calculate the outputs of all sub-filters for one window of one channel,
+     *         using the SSE or the AVX2/FMA kernel (selected at runtime).
+     *
+     *  @param[out] subFilterOutputs Vector for the numSubFilters sub-filter outputs.
+     *  @param[in]  window           The newest input sample of the window inside the ring buffer.
+     *  @param[in]  numBlocks        Number of 4-tap blocks to process.
+     */
+    void subFilterConvolve(float       *subFilterOutputs,
+                           float const *window,
+                           float const * const *subFilters,
+                           uint32_t    numSubFilters,
+                           uint32_t    numBlocks);
+#endif // #if IASSRCFARROWCONFIG_USE_SSE
+
 
     /*!
      *  Member variables.
@@ -212,9 +338,12 @@ class IasSrcFarrowFirFilter
 
 #if IASSRCFARROWCONFIG_USE_SSE
     uint32_t          mPaddingForSSE;       //!< offset for SSE
+    bool              mUseAvx2;             //!< true if the AVX2/FMA kernel is used instead of the SSE kernel
 #endif
 
     uint32_t          mMaxFilterLength;     //!< maximum length of (each) impulse response
+    uint32_t          mMaxBlockLength;      //!< maximum number of input samples inserted as one block
+    uint32_t          mRingBufferLength;    //!< length of each ring buffer: mMaxFilterLength + mMaxBlockLength, multiple of 4
     uint32_t          mFilterLength;        //!< actual length of (each) impulse response
     uint32_t          mNumImpulseResponses; //!< number of impulse responses to be applied in parallel
     uint32_t          mMaxNumInputChannels; //!< maximum number of input channels to be processed in parallel
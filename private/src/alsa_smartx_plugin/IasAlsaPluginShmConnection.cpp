@@ -11,9 +11,11 @@
  */
 
 #include <string>
+#include <algorithm>
 
 #include "internal/audio/common/audiobuffer/IasAudioRingBuffer.hpp"
 #include "internal/audio/common/audiobuffer/IasAudioRingBufferFactory.hpp"
+#include "internal/audio/common/audiobuffer/IasAudioRingBufferReal.hpp"
 #include "audio/common/audiobuffer/IasMemoryAllocator.hpp"
 
 #include "internal/audio/common/alsa_smartx_plugin/IasAlsaPluginShmConnection.hpp"
@@ -44,7 +46,8 @@ IasAlsaPluginShmConnection::IasAlsaPluginShmConnection()
   ,mConstraints(nullptr)
   ,mRingBufferName()
   ,mRingBuffer(nullptr)
-  ,mUpdateAvailable(nullptr)
+  ,mGeneration(nullptr)
+  ,mRingBufferGeneration(0)
   ,mAllocator(nullptr)
   ,mIsCreator(false)
   ,mFdSignal()
@@ -98,7 +101,7 @@ IasAudioCommonResult IasAlsaPluginShmConnection::createConnection(const std::str
   uint32_t totalSize = static_cast<uint32_t>(2 * sizeof(IasAudioIpc) +
                                                    sizeof(IasAlsaHwConstraintsStatic) +
                                                    2 * sizeof(int32_t) +
-                                                   sizeof(bool));
+                                                   sizeof(std::atomic<uint32_t>));
 
   // Get an allocator
   mAllocator = new IasMemoryAllocator(connectionName+"_connection", totalSize ,true);
@@ -133,15 +136,13 @@ IasAudioCommonResult IasAlsaPluginShmConnection::createConnection(const std::str
     return result;
   }
 
-  // Allocate space for the Update flag
+  // Allocate space for the ringbuffer generation, it is zero-initialized and even, i.e. no update in progress
   if( eIasResultOk !=
-    (result = mAllocator->allocate<bool>(connectionName + "_updateflag", 1, &mUpdateAvailable)))
+    (result = mAllocator->allocate<std::atomic<uint32_t>>(connectionName + "_generation", 1, &mGeneration)))
   {
-    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, "Fail to create a update flag: error=", toString(result));
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, "Fail to create the ringbuffer generation: error=", toString(result));
     return result;
   }
-  // Init update flag status
-  *mUpdateAvailable = true;
 
   IasAudioIpc* tempIpc;
 
@@ -159,7 +160,8 @@ IasAudioCommonResult IasAlsaPluginShmConnection::createConnection(const std::str
   return result;
 }
 
-IasAudioCommonResult IasAudio::IasAlsaPluginShmConnection::createRingBuffer(const IasAudioDeviceParamsPtr configStruct)
+IasAudioCommonResult IasAudio::IasAlsaPluginShmConnection::createRingBuffer(const IasAudioDeviceParamsPtr configStruct,
+                                                                            const IasAudioRingBufferOptions &options)
 {
   if(!mIsCreator)
   {
@@ -175,8 +177,35 @@ IasAudioCommonResult IasAudio::IasAlsaPluginShmConnection::createRingBuffer(cons
 
   IasAudioCommonResult result(eIasResultOk);
 
-  // Destroy Ringbuffer
-  *mUpdateAvailable = false;
+  // If the plugin may only be opened with the interleaved layout, use the same layout for the
+  // ringbuffer. Then the transfer between the client buffer and the ringbuffer is a straight copy.
+  IasAudioRingBufferOptions ringBufferOptions = options;
+  if (mConstraints->isValid == true &&
+      mConstraints->access.list.size() > 0 &&
+      std::all_of(mConstraints->access.list.begin(), mConstraints->access.list.end(),
+                  [](IasAudioCommonDataLayout layout) { return layout == eIasLayoutInterleaved; }))
+  {
+    ringBufferOptions.dataLayout = eIasLayoutInterleaved;
+  }
+
+  // If only the geometry changes, the existing ringbuffer is reconfigured in place. The clients keep
+  // their mapping and pick up the new geometry on their next access.
+  IasAudioCommonDataFormat currentFormat = eIasFormatUndef;
+  const IasAudioRingBufferReal *currentReal = (mRingBuffer != nullptr) ? mRingBuffer->getReal() : nullptr;
+  if (currentReal != nullptr &&
+      mRingBuffer->getDataFormat(&currentFormat) == eIasRingBuffOk &&
+      currentFormat == configStruct->dataFormat &&
+      currentReal->getDataLayout() == ringBufferOptions.dataLayout &&
+      currentReal->getSyncMode() == ringBufferOptions.syncMode &&
+      IasAudioRingBufferFactory::getInstance()->reconfigureRingBuffer(mRingBuffer, configStruct->periodSize,
+                                                                      configStruct->numPeriods,
+                                                                      configStruct->numChannels) == eIasResultOk)
+  {
+    return eIasResultOk;
+  }
+
+  // Destroy Ringbuffer. The odd generation tells the clients that the update is in progress.
+  mGeneration->fetch_add(1, std::memory_order_acq_rel);
 
   if(mRingBuffer)
   {
@@ -189,7 +218,8 @@ IasAudioCommonResult IasAudio::IasAlsaPluginShmConnection::createRingBuffer(cons
                      configStruct->numPeriods, configStruct->numChannels,
                      configStruct->dataFormat, eIasRingBufferShared,
                      mRingBufferName,
-                     mGroupName);
+                     mGroupName,
+                     ringBufferOptions);
   if (result == eIasResultOk)
   {
     // Ringbuffer successfully created, now create the fdsignal
@@ -230,7 +260,8 @@ IasAudioCommonResult IasAudio::IasAlsaPluginShmConnection::createRingBuffer(cons
     }
   }
 
-  *mUpdateAvailable = true;
+  // Even again, the clients map the new ringbuffer on their next access
+  mGeneration->fetch_add(1, std::memory_order_release);
   return result;
 }
 
@@ -253,7 +284,7 @@ IasAudioCommonResult IasAlsaPluginShmConnection::findConnection(const std::strin
   uint32_t totalSize = static_cast<uint32_t>(2 * sizeof(IasAudioIpc) +
                                                    sizeof(IasAlsaHwConstraintsStatic) +
                                                    2 * sizeof(int32_t) +
-                                                   sizeof(bool));
+                                                   sizeof(std::atomic<uint32_t>));
 
   // Get an allocator
   mAllocator = new IasMemoryAllocator(connectionName+"_connection", totalSize ,true);
@@ -281,11 +312,11 @@ IasAudioCommonResult IasAlsaPluginShmConnection::findConnection(const std::strin
     return result;
   }
 
-  // Allocate space for the Update flag
+  // Try to find the ringbuffer generation
   if( eIasResultOk !=
-    (result = mAllocator->find<bool>(connectionName + "_updateflag", &dumpCount, &mUpdateAvailable)))
+    (result = mAllocator->find<std::atomic<uint32_t>>(connectionName + "_generation", &dumpCount, &mGeneration)))
   {
-    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_DEVICE, "Fail to find the update flag: error=", toString(result));
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_DEVICE, "Fail to find the ringbuffer generation: error=", toString(result));
     return result;
   }
 
@@ -315,27 +346,44 @@ IasAudioCommonResult IasAlsaPluginShmConnection::findConnection(const std::strin
 
 IasAudioRingBuffer* IasAlsaPluginShmConnection::verifyAndGetRingBuffer()
 {
-  if(*mUpdateAvailable || !mRingBuffer)
+  // The creator owns the ringbuffer, there is nothing to refresh
+  if (mIsCreator || mGeneration == nullptr)
   {
-    // Get the factory
-    IasAudioRingBufferFactory* factory = IasAudioRingBufferFactory::getInstance();
-    if(!factory)
-    {
-      DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, "Ringbuffer Factory can't be reached.");
-      return nullptr;
-    }
+    return mRingBuffer;
+  }
+  const uint32_t generation = mGeneration->load(std::memory_order_acquire);
+  if ((mRingBuffer != nullptr && generation == mRingBufferGeneration) || (generation & 1u) != 0)
+  {
+    // Either the cached ringbuffer is still current, or the server is replacing it right now. In the latter case
+    // the old mapping stays valid in this process and is kept until the new ringbuffer is complete.
+    return mRingBuffer;
+  }
+
+  // Get the factory
+  IasAudioRingBufferFactory* factory = IasAudioRingBufferFactory::getInstance();
+  if(!factory)
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, "Ringbuffer Factory can't be reached.");
+    return nullptr;
+  }
 
-    // Find an instance from the sample buffer
-    mRingBuffer = factory->findRingBuffer(mRingBufferName);
+  // Unmap the stale ringbuffer before the new one is mapped
+  if (mRingBuffer != nullptr)
+  {
+    factory->loseRingBuffer(mRingBuffer);
+    mRingBuffer = nullptr;
+  }
 
-    if(nullptr == mRingBuffer)
-    {
-      DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, "Fail to find a Ringbuffer.");
-    }
-    else
-    {
-      *mUpdateAvailable = false;
-    }
+  // Find an instance from the sample buffer
+  mRingBuffer = factory->findRingBuffer(mRingBufferName);
+
+  if(nullptr == mRingBuffer)
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, "Fail to find a Ringbuffer.");
+  }
+  else
+  {
+    mRingBufferGeneration = generation;
   }
 
   return mRingBuffer;
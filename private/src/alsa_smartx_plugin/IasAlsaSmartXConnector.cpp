@@ -561,14 +561,16 @@ snd_pcm_sframes_t IasAlsaSmartXConnector::getFramePointer()
   IAS_ASSERT(mSmartxConnection != nullptr);
   IasAudioRingBuffer* ringBuffer = mSmartxConnection->verifyAndGetRingBuffer();
   IAS_ASSERT(ringBuffer != nullptr);
+  IasAudioRingBufferState state;
+  ringBuffer->getState(&state);
   int64_t available = 0;
   if (mAlsaIoPlugData->stream == SND_PCM_STREAM_CAPTURE)
   {
-    available = ringBuffer->getHwPtrWrite();
+    available = state.hwPtrWrite;
   }
   else
   {
-    available = ringBuffer->getHwPtrRead();
+    available = state.hwPtrRead;
   }
   returnValue = static_cast<snd_pcm_sframes_t>(available);
 
@@ -585,7 +587,8 @@ snd_pcm_sframes_t IasAlsaSmartXConnector::transferJob(const snd_pcm_channel_area
     return size;
   }
   IasAudioRingBufferResult result = eIasRingBuffOk;
-  uint32_t shmOffset = 0;
+  IasAudioRingBufferRegion shmHead;
+  IasAudioRingBufferRegion shmTail;
   if(size > static_cast<uint64_t>(std::numeric_limits<uint32_t>::max()))
   {
     DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_DEVICE, "Cannot handle the size, transfer is too long: size=", static_cast<int32_t>(size));
@@ -624,9 +627,10 @@ snd_pcm_sframes_t IasAlsaSmartXConnector::transferJob(const snd_pcm_channel_area
     }
   }
 
-  // Acquire lock
+  // Acquire lock. The access may wrap around the end of the ring buffer, in this case the
+  // frames are split into a head and a tail region that are committed with one endAccess.
   if(eIasRingBuffOk !=
-    (result = ringBuffer->beginAccess(shmAccess, &mShmAreas, &shmOffset, &shmFrames)))
+    (result = ringBuffer->beginAccess(shmAccess, &mShmAreas, &shmHead, &shmTail, &shmFrames)))
   {
     DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_DEVICE, "Can't acquire buffer for access. IasAudioCommonResult:", toString(result));
     mAlsaIoPlugData->state = SND_PCM_STATE_XRUN;
@@ -646,7 +650,7 @@ snd_pcm_sframes_t IasAlsaSmartXConnector::transferJob(const snd_pcm_channel_area
       DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_DEVICE, "Xrun: No more space/samples in buffer");
       mAlsaIoPlugData->state = SND_PCM_STATE_XRUN;
       // Ensure we do a proper clean-up of the beginAccess call by calling endAccess
-      result = ringBuffer->endAccess(shmAccess, shmOffset, shmFrames);
+      result = ringBuffer->endAccess(shmAccess, shmHead.offset, shmFrames);
       IAS_ASSERT(result == eIasRingBuffOk);
       (void)result;
       return -EPIPE;
@@ -658,7 +662,7 @@ snd_pcm_sframes_t IasAlsaSmartXConnector::transferJob(const snd_pcm_channel_area
     if (shmFrames == 0)
     {
       // Ensure we do a proper clean-up of the beginAccess call by calling endAccess
-      result = ringBuffer->endAccess(shmAccess, shmOffset, 0);
+      result = ringBuffer->endAccess(shmAccess, shmHead.offset, 0);
       IAS_ASSERT(result == eIasRingBuffOk);
       (void)result;
       return -EAGAIN;
@@ -670,7 +674,7 @@ snd_pcm_sframes_t IasAlsaSmartXConnector::transferJob(const snd_pcm_channel_area
   {
     DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_DEVICE, "Channelcount missmatch in current transferJob.");
     // Ensure we do a proper clean-up of the beginAccess call by calling endAccess
-    result = ringBuffer->endAccess(shmAccess, shmOffset, shmFrames);
+    result = ringBuffer->endAccess(shmAccess, shmHead.offset, shmFrames);
     IAS_ASSERT(result == eIasRingBuffOk);
     (void)result;
     return -EINVAL;
@@ -687,6 +691,8 @@ snd_pcm_sframes_t IasAlsaSmartXConnector::transferJob(const snd_pcm_channel_area
    */
   snd_pcm_format_t temporaryFormat = convertFormatIasToAlsa(mSetParams.dataFormat);
   uint32_t minFrameCount = std::min<uint32_t>(static_cast<uint32_t>(size), shmFrames);
+  uint32_t headFrameCount = std::min<uint32_t>(minFrameCount, shmHead.frames);
+  uint32_t tailFrameCount = minFrameCount - headFrameCount;
   int err = 0;
   if (minFrameCount < mSetParams.periodSize)
   {
@@ -697,11 +703,19 @@ snd_pcm_sframes_t IasAlsaSmartXConnector::transferJob(const snd_pcm_channel_area
 
   if(direction == eIasPlaybackTransfer)
   {
-    err = snd_pcm_areas_copy(mAlsaTransferAreas, shmOffset, areas, offset, mSetParams.numChannels, minFrameCount, temporaryFormat);
+    err = snd_pcm_areas_copy(mAlsaTransferAreas, shmHead.offset, areas, offset, mSetParams.numChannels, headFrameCount, temporaryFormat);
+    if ((err == 0) && (tailFrameCount > 0))
+    {
+      err = snd_pcm_areas_copy(mAlsaTransferAreas, shmTail.offset, areas, offset + headFrameCount, mSetParams.numChannels, tailFrameCount, temporaryFormat);
+    }
   }
   else
   {
-    err = snd_pcm_areas_copy(areas, offset, mAlsaTransferAreas, shmOffset, mSetParams.numChannels, minFrameCount, temporaryFormat);
+    err = snd_pcm_areas_copy(areas, offset, mAlsaTransferAreas, shmHead.offset, mSetParams.numChannels, headFrameCount, temporaryFormat);
+    if ((err == 0) && (tailFrameCount > 0))
+    {
+      err = snd_pcm_areas_copy(areas, offset + headFrameCount, mAlsaTransferAreas, shmTail.offset, mSetParams.numChannels, tailFrameCount, temporaryFormat);
+    }
   }
   if(err)
   {
@@ -713,7 +727,7 @@ snd_pcm_sframes_t IasAlsaSmartXConnector::transferJob(const snd_pcm_channel_area
 
   // Release lock
   if(eIasRingBuffOk !=
-    (result = ringBuffer->endAccess(shmAccess, shmOffset, minFrameCount)))
+    (result = ringBuffer->endAccess(shmAccess, shmHead.offset, minFrameCount)))
   {
     DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_DEVICE, "Can't end the buffer access. IasAudioCommonResult:", toString(result));
     return -EPIPE;
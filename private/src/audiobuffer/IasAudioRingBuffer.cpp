@@ -25,6 +25,10 @@ IasAudioRingBuffer::IasAudioRingBuffer()
 ,mReal(true)
 ,mNumChannels(0)
 ,mName("uninitialized")
+,mGeneration(0)
+,mMutexAreas()
+,mPoolGeneration(nullptr)
+,mExpectedPoolGeneration(0)
 {
   //Nothing to do here
 }
@@ -44,7 +48,9 @@ IasAudioRingBufferResult IasAudioRingBuffer::init(uint32_t periodSize,
                                                        void* dataBuf,
                                                        bool shared,
                                                        IasMetaData* metaData,
-                                                       IasAudioRingBufferReal* ringBufReal)
+                                                       IasAudioRingBufferReal* ringBufReal,
+                                                       const IasAudioRingBufferOptions &options,
+                                                       bool doubleMapped)
 {
   if (ringBufReal == nullptr     ||
       dataBuf == nullptr         ||
@@ -62,25 +68,15 @@ IasAudioRingBufferResult IasAudioRingBuffer::init(uint32_t periodSize,
                                                     dataFormat,
                                                     dataBuf,
                                                     shared,
-                                                    metaData);
+                                                    metaData,
+                                                    options,
+                                                    doubleMapped);
   if(res != eIasRingBuffOk)
   {
     return res;
   }
 
-  mAreas = new IasAudioArea[nChannels];
-  IAS_ASSERT(mAreas != nullptr);
-  mNumChannels = nChannels;
-
-  for(uint32_t i=0; i<nChannels; i++)
-  {
-    mAreas[i].start    = mRingBufReal->getDataBuffer();
-    mAreas[i].index    = i;
-    mAreas[i].maxIndex = nChannels-1;
-    mAreas[i].step     = toSize(dataFormat) * 8;
-    mAreas[i].first    = nPeriods * periodSize * toSize(dataFormat) * 8 * i;
-  }
-
+  updateAreas();
   mReal = true;
 
   return res;
@@ -114,36 +110,79 @@ IasAudioRingBufferResult IasAudioRingBuffer::setup(IasAudioRingBufferReal* ringB
   }
   mRingBufReal = ringBufReal;
 
-  mNumChannels = mRingBufReal->getNumChannels();
-  if(mNumChannels == 0)
+  if(mRingBufReal->getNumChannels() == 0)
   {
     return eIasRingBuffNotInitialized;
   }
-
-  void* dataBuf = mRingBufReal->getDataBuffer();
-  IAS_ASSERT(dataBuf != nullptr);
+  IAS_ASSERT(mRingBufReal->getDataBuffer() != nullptr);
 
   uint32_t sampleSize = mRingBufReal->getSampleSize();
   IAS_ASSERT(sampleSize > 0);
+  (void)sampleSize;
 
-  uint32_t periodSize = mRingBufReal->getPeriodSize();
-  IAS_ASSERT(periodSize > 0);
-
-  uint32_t numberPeriods = mRingBufReal->getNumberPeriods();
-  IAS_ASSERT(numberPeriods > 0);
+  updateAreas();
+  mReal = true;
+  return eIasRingBuffOk;
+}
 
-  mAreas = new IasAudioArea[mNumChannels];
-  IAS_ASSERT(mAreas != nullptr);
+void IasAudioRingBuffer::updateAreas()
+{
+  std::lock_guard<std::mutex> lock(mMutexAreas);
+  if (mAreas == nullptr)
+  {
+    mAreas = new IasAudioArea[mRingBufReal->getNumChannelsMax()];
+    IAS_ASSERT(mAreas != nullptr);
+  }
+  // Read the generation first, a concurrent reconfigure is then detected by the next check
+  mGeneration.store(mRingBufReal->getGeneration(), std::memory_order_release);
+  mNumChannels = mRingBufReal->getNumChannels();
+  IAS_ASSERT(mNumChannels <= mRingBufReal->getNumChannelsMax());
+  void* dataBuf = mRingBufReal->getDataBuffer();
   for(uint32_t i=0; i<mNumChannels; i++)
   {
     mAreas[i].start    = dataBuf;
     mAreas[i].index    = i;
     mAreas[i].maxIndex = mNumChannels-1;
-    mAreas[i].step     = sampleSize * 8;
-    mAreas[i].first    = numberPeriods * periodSize * sampleSize * 8 * i;
+    mAreas[i].step     = mRingBufReal->getFrameStride() * 8;
+    mAreas[i].first    = mRingBufReal->getPlaneStride() * 8 * i;
   }
-  mReal = true;
-  return eIasRingBuffOk;
+}
+
+void IasAudioRingBuffer::checkGeneration()
+{
+  if (mRingBufReal->getGeneration() != mGeneration.load(std::memory_order_acquire))
+  {
+    updateAreas();
+  }
+}
+
+void IasAudioRingBuffer::setPoolGeneration(const std::atomic<uint32_t> *poolGeneration, uint32_t generation)
+{
+  mPoolGeneration = poolGeneration;
+  mExpectedPoolGeneration = generation;
+}
+
+IasAudioRingBufferResult IasAudioRingBuffer::reconfigure(uint32_t periodSize, uint32_t nPeriods, uint32_t nChannels, void* dataBuf)
+{
+  if (!mReal)
+  {
+    return eIasRingBuffNotAllowed;
+  }
+  IasAudioRingBufferResult res = mRingBufReal->reconfigure(periodSize, nPeriods, nChannels, dataBuf);
+  if (res == eIasRingBuffOk)
+  {
+    updateAreas();
+  }
+  return res;
+}
+
+uint32_t IasAudioRingBuffer::getGeneration() const
+{
+  if (mReal)
+  {
+    return mRingBufReal->getGeneration();
+  }
+  return 0;
 }
 
 IasAudioRingBufferResult IasAudioRingBuffer::setDeviceHandle(void* handle, uint32_t periodSize, uint32_t timeout_ms)
@@ -242,8 +281,16 @@ IasAudioRingBufferResult IasAudioRingBuffer::beginAccess(IasRingBufferAccess acc
   }
   if (mReal)
   {
-    *area = mAreas;
+    if (isErasedFromPool())
+    {
+      return eIasRingBuffNotAllowed;
+    }
     res = mRingBufReal->beginAccess(access,offset,frames);
+    if (res == eIasRingBuffOk)
+    {
+      checkGeneration();
+    }
+    *area = mAreas;
   }
   else
   {
@@ -253,6 +300,52 @@ IasAudioRingBufferResult IasAudioRingBuffer::beginAccess(IasRingBufferAccess acc
   return res;
 }
 
+IasAudioRingBufferResult IasAudioRingBuffer::beginAccess(IasRingBufferAccess access, IasAudioArea** area,
+                                                        IasAudioRingBufferRegion* head, IasAudioRingBufferRegion* tail, uint32_t* frames)
+{
+  IasAudioRingBufferResult res = eIasRingBuffOk;
+  if (area == NULL || head == NULL || tail == NULL || frames == NULL  || access == eIasRingBufferAccessUndef)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  tail->offset = 0;
+  tail->frames = 0;
+  if (mReal)
+  {
+    if (isErasedFromPool())
+    {
+      head->frames = 0;
+      return eIasRingBuffNotAllowed;
+    }
+    res = mRingBufReal->beginAccess(access, &head->offset, frames, true);
+    if (res != eIasRingBuffOk)
+    {
+      *area = mAreas;
+      head->frames = 0;
+      return res;
+    }
+    checkGeneration();
+    *area = mAreas;
+    const uint32_t bufferSize = mRingBufReal->getNumberPeriods() * mRingBufReal->getPeriodSize();
+    if ((head->offset + *frames) > bufferSize)
+    {
+      head->frames = bufferSize - head->offset;
+      tail->frames = *frames - head->frames;
+    }
+    else
+    {
+      head->frames = *frames;
+    }
+  }
+  else
+  {
+    res = mRingBufMirror->beginAccess(mAreas, &head->offset, frames);
+    head->frames = *frames;
+    *area = mAreas;
+  }
+  return res;
+}
+
 IasAudioRingBufferResult IasAudioRingBuffer::endAccess(IasRingBufferAccess access, uint32_t offset, uint32_t frames)
 {
 
@@ -262,6 +355,10 @@ IasAudioRingBufferResult IasAudioRingBuffer::endAccess(IasRingBufferAccess acces
   }
   if (mReal)
   {
+    if (isErasedFromPool())
+    {
+      return eIasRingBuffNotAllowed;
+    }
     return mRingBufReal->endAccess(access,offset,frames);
   }
   else
@@ -270,6 +367,226 @@ IasAudioRingBufferResult IasAudioRingBuffer::endAccess(IasRingBufferAccess acces
   }
 }
 
+IasAudioRingBufferResult IasAudioRingBuffer::peek(uint32_t offsetFromRead, const IasAudioArea** area, uint32_t* offset, uint32_t* frames)
+{
+  if (area == NULL || offset == NULL || frames == NULL)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  if (mReal)
+  {
+    if (isErasedFromPool())
+    {
+      return eIasRingBuffNotAllowed;
+    }
+    // The region has to belong to the geometry of the areas, so peek again if a reconfigure came in between
+    const uint32_t wantedFrames = *frames;
+    uint32_t generation = 0;
+    IasAudioRingBufferResult res = eIasRingBuffOk;
+    do
+    {
+      checkGeneration();
+      *frames = wantedFrames;
+      res = mRingBufReal->peek(offsetFromRead, offset, frames, &generation);
+    } while (res == eIasRingBuffOk && generation != mGeneration.load(std::memory_order_acquire));
+    *area = mAreas;
+    return res;
+  }
+  else
+  {
+    return eIasRingBuffNotAllowed;
+  }
+}
+
+IasAudioRingBufferResult IasAudioRingBuffer::consume(uint32_t frames)
+{
+  if (mReal)
+  {
+    if (isErasedFromPool())
+    {
+      return eIasRingBuffNotAllowed;
+    }
+    return mRingBufReal->consume(frames);
+  }
+  else
+  {
+    return eIasRingBuffNotAllowed;
+  }
+}
+
+IasAudioRingBufferResult IasAudioRingBuffer::attachReader(uint32_t* readerId)
+{
+  if (readerId == NULL)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  if (mReal)
+  {
+    return mRingBufReal->attachReader(readerId);
+  }
+  else
+  {
+    return eIasRingBuffNotAllowed;
+  }
+}
+
+IasAudioRingBufferResult IasAudioRingBuffer::detachReader(uint32_t readerId)
+{
+  if (mReal)
+  {
+    return mRingBufReal->detachReader(readerId);
+  }
+  else
+  {
+    return eIasRingBuffNotAllowed;
+  }
+}
+
+IasAudioRingBufferResult IasAudioRingBuffer::updateAvailableRead(uint32_t readerId, uint32_t* samples)
+{
+  if (samples == NULL)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  if (mReal)
+  {
+    return mRingBufReal->updateAvailableRead(readerId, samples);
+  }
+  else
+  {
+    return eIasRingBuffNotAllowed;
+  }
+}
+
+IasAudioRingBufferResult IasAudioRingBuffer::beginReadAccess(uint32_t readerId, IasAudioArea** area, uint32_t* offset, uint32_t* frames)
+{
+  if (area == NULL || offset == NULL || frames == NULL)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  if (mReal)
+  {
+    if (isErasedFromPool())
+    {
+      return eIasRingBuffNotAllowed;
+    }
+    IasAudioRingBufferResult res = mRingBufReal->beginReadAccess(readerId, offset, frames);
+    if (res == eIasRingBuffOk)
+    {
+      checkGeneration();
+    }
+    *area = mAreas;
+    return res;
+  }
+  else
+  {
+    return eIasRingBuffNotAllowed;
+  }
+}
+
+IasAudioRingBufferResult IasAudioRingBuffer::endReadAccess(uint32_t readerId, uint32_t offset, uint32_t frames)
+{
+  if (mReal)
+  {
+    if (isErasedFromPool())
+    {
+      return eIasRingBuffNotAllowed;
+    }
+    return mRingBufReal->endReadAccess(readerId, offset, frames);
+  }
+  else
+  {
+    return eIasRingBuffNotAllowed;
+  }
+}
+
+IasAudioRingBufferResult IasAudioRingBuffer::beginChannelGroupAccess(IasRingBufferAccess access, uint32_t firstChannel, uint32_t numChannels,
+                                                                     IasAudioArea** area, uint32_t* offset, uint32_t* frames)
+{
+  if (area == NULL || offset == NULL || frames == NULL  || access == eIasRingBufferAccessUndef)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  if (mReal)
+  {
+    if (isErasedFromPool())
+    {
+      return eIasRingBuffNotAllowed;
+    }
+    IasAudioRingBufferResult res = mRingBufReal->beginChannelGroupAccess(access, firstChannel, numChannels, offset, frames);
+    if (res == eIasRingBuffOk)
+    {
+      checkGeneration();
+    }
+    *area = mAreas;
+    return res;
+  }
+  else
+  {
+    return eIasRingBuffNotAllowed;
+  }
+}
+
+IasAudioRingBufferResult IasAudioRingBuffer::endChannelGroupAccess(IasRingBufferAccess access, uint32_t firstChannel, uint32_t numChannels, uint32_t frames)
+{
+  if (mReal)
+  {
+    if (isErasedFromPool())
+    {
+      return eIasRingBuffNotAllowed;
+    }
+    return mRingBufReal->endChannelGroupAccess(access, firstChannel, numChannels, frames);
+  }
+  else
+  {
+    return eIasRingBuffNotAllowed;
+  }
+}
+
+IasAudioRingBufferResult IasAudioRingBuffer::setReadLatencyBound(uint32_t maxFillLevel, uint32_t crossfadeFrames)
+{
+  if (mReal)
+  {
+    return mRingBufReal->setReadLatencyBound(maxFillLevel, crossfadeFrames);
+  }
+  else
+  {
+    return eIasRingBuffNotAllowed;
+  }
+}
+
+uint64_t IasAudioRingBuffer::getNumDroppedFrames() const
+{
+  if (mReal)
+  {
+    return mRingBufReal->getNumDroppedFrames();
+  }
+  return 0;
+}
+
+IasAudioRingBufferResult IasAudioRingBuffer::getNumLostFrames(uint32_t readerId, uint64_t *numLostFrames) const
+{
+  if (mReal)
+  {
+    return mRingBufReal->getNumLostFrames(readerId, numLostFrames);
+  }
+  else
+  {
+    return eIasRingBuffNotAllowed;
+  }
+}
+
+IasAudioRingBufferResult IasAudioRingBuffer::getStatistics(IasAudioRingBufferStatistics *statistics) const
+{
+  if (mReal)
+  {
+    return mRingBufReal->getStatistics(statistics);
+  }
+  else
+  {
+    return eIasRingBuffNotAllowed;
+  }
+}
 
 void IasAudioRingBuffer::triggerFdSignal()
 {
@@ -295,6 +612,18 @@ IasAudioRingBufferResult IasAudioRingBuffer::getAreas(IasAudioArea** areas) cons
   return eIasRingBuffOk;
 }
 
+IasAudioRingBufferResult IasAudioRingBuffer::getPeriodMetaData(uint32_t offset, void **metaData) const
+{
+  if (mReal)
+  {
+    return mRingBufReal->getPeriodMetaData(offset, metaData);
+  }
+  else
+  {
+    return eIasRingBuffNotAllowed;
+  }
+}
+
 IasAudioRingBufferResult IasAudioRingBuffer::getDataFormat(IasAudioCommonDataFormat *dataFormat) const
 {
   if (dataFormat == NULL)
@@ -323,6 +652,18 @@ IasAudioRingBufferResult IasAudioRingBuffer::waitRead(uint32_t numPeriods, uint3
   }
 }
 
+IasAudioRingBufferResult IasAudioRingBuffer::waitRead(uint32_t readerId, uint32_t numPeriods, uint32_t timeout_ms)
+{
+  if (mReal)
+  {
+    return mRingBufReal->waitRead(readerId, numPeriods, timeout_ms);
+  }
+  else
+  {
+    return eIasRingBuffNotAllowed;
+  }
+}
+
 IasAudioRingBufferResult IasAudioRingBuffer::waitWrite(uint32_t numPeriods, uint32_t timeout_ms)
 {
   if (mReal)
@@ -349,6 +690,20 @@ IasAudioRingBufferResult IasAudioRingBuffer::getTimestamp(IasRingBufferAccess ac
   return result;
 }
 
+IasAudioRingBufferResult IasAudioRingBuffer::getTimestampHistory(IasRingBufferAccess access,
+                                                                 IasAudioRingBufferTimestampEntry *entries,
+                                                                 uint32_t *numEntries) const
+{
+  if (mReal)
+  {
+    return mRingBufReal->getTimestampHistory(access, entries, numEntries);
+  }
+  else
+  {
+    return eIasRingBuffNotAllowed;
+  }
+}
+
 IasAudioRingBufferResult IasAudioRingBuffer::setStreamingState(IasAudioRingBufferStreamingState streamingState)
 {
   if (mReal)
@@ -422,6 +777,18 @@ int64_t IasAudioRingBuffer::getHwPtrWrite() const
   }
 }
 
+IasAudioRingBufferResult IasAudioRingBuffer::getState(IasAudioRingBufferState *state) const
+{
+  if (mReal)
+  {
+    return mRingBufReal->getState(state);
+  }
+  else
+  {
+    return eIasRingBuffNotAllowed;
+  }
+}
+
 void IasAudioRingBuffer::resetFromWriter()
 {
   if (mReal)
@@ -438,6 +805,14 @@ void IasAudioRingBuffer::resetFromReader()
   }
 }
 
+void IasAudioRingBuffer::resetFromReader(uint32_t readerId)
+{
+  if (mReal)
+  {
+    mRingBufReal->resetFromReader(readerId);
+  }
+}
+
 void IasAudioRingBuffer::setName(const std::string &name)
 {
   mName = name;
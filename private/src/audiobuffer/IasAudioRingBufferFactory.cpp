@@ -10,12 +10,22 @@
  */
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <set>
 
 
 #include "internal/audio/common/audiobuffer/IasAudioRingBuffer.hpp"
 #include "internal/audio/common/audiobuffer/IasAudioRingBufferReal.hpp"
 #include "internal/audio/common/audiobuffer/IasAudioRingBufferMirror.hpp"
 #include "internal/audio/common/audiobuffer/IasAudioRingBufferFactory.hpp"
+#include "internal/audio/common/audiobuffer/IasAudioRingBufferPool.hpp"
+#include "internal/audio/common/audiobuffer/IasAudioRingBufferRegistry.hpp"
 #include "internal/audio/common/audiobuffer/IasAudioRingBufferResult.hpp"
 #include "audio/common/audiobuffer/IasMemoryAllocator.hpp"
 #include "audio/common/audiobuffer/IasMetaDataFactory.hpp"
@@ -28,6 +38,12 @@ static const std::string cClassName = "IasAudioRingBufferFactory::";
 #define LOG_PREFIX cClassName + __func__ + "(" + std::to_string(__LINE__) + "):"
 #define LOG_BUFFER "buffer=" + name + ":"
 
+static const std::string cRegistryGroupName = "ias_audio";
+
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+
 IasAudioRingBufferFactory*  IasAudioRingBufferFactory::getInstance()
 {
   static IasAudioRingBufferFactory theInstance;
@@ -37,6 +53,15 @@ IasAudioRingBufferFactory*  IasAudioRingBufferFactory::getInstance()
 
 IasAudioRingBufferFactory::IasAudioRingBufferFactory()
   :mMemoryMap()
+  ,mDoubleMappedMemoryMap()
+  ,mMemoryReportMap()
+  ,mPooledRingBufferMap()
+  ,mRingBufferPoolMap()
+  ,mRegistry(nullptr)
+  ,mRegisteredRingBufferMap()
+  ,mRegisteredPoolMap()
+  ,mStatisticsPoolMap()
+  ,mStatisticsMap()
   ,mLog(IasAudioLogging::registerDltContext("ARF", "Audio Ringbuffer Factory"))
 {
   //Nothing to do here
@@ -44,11 +69,54 @@ IasAudioRingBufferFactory::IasAudioRingBufferFactory()
 
 IasAudioRingBufferFactory::~IasAudioRingBufferFactory()
 {
-  //Nothing to do here
+  delete mRegistry;
 }
 
 void IasAudioRingBufferFactory::destroyRingBuffer(IasAudioRingBuffer* ringBuf)
 {
+  for (IasStatisticsRingBufferMap::iterator statIt = mStatisticsMap.begin(); statIt != mStatisticsMap.end(); ++statIt)
+  {
+    if ((*statIt).second.ringBuf == ringBuf)
+    {
+      mStatisticsMap.erase(statIt);
+      break;
+    }
+  }
+  IasRegisteredRingBufferMap::iterator regIt = mRegisteredRingBufferMap.find(ringBuf);
+  if (regIt != mRegisteredRingBufferMap.end())
+  {
+    if (mRegistry != nullptr)
+    {
+      mRegistry->remove(ringBuf->getName(), (*regIt).second);
+    }
+    mRegisteredRingBufferMap.erase(regIt);
+  }
+  IasPooledRingBufferMap::iterator poolIt = mPooledRingBufferMap.find(ringBuf);
+  if (poolIt != mPooledRingBufferMap.end())
+  {
+    const IasPooledRingBuffer &pooled = (*poolIt).second;
+    IasAudioRingBufferReal *ringBufReal = nullptr;
+    IasMetaData *metaData = nullptr;
+    void *dataBuf = nullptr;
+    // The memory is only released if no client is attached anymore, otherwise the last client releases it
+    IasAudioCommonResult res = eIasResultOk;
+    if (pooled.owner == true)
+    {
+      res = pooled.pool->erase(pooled.slot, &ringBufReal, &metaData, &dataBuf);
+    }
+    else
+    {
+      res = pooled.pool->detach(pooled.slot, &ringBufReal, &metaData, &dataBuf);
+    }
+    if (res == eIasResultOk)
+    {
+      releasePooledMemory(pooled.pool, ringBufReal, metaData, dataBuf);
+    }
+    mMemoryReportMap.erase(ringBuf);
+    mPooledRingBufferMap.erase(poolIt);
+    delete ringBuf;
+    return;
+  }
   IasMemoryAllocatorMap::iterator it = mMemoryMap.find(ringBuf);
   if(it != mMemoryMap.end())
   {
@@ -63,20 +131,27 @@ void IasAudioRingBufferFactory::destroyRingBuffer(IasAudioRingBuffer* ringBuf)
     {
       mem->deallocate(real);
     }
+    IasDoubleMappedMemoryMap::iterator mapIt = mDoubleMappedMemoryMap.find(ringBuf);
+    if (mapIt != mDoubleMappedMemoryMap.end())
+    {
+      munmap((*mapIt).second.first, (*mapIt).second.second);
+      mDoubleMappedMemoryMap.erase(mapIt);
+    }
+    mMemoryReportMap.erase(ringBuf);
     delete (*it).first;
     delete (*it).second;
     mMemoryMap.erase(it);
   }
 }
 
-IasAudioRingBuffer* IasAudioRingBufferFactory::findRingBuffer(std::string name)
+IasAudioRingBuffer* IasAudioRingBufferFactory::findRingBuffer(std::string name, const IasMemoryOptions &memoryOptions)
 {
   IasAudioCommonResult res = eIasResultOk;
 
   IasMemoryAllocator* mem = new IasMemoryAllocator(name, 0, true);
   IAS_ASSERT(mem != nullptr);
 
-  res = mem->init(IasMemoryAllocator::eIasConnect);
+  res = mem->init(IasMemoryAllocator::eIasConnect, memoryOptions, nullptr);
   if(res != eIasResultOk)
   {
     DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Unable to connect to shared memory:", toString(res));
@@ -112,16 +187,47 @@ IasAudioRingBuffer* IasAudioRingBufferFactory::findRingBuffer(std::string name)
 
     std::pair<IasAudioRingBuffer*,IasMemoryAllocator*> tmpPair(ringBuf,mem);
     mMemoryMap.insert(tmpPair);
+    mMemoryReportMap[ringBuf] = mem->getMemoryReport();
     return ringBuf;
   }
 }
 
 void IasAudioRingBufferFactory::loseRingBuffer(IasAudioRingBuffer* ringBuf)
 {
+  for (IasStatisticsRingBufferMap::iterator statIt = mStatisticsMap.begin(); statIt != mStatisticsMap.end(); ++statIt)
+  {
+    if ((*statIt).second.ringBuf == ringBuf)
+    {
+      mStatisticsMap.erase(statIt);
+      break;
+    }
+  }
+  IasPooledRingBufferMap::iterator poolIt = mPooledRingBufferMap.find(ringBuf);
+  if (poolIt != mPooledRingBufferMap.end())
+  {
+    // The pool stays mapped, only the instance is deleted. A client releases the memory if it was
+    // the last one attached to a buffer that has already been destroyed by its creator.
+    const IasPooledRingBuffer &pooled = (*poolIt).second;
+    if (pooled.owner == false)
+    {
+      IasAudioRingBufferReal *ringBufReal = nullptr;
+      IasMetaData *metaData = nullptr;
+      void *dataBuf = nullptr;
+      if (pooled.pool->detach(pooled.slot, &ringBufReal, &metaData, &dataBuf) == eIasResultOk)
+      {
+        releasePooledMemory(pooled.pool, ringBufReal, metaData, dataBuf);
+      }
+    }
+    mMemoryReportMap.erase(ringBuf);
+    mPooledRingBufferMap.erase(poolIt);
+    delete ringBuf;
+    return;
+  }
   IasMemoryAllocatorMap::iterator it = mMemoryMap.find(ringBuf);
   if(it != mMemoryMap.end())
   {
     std::string name = ringBuf->getName();
+    mMemoryReportMap.erase(ringBuf);
     delete (*it).first;
     delete (*it).second;
     mMemoryMap.erase(it);
@@ -136,7 +242,8 @@ IasAudioCommonResult IasAudioRingBufferFactory::createRingBuffer(IasAudioRingBuf
                                                                  IasAudioCommonDataFormat dataFormat,
                                                                  IasRingbufferType type,
                                                                  std::string name,
-                                                                 std::string groupName)
+                                                                 std::string groupName,
+                                                                 const IasAudioRingBufferOptions &options)
 {
   IasAudioCommonResult res = eIasResultOk;
   int32_t sampleSize=0;
@@ -179,6 +286,16 @@ IasAudioCommonResult IasAudioRingBufferFactory::createRingBuffer(IasAudioRingBuf
   uint32_t memDataBuffer = sampleSize * numChannels * numPeriods * periodSize;
 
   bool allocateDataMem = true;
+  bool doubleMapped = false;
+  // In the interleaved layout all channels share one plane
+  uint32_t numPlanes = (options.dataLayout == eIasLayoutInterleaved) ? 1 : numChannels;
+  size_t planeSize = static_cast<size_t>(sampleSize) * numPeriods * periodSize * (numChannels / numPlanes);
+  if (numPlanes > 1)
+  {
+    // The planes are padded to keep them apart in the cache, the areas describe the resulting stride
+    memDataBuffer = IasAudioRingBufferReal::calculateDataSize(static_cast<uint32_t>(planeSize), numPlanes, options.planePadding);
+  }
+  size_t doubleMappedSize = 0;
 
   if(ringbuffer == nullptr)
   {
@@ -186,6 +303,16 @@ IasAudioCommonResult IasAudioRingBufferFactory::createRingBuffer(IasAudioRingBuf
     return eIasResultInvalidParam;
   }
 
+  if (options.poolName.empty() == false)
+  {
+    if (type != eIasRingBufferShared)
+    {
+      DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Only ringbuffers of type eIasRingBufferShared can be located in a pool");
+      return eIasResultInvalidParam;
+    }
+    return createPooledRingBuffer(ringbuffer, periodSize, numPeriods, numChannels, dataFormat, name, options);
+  }
+
   switch (type)
   {
     case eIasRingBufferShared:
@@ -196,6 +323,19 @@ IasAudioCommonResult IasAudioRingBufferFactory::createRingBuffer(IasAudioRingBuf
       memAllocatorShared = false;
       ringBufSizeMirror = 0;
       break;
+    case eIasRingBufferLocalDoubleMapped:
+      if ((planeSize % static_cast<size_t>(sysconf(_SC_PAGESIZE))) != 0)
+      {
+        DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Size of one plane (", planeSize,
+                    "bytes) has to be a multiple of the page size for a double mapped ringbuffer");
+        return eIasResultInvalidParam;
+      }
+      memAllocatorShared = false;
+      ringBufSizeMirror = 0;
+      memDataBuffer = 0;
+      allocateDataMem = false;
+      doubleMapped = true;
+      break;
     case eIasRingBufferLocalMirror:
       memAllocatorShared = false;
       memDataBuffer = 0;
@@ -209,10 +349,19 @@ IasAudioCommonResult IasAudioRingBufferFactory::createRingBuffer(IasAudioRingBuf
   }
 
   totalMemorySize = memDataBuffer + ringBufSizeReal + ringBufSizeMirror + metaDataSize;
+  if (allocateDataMem == true)
+  {
+    // Room for aligning the data memory
+    totalMemorySize += cIasAudioRingBufferDataAlignment;
+  }
+  if (type == eIasRingBufferShared || type == eIasRingBufferLocalReal)
+  {
+    totalMemorySize += options.reserveSize;
+  }
   IasMemoryAllocator* mem = new IasMemoryAllocator(name, totalMemorySize, memAllocatorShared);
   IAS_ASSERT(mem != nullptr);
 
-  res = mem->init(IasMemoryAllocator::eIasCreate);
+  res = mem->init(IasMemoryAllocator::eIasCreate, options.memoryOptions, nullptr);
   if (res != eIasResultOk)
   {
     DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Error initializing the memory allocator:", toString(res));
@@ -236,7 +385,7 @@ IasAudioCommonResult IasAudioRingBufferFactory::createRingBuffer(IasAudioRingBuf
   if(allocateDataMem == true)
   {
 
-    res = mem->allocate(16,memDataBuffer,&dataBuf);
+    res = mem->allocate(cIasAudioRingBufferDataAlignment,memDataBuffer,&dataBuf);
     if(res != eIasResultOk)
     {
       DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Error allocating the data memory:", toString(res));
@@ -244,6 +393,16 @@ IasAudioCommonResult IasAudioRingBufferFactory::createRingBuffer(IasAudioRingBuf
       return res;
     }
   }
+  else if (doubleMapped == true)
+  {
+    res = createDoubleMappedMemory(numPlanes, planeSize, &dataBuf, &doubleMappedSize);
+    if(res != eIasResultOk)
+    {
+      DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Error creating the double mapped data memory:", toString(res));
+      delete mem;
+      return res;
+    }
+  }
 
 
   IasAudioRingBuffer* ringBuf = new IasAudioRingBuffer();
@@ -257,6 +416,10 @@ IasAudioCommonResult IasAudioRingBufferFactory::createRingBuffer(IasAudioRingBuf
   if(res != eIasResultOk)
   {
     DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Error creating meta data:", toString(res));
+    if (doubleMapped == true)
+    {
+      munmap(dataBuf, doubleMappedSize);
+    }
     delete ringBuf;
     delete mem;
     delete myMetaDataFactory;
@@ -272,34 +435,26 @@ IasAudioCommonResult IasAudioRingBufferFactory::createRingBuffer(IasAudioRingBuf
     if(res != eIasResultOk)
     {
       DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Error allocating real ringbuffer:", toString(res));
+      if (doubleMapped == true)
+      {
+        munmap(dataBuf, doubleMappedSize);
+      }
       delete ringBuf;
       delete mem;
       delete myMetaDataFactory;
       return res;
     }
 
-    if(type == eIasRingBufferLocalReal)
-    {
-      ringBufRes = ringBuf->init(periodSize,
-                                 numPeriods,
-                                 numChannels,
-                                 dataFormat,
-                                 dataBuf,
-                                 memAllocatorShared,
-                                 metaData,
-                                 ringBufReal);
-    }
-    else
-    {
-      ringBufRes = ringBuf->init(periodSize,
-                                 numPeriods,
-                                 numChannels,
-                                 dataFormat,
-                                 dataBuf,
-                                 memAllocatorShared,
-                                 metaData,
-                                 ringBufReal);
-    }
+    ringBufRes = ringBuf->init(periodSize,
+                               numPeriods,
+                               numChannels,
+                               dataFormat,
+                               dataBuf,
+                               memAllocatorShared,
+                               metaData,
+                               ringBufReal,
+                               options,
+                               doubleMapped);
   }
   else
   {
@@ -322,6 +477,10 @@ IasAudioCommonResult IasAudioRingBufferFactory::createRingBuffer(IasAudioRingBuf
   if(ringBufRes != eIasRingBuffOk)
   {
     DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Error initializing ringbuffer:", toString(res));
+    if (doubleMapped == true)
+    {
+      munmap(dataBuf, doubleMappedSize);
+    }
     delete ringBuf;
     delete mem;
     delete myMetaDataFactory;
@@ -334,9 +493,758 @@ IasAudioCommonResult IasAudioRingBufferFactory::createRingBuffer(IasAudioRingBuf
 
   *ringbuffer = ringBuf;
   mMemoryMap.insert(tmpPair);
+  if (type == eIasRingBufferShared)
+  {
+    // Lets the other processes enumerate the ringbuffer for the statistics
+    const uint32_t generation = registerSegment(name, IasAudioRingBufferRegistry::eIasSegmentRingBuffer);
+    if (generation != 0)
+    {
+      mRegisteredRingBufferMap[ringBuf] = generation;
+    }
+  }
+  IasMemoryReport memoryReport = mem->getMemoryReport();
+  if (doubleMapped == true)
+  {
+    mDoubleMappedMemoryMap[ringBuf] = std::make_pair(dataBuf, doubleMappedSize);
+    // The data lives outside of the memory allocator, so the options are applied separately
+    IasMemoryReport dataReport;
+    IasMemoryAllocator::applyMemoryOptions(dataBuf, doubleMappedSize, options.memoryOptions, &dataReport);
+    memoryReport.size       += dataReport.size;
+    memoryReport.prefaulted  = memoryReport.prefaulted && dataReport.prefaulted;
+    memoryReport.locked      = memoryReport.locked && dataReport.locked;
+    memoryReport.hugePages   = std::min(memoryReport.hugePages, dataReport.hugePages);
+    memoryReport.hugePagesRequested = memoryReport.hugePagesRequested && dataReport.hugePagesRequested;
+    memoryReport.lockError   = (memoryReport.lockError != 0) ? memoryReport.lockError : dataReport.lockError;
+  }
+  mMemoryReportMap[ringBuf] = memoryReport;
+  const IasMemoryOptions &memOptions = options.memoryOptions;
+  if (memOptions.prefault == true || memOptions.lock == true || memOptions.hugePages != eIasHugePagesNone)
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_INFO, LOG_PREFIX, LOG_BUFFER, "Memory options applied to", memoryReport.size, "bytes:",
+                "prefaulted =", memoryReport.prefaulted, "locked =", memoryReport.locked,
+                "lockError =", (memoryReport.lockError != 0) ? strerror(memoryReport.lockError) : "none",
+                "hugePages =", toString(memoryReport.hugePages), "(requested", toString(memOptions.hugePages),
+                ", madvise accepted =", memoryReport.hugePagesRequested, ")");
+  }
 
   delete myMetaDataFactory;
   return res;
 }
 
+IasAudioCommonResult IasAudioRingBufferFactory::reconfigureRingBuffer(IasAudioRingBuffer* ringBuf,
+                                                                      uint32_t periodSize,
+                                                                      uint32_t numPeriods,
+                                                                      uint32_t numChannels)
+{
+  if (ringBuf == nullptr || periodSize == 0 || numPeriods == 0 || numChannels == 0)
+  {
+    return eIasResultInvalidParam;
+  }
+  const std::string name = ringBuf->getName();
+  IasMemoryAllocator *mem = nullptr;
+  IasPooledRingBufferMap::iterator poolIt = mPooledRingBufferMap.find(ringBuf);
+  if (poolIt != mPooledRingBufferMap.end())
+  {
+    if ((*poolIt).second.owner == false)
+    {
+      DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Only the creator can reconfigure a ringbuffer");
+      return eIasResultNotAllowed;
+    }
+    mem = (*poolIt).second.pool->getAllocator();
+  }
+  else
+  {
+    IasMemoryAllocatorMap::iterator it = mMemoryMap.find(ringBuf);
+    if (it == mMemoryMap.end())
+    {
+      return eIasResultInvalidParam;
+    }
+    mem = (*it).second;
+  }
+  IasAudioRingBufferReal *ringBufReal = const_cast<IasAudioRingBufferReal*>(ringBuf->getReal());
+  if (ringBufReal == nullptr || ringBufReal->isDoubleMapped() == true || mDoubleMappedMemoryMap.find(ringBuf) != mDoubleMappedMemoryMap.end())
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Mirror and double mapped ringbuffers cannot be reconfigured");
+    return eIasResultNotAllowed;
+  }
+  if (numChannels > ringBufReal->getNumChannelsMax())
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Number of channels", numChannels, "exceeds the maximum of", ringBufReal->getNumChannelsMax());
+    return eIasResultInvalidParam;
+  }
+
+  const uint32_t currentSize = ringBufReal->getDataSize(ringBufReal->getPeriodSize(), ringBufReal->getNumberPeriods(), ringBufReal->getNumChannels());
+  const uint32_t newSize = ringBufReal->getDataSize(periodSize, numPeriods, numChannels);
+  void *oldDataBuf = ringBufReal->getDataBuffer();
+  void *retiredDataBuf = ringBufReal->getRetiredDataBuffer();
+  void *newDataBuf = oldDataBuf;
+  if (newSize > currentSize)
+  {
+    IasAudioCommonResult res = mem->allocate(cIasAudioRingBufferDataAlignment, newSize, &newDataBuf);
+    if (res != eIasResultOk)
+    {
+      DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Not enough free memory for", newSize, "bytes, reserve more space on creation");
+      return eIasResultMemoryError;
+    }
+  }
+  IasAudioRingBufferResult rbres = ringBuf->reconfigure(periodSize, numPeriods, numChannels, newDataBuf);
+  if (rbres != eIasRingBuffOk)
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_WARN, LOG_PREFIX, LOG_BUFFER, "Reconfiguration failed:", toString(rbres));
+    if (newDataBuf != oldDataBuf)
+    {
+      mem->deallocate(newDataBuf);
+    }
+    return eIasResultNotAllowed;
+  }
+  if (newDataBuf != oldDataBuf)
+  {
+    // The accesses use the new geometry from now on, but a reader that peeked before might still read
+    // the old memory until it peeks again. So the old memory is retired and only the memory retired by
+    // the previous reconfigure is released.
+    if (retiredDataBuf != nullptr)
+    {
+      mem->deallocate(retiredDataBuf);
+    }
+    if (poolIt != mPooledRingBufferMap.end())
+    {
+      (*poolIt).second.pool->setDataBuffer((*poolIt).second.slot, newDataBuf);
+    }
+  }
+  DLT_LOG_CXX(*mLog, DLT_LOG_INFO, LOG_PREFIX, LOG_BUFFER, "Reconfigured to periodSize =", periodSize, "numPeriods =", numPeriods,
+              "numChannels =", numChannels, "generation =", ringBuf->getGeneration());
+  return eIasResultOk;
+}
+
+IasAudioCommonResult IasAudioRingBufferFactory::getMemoryReport(IasAudioRingBuffer* ringBuf, IasMemoryReport *report) const
+{
+  if (report == nullptr)
+  {
+    return eIasResultInvalidParam;
+  }
+  IasMemoryReportMap::const_iterator it = mMemoryReportMap.find(ringBuf);
+  if (it == mMemoryReportMap.end())
+  {
+    return eIasResultInvalidParam;
+  }
+  *report = (*it).second;
+  return eIasResultOk;
+}
+
+void IasAudioRingBufferFactory::getRingBuffers(std::vector<IasAudioRingBuffer*> *ringBuffers)
+{
+  IAS_ASSERT(ringBuffers != nullptr);
+  // The mappings of the ringbuffers of the other processes are part of the maps below
+  updateStatisticsRingBuffers();
+  ringBuffers->clear();
+  for (IasMemoryAllocatorMap::const_iterator it = mMemoryMap.begin(); it != mMemoryMap.end(); ++it)
+  {
+    ringBuffers->push_back((*it).first);
+  }
+  for (IasPooledRingBufferMap::const_iterator it = mPooledRingBufferMap.begin(); it != mPooledRingBufferMap.end(); ++it)
+  {
+    ringBuffers->push_back((*it).first);
+  }
+}
+
+IasAudioCommonResult IasAudioRingBufferFactory::getStatistics(IasAudioRingBuffer* ringBuf, IasAudioRingBufferStatistics *statistics) const
+{
+  if (statistics == nullptr ||
+      (mMemoryMap.find(ringBuf) == mMemoryMap.end() && mPooledRingBufferMap.find(ringBuf) == mPooledRingBufferMap.end()))
+  {
+    return eIasResultInvalidParam;
+  }
+  if (ringBuf->getStatistics(statistics) != eIasRingBuffOk)
+  {
+    return eIasResultInvalidParam;
+  }
+  return eIasResultOk;
+}
+
+IasAudioCommonResult IasAudioRingBufferFactory::getStatistics(const std::string &name, IasAudioRingBufferStatistics *statistics)
+{
+  if (statistics == nullptr)
+  {
+    return eIasResultInvalidParam;
+  }
+  // The mappings for the statistics are skipped here, they might belong to a ringbuffer that has been destroyed
+  for (IasMemoryAllocatorMap::const_iterator it = mMemoryMap.begin(); it != mMemoryMap.end(); ++it)
+  {
+    if ((*it).first->getName() == name && isStatisticsRingBuffer((*it).first) == false)
+    {
+      return getStatistics((*it).first, statistics);
+    }
+  }
+  for (IasPooledRingBufferMap::const_iterator it = mPooledRingBufferMap.begin(); it != mPooledRingBufferMap.end(); ++it)
+  {
+    if ((*it).first->getName() == name && isStatisticsRingBuffer((*it).first) == false)
+    {
+      return getStatistics((*it).first, statistics);
+    }
+  }
+  IasAudioRingBuffer *ringBuf = findStatisticsRingBuffer(name);
+  if (ringBuf == nullptr)
+  {
+    return eIasResultInvalidParam;
+  }
+  return getStatistics(ringBuf, statistics);
+}
+
+IasAudioRingBufferRegistry* IasAudioRingBufferFactory::getRegistry()
+{
+  if (mRegistry == nullptr)
+  {
+    IasAudioRingBufferRegistry *registry = new IasAudioRingBufferRegistry();
+    IAS_ASSERT(registry != nullptr);
+    IasAudioCommonResult res = registry->init(cRegistryGroupName);
+    if (res != eIasResultOk)
+    {
+      DLT_LOG_CXX(*mLog, DLT_LOG_WARN, LOG_PREFIX, "Unable to connect to the ringbuffer registry:", toString(res));
+      delete registry;
+      return nullptr;
+    }
+    mRegistry = registry;
+  }
+  return mRegistry;
+}
+
+uint32_t IasAudioRingBufferFactory::registerSegment(const std::string &name, IasAudioRingBufferRegistry::IasSegmentType type)
+{
+  IasAudioRingBufferRegistry *registry = getRegistry();
+  if (registry == nullptr)
+  {
+    return 0;
+  }
+  uint32_t generation = 0;
+  IasAudioCommonResult res = registry->add(name, type, &generation);
+  if (res != eIasResultOk)
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_WARN, LOG_PREFIX, LOG_BUFFER, "Not visible for the statistics of other processes:", toString(res));
+    return 0;
+  }
+  return generation;
+}
+
+void IasAudioRingBufferFactory::updateStatisticsRingBuffers()
+{
+  IasAudioRingBufferRegistry *registry = getRegistry();
+  if (registry == nullptr)
+  {
+    return;
+  }
+  std::vector<IasAudioRingBufferRegistry::IasSegment> segments;
+  registry->getSegments(&segments);
+  std::set<IasStatisticsKey> existing;
+  for (std::vector<IasAudioRingBufferRegistry::IasSegment>::const_iterator it = segments.begin(); it != segments.end(); ++it)
+  {
+    std::vector<IasStatisticsKey> keys;
+    if ((*it).type == IasAudioRingBufferRegistry::eIasSegmentRingBuffer)
+    {
+      keys.push_back(IasStatisticsKey("", (*it).name));
+    }
+    else
+    {
+      IasAudioRingBufferPool *pool = getStatisticsPool((*it).name, (*it).generation);
+      if (pool == nullptr)
+      {
+        continue;
+      }
+      std::vector<std::string> names;
+      pool->getNames(&names);
+      for (std::vector<std::string>::const_iterator nameIt = names.begin(); nameIt != names.end(); ++nameIt)
+      {
+        keys.push_back(IasStatisticsKey((*it).name, *nameIt));
+      }
+    }
+    for (std::vector<IasStatisticsKey>::const_iterator keyIt = keys.begin(); keyIt != keys.end(); ++keyIt)
+    {
+      if (isLocalRingBuffer(*keyIt) == true)
+      {
+        // Listed via the instance of this process
+        continue;
+      }
+      if (getStatisticsRingBuffer(*keyIt, ((*keyIt).first.empty() == true) ? (*it).generation : 0) != nullptr)
+      {
+        existing.insert(*keyIt);
+      }
+    }
+  }
+  std::vector<IasStatisticsKey> destroyed;
+  for (IasStatisticsRingBufferMap::const_iterator it = mStatisticsMap.begin(); it != mStatisticsMap.end(); ++it)
+  {
+    if (existing.find((*it).first) == existing.end())
+    {
+      destroyed.push_back((*it).first);
+    }
+  }
+  for (std::vector<IasStatisticsKey>::const_iterator it = destroyed.begin(); it != destroyed.end(); ++it)
+  {
+    loseStatisticsRingBuffer(*it);
+  }
+}
+
+bool IasAudioRingBufferFactory::isLocalRingBuffer(const IasStatisticsKey &key) const
+{
+  if (key.first.empty() == true)
+  {
+    for (IasMemoryAllocatorMap::const_iterator it = mMemoryMap.begin(); it != mMemoryMap.end(); ++it)
+    {
+      if ((*it).first->getName() == key.second && isStatisticsRingBuffer((*it).first) == false)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+  IasRingBufferPoolMap::const_iterator poolIt = mRingBufferPoolMap.find(key.first);
+  if (poolIt == mRingBufferPoolMap.end())
+  {
+    return false;
+  }
+  for (IasPooledRingBufferMap::const_iterator it = mPooledRingBufferMap.begin(); it != mPooledRingBufferMap.end(); ++it)
+  {
+    if ((*it).second.pool == (*poolIt).second && (*it).first->getName() == key.second &&
+        isStatisticsRingBuffer((*it).first) == false)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool IasAudioRingBufferFactory::isStatisticsRingBuffer(IasAudioRingBuffer *ringBuf) const
+{
+  for (IasStatisticsRingBufferMap::const_iterator it = mStatisticsMap.begin(); it != mStatisticsMap.end(); ++it)
+  {
+    if ((*it).second.ringBuf == ringBuf)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+IasAudioRingBuffer* IasAudioRingBufferFactory::getStatisticsRingBuffer(const IasStatisticsKey &key, uint32_t generation)
+{
+  IasStatisticsRingBufferMap::const_iterator it = mStatisticsMap.find(key);
+  if (it != mStatisticsMap.end())
+  {
+    // An own shared memory that has been created again gets a new registry generation, a pooled
+    // ringbuffer that has been destroyed gets a new generation of its directory slot.
+    const bool stale = (key.first.empty() == true) ? ((*it).second.generation != generation) : isStale((*it).second.ringBuf);
+    if (stale == false)
+    {
+      return (*it).second.ringBuf;
+    }
+    loseStatisticsRingBuffer(key);
+  }
+  IasAudioRingBuffer *ringBuf = (key.first.empty() == true) ? findRingBuffer(key.second) : findRingBuffer(key.first, key.second);
+  if (ringBuf == nullptr)
+  {
+    return nullptr;
+  }
+  IasStatisticsRingBuffer &entry = mStatisticsMap[key];
+  entry.ringBuf = ringBuf;
+  entry.generation = generation;
+  return ringBuf;
+}
+
+IasAudioRingBuffer* IasAudioRingBufferFactory::findStatisticsRingBuffer(const std::string &name)
+{
+  IasAudioRingBufferRegistry *registry = getRegistry();
+  if (registry == nullptr)
+  {
+    return nullptr;
+  }
+  std::vector<IasAudioRingBufferRegistry::IasSegment> segments;
+  registry->getSegments(&segments);
+  for (std::vector<IasAudioRingBufferRegistry::IasSegment>::const_iterator it = segments.begin(); it != segments.end(); ++it)
+  {
+    if ((*it).type == IasAudioRingBufferRegistry::eIasSegmentRingBuffer && (*it).name == name)
+    {
+      return getStatisticsRingBuffer(IasStatisticsKey("", name), (*it).generation);
+    }
+  }
+  for (std::vector<IasAudioRingBufferRegistry::IasSegment>::const_iterator it = segments.begin(); it != segments.end(); ++it)
+  {
+    if ((*it).type != IasAudioRingBufferRegistry::eIasSegmentPool)
+    {
+      continue;
+    }
+    IasAudioRingBufferPool *pool = getStatisticsPool((*it).name, (*it).generation);
+    uint32_t slot = 0;
+    if (pool != nullptr && pool->lookup(name, &slot, nullptr, nullptr) == eIasResultOk)
+    {
+      return getStatisticsRingBuffer(IasStatisticsKey((*it).name, name), 0);
+    }
+  }
+  return nullptr;
+}
+
+IasAudioRingBufferPool* IasAudioRingBufferFactory::getStatisticsPool(const std::string &poolName, uint32_t generation)
+{
+  if (mRegisteredPoolMap.find(poolName) != mRegisteredPoolMap.end())
+  {
+    // Created by this process
+    return getRingBufferPool(poolName);
+  }
+  IasRegisteredPoolMap::iterator it = mStatisticsPoolMap.find(poolName);
+  if (it != mStatisticsPoolMap.end() && (*it).second != generation &&
+      mRingBufferPoolMap.find(poolName) != mRingBufferPoolMap.end())
+  {
+    // The pool has been created again, the old one stays mapped as long as this process still uses it
+    loseStatisticsRingBuffers(poolName);
+    if (destroyRingBufferPool(poolName) != eIasResultOk)
+    {
+      return nullptr;
+    }
+  }
+  IasAudioRingBufferPool *pool = getRingBufferPool(poolName);
+  if (pool != nullptr)
+  {
+    mStatisticsPoolMap[poolName] = generation;
+  }
+  return pool;
+}
+
+void IasAudioRingBufferFactory::loseStatisticsRingBuffer(const IasStatisticsKey &key)
+{
+  IasStatisticsRingBufferMap::iterator it = mStatisticsMap.find(key);
+  if (it != mStatisticsMap.end())
+  {
+    IasAudioRingBuffer *ringBuf = (*it).second.ringBuf;
+    mStatisticsMap.erase(it);
+    loseRingBuffer(ringBuf);
+  }
+}
+
+void IasAudioRingBufferFactory::loseStatisticsRingBuffers(const std::string &poolName)
+{
+  std::vector<IasStatisticsKey> keys;
+  for (IasStatisticsRingBufferMap::const_iterator it = mStatisticsMap.begin(); it != mStatisticsMap.end(); ++it)
+  {
+    if ((*it).first.first == poolName)
+    {
+      keys.push_back((*it).first);
+    }
+  }
+  for (std::vector<IasStatisticsKey>::const_iterator it = keys.begin(); it != keys.end(); ++it)
+  {
+    loseStatisticsRingBuffer(*it);
+  }
+}
+
+IasAudioCommonResult IasAudioRingBufferFactory::createDoubleMappedMemory(uint32_t numPlanes, size_t planeSize, void **dataBuf, size_t *mappingSize)
+{
+  IAS_ASSERT(dataBuf != nullptr);
+  IAS_ASSERT(mappingSize != nullptr);
+  int fd = static_cast<int>(syscall(SYS_memfd_create, "ias_audio_ringbuffer", MFD_CLOEXEC));
+  if (fd < 0)
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, "memfd_create failed:", strerror(errno));
+    return eIasResultMemoryError;
+  }
+  if (ftruncate(fd, static_cast<off_t>(planeSize * numPlanes)) != 0)
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, "ftruncate failed:", strerror(errno));
+    close(fd);
+    return eIasResultMemoryError;
+  }
+
+  // Reserve the address range for all planes first, then map every plane twice into it.
+  size_t totalSize = 2 * planeSize * numPlanes;
+  void *base = mmap(nullptr, totalSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (base == MAP_FAILED)
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, "Reserving the address range failed:", strerror(errno));
+    close(fd);
+    return eIasResultMemoryError;
+  }
+  for (uint32_t plane = 0; plane < numPlanes; plane++)
+  {
+    for (uint32_t copy = 0; copy < 2; copy++)
+    {
+      char *address = static_cast<char*>(base) + (2 * plane + copy) * planeSize;
+      void *mapping = mmap(address, planeSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+                           fd, static_cast<off_t>(plane * planeSize));
+      if (mapping == MAP_FAILED)
+      {
+        DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, "Mapping plane", plane, "failed:", strerror(errno));
+        munmap(base, totalSize);
+        close(fd);
+        return eIasResultMemoryError;
+      }
+    }
+  }
+  // The mappings keep the memory alive, the file descriptor is not needed anymore
+  close(fd);
+
+  *dataBuf = base;
+  *mappingSize = totalSize;
+  return eIasResultOk;
+}
+
+IasAudioCommonResult IasAudioRingBufferFactory::createRingBufferPool(const std::string &poolName,
+                                                                     uint32_t numSlots,
+                                                                     uint32_t arenaSize,
+                                                                     const std::string &groupName,
+                                                                     const IasMemoryOptions &memoryOptions)
+{
+  const std::string &name = poolName;
+  if (poolName.empty() == true || numSlots == 0 || arenaSize == 0)
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Invalid parameter: numSlots =", numSlots, "arenaSize =", arenaSize);
+    return eIasResultInvalidParam;
+  }
+  if (mRingBufferPoolMap.find(poolName) != mRingBufferPoolMap.end())
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Pool already exists");
+    return eIasResultObjectAlreadyExists;
+  }
+  IasAudioRingBufferPool *pool = new IasAudioRingBufferPool(poolName);
+  IAS_ASSERT(pool != nullptr);
+  IasAudioCommonResult res = pool->init(IasMemoryAllocator::eIasCreate, numSlots, arenaSize, groupName, memoryOptions);
+  if (res != eIasResultOk)
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Error creating the pool:", toString(res));
+    delete pool;
+    return res;
+  }
+  mRingBufferPoolMap[poolName] = pool;
+  const uint32_t generation = registerSegment(poolName, IasAudioRingBufferRegistry::eIasSegmentPool);
+  if (generation != 0)
+  {
+    mRegisteredPoolMap[poolName] = generation;
+  }
+  DLT_LOG_CXX(*mLog, DLT_LOG_INFO, LOG_PREFIX, LOG_BUFFER, "Pool created with", numSlots, "slots and", arenaSize, "bytes");
+  return eIasResultOk;
+}
+
+IasAudioCommonResult IasAudioRingBufferFactory::destroyRingBufferPool(const std::string &poolName)
+{
+  IasRingBufferPoolMap::iterator it = mRingBufferPoolMap.find(poolName);
+  if (it == mRingBufferPoolMap.end())
+  {
+    return eIasResultObjectNotFound;
+  }
+  // The mappings for the statistics are owned by the factory
+  loseStatisticsRingBuffers(poolName);
+  for (IasPooledRingBufferMap::const_iterator poolIt = mPooledRingBufferMap.begin(); poolIt != mPooledRingBufferMap.end(); ++poolIt)
+  {
+    if ((*poolIt).second.pool == (*it).second)
+    {
+      const std::string &name = poolName;
+      DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Pool still has ringbuffers in use, e.g.", (*poolIt).first->getName());
+      return eIasResultNotAllowed;
+    }
+  }
+  IasRegisteredPoolMap::iterator regIt = mRegisteredPoolMap.find(poolName);
+  if (regIt != mRegisteredPoolMap.end())
+  {
+    if (mRegistry != nullptr)
+    {
+      mRegistry->remove(poolName, (*regIt).second);
+    }
+    mRegisteredPoolMap.erase(regIt);
+  }
+  mStatisticsPoolMap.erase(poolName);
+  delete (*it).second;
+  mRingBufferPoolMap.erase(it);
+  return eIasResultOk;
+}
+
+IasAudioRingBufferPool* IasAudioRingBufferFactory::getRingBufferPool(const std::string &poolName)
+{
+  IasRingBufferPoolMap::iterator it = mRingBufferPoolMap.find(poolName);
+  if (it != mRingBufferPoolMap.end())
+  {
+    return (*it).second;
+  }
+  IasAudioRingBufferPool *pool = new IasAudioRingBufferPool(poolName);
+  IAS_ASSERT(pool != nullptr);
+  IasAudioCommonResult res = pool->init(IasMemoryAllocator::eIasConnect, 0, 0, "", IasMemoryOptions());
+  if (res != eIasResultOk)
+  {
+    const std::string &name = poolName;
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Unable to connect to pool:", toString(res));
+    delete pool;
+    return nullptr;
+  }
+  mRingBufferPoolMap[poolName] = pool;
+  return pool;
+}
+
+IasAudioCommonResult IasAudioRingBufferFactory::createPooledRingBuffer(IasAudioRingBuffer **ringbuffer,
+                                                                       uint32_t periodSize,
+                                                                       uint32_t numPeriods,
+                                                                       uint32_t numChannels,
+                                                                       IasAudioCommonDataFormat dataFormat,
+                                                                       const std::string &name,
+                                                                       const IasAudioRingBufferOptions &options)
+{
+  IasAudioRingBufferPool *pool = getRingBufferPool(options.poolName);
+  if (pool == nullptr)
+  {
+    return eIasResultObjectNotFound;
+  }
+  uint32_t slot = 0;
+  if (name.size() >= cIasAudioRingBufferPoolMaxNameLength)
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Name too long for pool", options.poolName);
+    return eIasResultInvalidParam;
+  }
+  if (pool->lookup(name, &slot, nullptr, nullptr) == eIasResultOk)
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Ringbuffer already exists in pool", options.poolName);
+    return eIasResultObjectAlreadyExists;
+  }
+
+  IasMemoryAllocator *mem = pool->getAllocator();
+  uint32_t memDataBuffer = toSize(dataFormat) * numChannels * numPeriods * periodSize;
+  if (options.dataLayout != eIasLayoutInterleaved)
+  {
+    memDataBuffer = IasAudioRingBufferReal::calculateDataSize(toSize(dataFormat) * numPeriods * periodSize, numChannels, options.planePadding);
+  }
+  void *dataBuf = nullptr;
+  IasMetaData *metaData = nullptr;
+  IasAudioRingBufferReal *ringBufReal = nullptr;
+  IasAudioCommonResult res = mem->allocate(cIasAudioRingBufferDataAlignment, memDataBuffer, &dataBuf);
+  if (res == eIasResultOk)
+  {
+    // The named objects throw if the arena is exhausted
+    try
+    {
+      const std::string objectName = name + "_" + std::to_string(pool->getNextObjectId());
+      IasMetaDataFactory metaDataFactory(mem);
+      res = metaDataFactory.create(objectName + "_metaData", numPeriods, &metaData);
+      if (res == eIasResultOk)
+      {
+        res = mem->allocate<IasAudioRingBufferReal>(objectName + "_ringBufferReal", 1, &ringBufReal);
+      }
+    }
+    catch (std::exception &e)
+    {
+      DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Exception while allocating in pool:", e.what());
+      res = eIasResultMemoryError;
+    }
+  }
+  if (res != eIasResultOk || ringBufReal == nullptr)
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Not enough memory in pool", options.poolName);
+    releasePooledMemory(pool, ringBufReal, metaData, dataBuf);
+    return eIasResultMemoryError;
+  }
+
+  IasAudioRingBuffer* ringBuf = new IasAudioRingBuffer();
+  IAS_ASSERT(ringBuf != nullptr);
+  IasAudioRingBufferResult ringBufRes = ringBuf->init(periodSize,
+                                                      numPeriods,
+                                                      numChannels,
+                                                      dataFormat,
+                                                      dataBuf,
+                                                      true,
+                                                      metaData,
+                                                      ringBufReal,
+                                                      options,
+                                                      false);
+  IasPooledRingBuffer pooled;
+  pooled.pool = pool;
+  pooled.owner = true;
+  if (ringBufRes == eIasRingBuffOk)
+  {
+    res = pool->insert(name, ringBufReal, metaData, dataBuf, &pooled.slot, &pooled.generation);
+  }
+  else
+  {
+    res = eIasResultInitFailed;
+  }
+  if (res != eIasResultOk)
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "Error adding ringbuffer to pool", options.poolName, ":", toString(res));
+    delete ringBuf;
+    releasePooledMemory(pool, ringBufReal, metaData, dataBuf);
+    return res;
+  }
+  ringBuf->setName(name);
+  ringBuf->setPoolGeneration(pool->getGenerationCounter(pooled.slot), pooled.generation);
+  mPooledRingBufferMap[ringBuf] = pooled;
+  mMemoryReportMap[ringBuf] = mem->getMemoryReport();
+  *ringbuffer = ringBuf;
+  return eIasResultOk;
+}
+
+void IasAudioRingBufferFactory::releasePooledMemory(IasAudioRingBufferPool *pool, IasAudioRingBufferReal *ringBufReal, IasMetaData *metaData, void *dataBuf)
+{
+  IasMemoryAllocator *mem = pool->getAllocator();
+  if (ringBufReal != nullptr)
+  {
+    if (ringBufReal->getRetiredDataBuffer() != nullptr)
+    {
+      mem->deallocate(ringBufReal->getRetiredDataBuffer());
+    }
+    mem->deallocate(static_cast<const IasAudioRingBufferReal*>(ringBufReal));
+  }
+  if (metaData != nullptr)
+  {
+    IasMetaDataFactory metaDataFactory(mem);
+    metaDataFactory.destroy(metaData);
+  }
+  if (dataBuf != nullptr)
+  {
+    mem->deallocate(dataBuf);
+  }
+}
+
+IasAudioRingBuffer* IasAudioRingBufferFactory::findRingBuffer(const std::string &poolName, const std::string &name)
+{
+  IasAudioRingBufferPool *pool = getRingBufferPool(poolName);
+  if (pool == nullptr)
+  {
+    return nullptr;
+  }
+  IasPooledRingBuffer pooled;
+  pooled.pool = pool;
+  IasAudioRingBufferReal *ringBufReal = nullptr;
+  if (pool->lookup(name, &pooled.slot, &ringBufReal, &pooled.generation) != eIasResultOk)
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "ringBufReal not found in pool", poolName);
+    return nullptr;
+  }
+  // Keeps the memory of the ringbuffer alive until this instance is lost, even if the creator destroys it
+  if (pool->attach(pooled.slot, pooled.generation) != eIasResultOk)
+  {
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "ringBufReal has been destroyed during the lookup in pool", poolName);
+    return nullptr;
+  }
+  IasAudioRingBuffer* ringBuf = new IasAudioRingBuffer();
+  IAS_ASSERT(ringBuf != nullptr);
+  if (ringBuf->setup(ringBufReal) != eIasRingBuffOk)
+  {
+    delete ringBuf;
+    IasMetaData *metaData = nullptr;
+    void *dataBuf = nullptr;
+    if (pool->detach(pooled.slot, &ringBufReal, &metaData, &dataBuf) == eIasResultOk)
+    {
+      releasePooledMemory(pool, ringBufReal, metaData, dataBuf);
+    }
+    DLT_LOG_CXX(*mLog, DLT_LOG_ERROR, LOG_PREFIX, LOG_BUFFER, "setup of ringbuffer failed");
+    return nullptr;
+  }
+  ringBuf->setName(name);
+  ringBuf->setPoolGeneration(pool->getGenerationCounter(pooled.slot), pooled.generation);
+  mPooledRingBufferMap[ringBuf] = pooled;
+  mMemoryReportMap[ringBuf] = pool->getAllocator()->getMemoryReport();
+  return ringBuf;
+}
+
+bool IasAudioRingBufferFactory::isStale(IasAudioRingBuffer* ringBuf) const
+{
+  IasPooledRingBufferMap::const_iterator it = mPooledRingBufferMap.find(ringBuf);
+  if (it == mPooledRingBufferMap.end())
+  {
+    return false;
+  }
+  return (*it).second.pool->getGeneration((*it).second.slot) != (*it).second.generation;
+}
+
 }
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2018 Intel Corporation.All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file   IasAudioRingBufferGroup.cpp
+ * @date   2018
+ * @brief  Batched commit of the accesses to a set of real ring buffers.
+ */
+
+#include <algorithm>
+
+#include "internal/audio/common/audiobuffer/IasAudioRingBufferGroup.hpp"
+#include "internal/audio/common/audiobuffer/IasAudioRingBuffer.hpp"
+#include "internal/audio/common/audiobuffer/IasAudioRingBufferReal.hpp"
+#include "internal/audio/common/IasFdSignal.hpp"
+
+namespace IasAudio {
+
+IasAudioRingBufferGroup::IasAudioRingBufferGroup()
+  :mMembers()
+  ,mMemberIndex()
+  ,mPending()
+  ,mFdSignals()
+  ,mTimestamp(0)
+{
+}
+
+IasAudioRingBufferGroup::~IasAudioRingBufferGroup()
+{
+  flush();
+}
+
+IasAudioRingBufferResult IasAudioRingBufferGroup::add(IasAudioRingBuffer *ringBuffer)
+{
+  if (ringBuffer == nullptr || mMemberIndex.find(ringBuffer) != mMemberIndex.end())
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  if (ringBuffer->mReal == false || ringBuffer->mRingBufReal == nullptr)
+  {
+    return eIasRingBuffNotAllowed;
+  }
+  if (ringBuffer->isErasedFromPool())
+  {
+    return eIasRingBuffNotAllowed;
+  }
+  IasAudioRingBufferGroupMember member = { ringBuffer->mRingBufReal, ringBuffer->mPoolGeneration,
+                                           ringBuffer->mExpectedPoolGeneration, false, false };
+  mMemberIndex[ringBuffer] = static_cast<uint32_t>(mMembers.size());
+  mMembers.push_back(member);
+  // Reserve everything the hot path needs, so that endAccess and flush never allocate
+  mPending.reserve(mMembers.size());
+  mFdSignals.reserve(mMembers.size());
+  return eIasRingBuffOk;
+}
+
+IasAudioRingBufferResult IasAudioRingBufferGroup::remove(IasAudioRingBuffer *ringBuffer)
+{
+  IasMemberIndexMap::iterator it = mMemberIndex.find(ringBuffer);
+  if (it == mMemberIndex.end())
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  flush();
+  const uint32_t index = (*it).second;
+  mMemberIndex.erase(it);
+  mMembers.erase(mMembers.begin() + index);
+  for (IasMemberIndexMap::iterator indexIt = mMemberIndex.begin(); indexIt != mMemberIndex.end(); ++indexIt)
+  {
+    if ((*indexIt).second > index)
+    {
+      (*indexIt).second--;
+    }
+  }
+  return eIasRingBuffOk;
+}
+
+IasAudioRingBufferResult IasAudioRingBufferGroup::endAccess(IasAudioRingBuffer *ringBuffer, IasRingBufferAccess access, uint32_t offset, uint32_t frames)
+{
+  IasMemberIndexMap::const_iterator it = mMemberIndex.find(ringBuffer);
+  if (it == mMemberIndex.end() || access == eIasRingBufferAccessUndef)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  IasAudioRingBufferGroupMember &member = mMembers[(*it).second];
+  if (isErasedFromPool(member))
+  {
+    return eIasRingBuffNotAllowed;
+  }
+  if (mTimestamp == 0)
+  {
+    mTimestamp = IasAudioRingBufferReal::getCurrentTimestamp();
+  }
+  IasAudioRingBufferResult result = member.ringBufReal->endAccess(access, offset, frames, mTimestamp, false);
+  if ((result == eIasRingBuffOk || result == eIasRingBuffDataOverwritten) && frames > 0)
+  {
+    if (member.readPending == false && member.writePending == false)
+    {
+      mPending.push_back((*it).second);
+    }
+    if (access == eIasRingBufferAccessRead)
+    {
+      member.readPending = true;
+    }
+    else
+    {
+      member.writePending = true;
+    }
+  }
+  return result;
+}
+
+void IasAudioRingBufferGroup::flush()
+{
+  for (std::vector<uint32_t>::const_iterator it = mPending.begin(); it != mPending.end(); ++it)
+  {
+    IasAudioRingBufferGroupMember &member = mMembers[*it];
+    IasFdSignal *fdSignals[2] = { nullptr, nullptr };
+    // The shared memory of an erased buffer may already be reused by another buffer of the pool
+    if (isErasedFromPool(member))
+    {
+      member.readPending = false;
+      member.writePending = false;
+      continue;
+    }
+    if (member.readPending == true)
+    {
+      fdSignals[0] = member.ringBufReal->notifyAccess(eIasRingBufferAccessRead);
+    }
+    if (member.writePending == true)
+    {
+      fdSignals[1] = member.ringBufReal->notifyAccess(eIasRingBufferAccessWrite);
+    }
+    member.readPending = false;
+    member.writePending = false;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+      if (fdSignals[i] != nullptr && std::find(mFdSignals.begin(), mFdSignals.end(), fdSignals[i]) == mFdSignals.end())
+      {
+        mFdSignals.push_back(fdSignals[i]);
+      }
+    }
+  }
+  for (std::vector<IasFdSignal*>::const_iterator it = mFdSignals.begin(); it != mFdSignals.end(); ++it)
+  {
+    (*it)->write();
+  }
+  mPending.clear();
+  mFdSignals.clear();
+  mTimestamp = 0;
+}
+
+} // namespace IasAudio
@@ -0,0 +1,382 @@
+/*
+ * Copyright (C) 2018 Intel Corporation.All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file   IasAudioRingBufferPool.cpp
+ * @date   2018
+ * @brief  Shared memory arena that holds many real ring buffers and a directory to find them by name.
+ */
+
+#include <cstring>
+#include <exception>
+
+#include "internal/audio/common/audiobuffer/IasAudioRingBufferPool.hpp"
+
+namespace IasAudio {
+
+static const std::string cDirectoryName = "poolDirectory";
+static const std::string cSlotsName = "poolSlots";
+
+IasAudioRingBufferPool::IasAudioRingBufferPoolSlot::IasAudioRingBufferPoolSlot()
+  :state(eIasSlotEmpty)
+  ,generation(0)
+  ,numClients(0)
+  ,nameHash(0)
+  ,ringBufReal(nullptr)
+  ,metaData(nullptr)
+  ,dataBuf(nullptr)
+{
+  name[0] = '\0';
+}
+
+IasAudioRingBufferPool::IasAudioRingBufferPoolHeader::IasAudioRingBufferPoolHeader()
+  :numSlots(0)
+  ,objectId(0)
+  ,mutex()
+{
+}
+
+IasAudioRingBufferPool::IasAudioRingBufferPool(const std::string &name)
+  :mName(name)
+  ,mMemory(nullptr)
+  ,mHeader(nullptr)
+  ,mSlots(nullptr)
+{
+}
+
+IasAudioRingBufferPool::~IasAudioRingBufferPool()
+{
+  delete mMemory;
+}
+
+IasAudioCommonResult IasAudioRingBufferPool::init(IasMemoryAllocator::IasOpenFlag flag, uint32_t numSlots, uint32_t arenaSize,
+                                                  const std::string &groupName, const IasMemoryOptions &memoryOptions)
+{
+  if (mMemory != nullptr)
+  {
+    return eIasResultAlreadyInitialized;
+  }
+  if (flag == IasMemoryAllocator::eIasCreate && numSlots == 0)
+  {
+    return eIasResultInvalidParam;
+  }
+  // The directory lives in the arena as well, together with the housekeeping of its named objects
+  uint32_t directorySize = static_cast<uint32_t>(sizeof(IasAudioRingBufferPoolHeader) + numSlots * sizeof(IasAudioRingBufferPoolSlot));
+  IasMemoryAllocator *mem = new IasMemoryAllocator(mName, arenaSize + directorySize, true);
+  IAS_ASSERT(mem != nullptr);
+  IasAudioCommonResult res = mem->init(flag, memoryOptions, nullptr);
+  if (res != eIasResultOk)
+  {
+    delete mem;
+    return res;
+  }
+
+  if (flag == IasMemoryAllocator::eIasCreate)
+  {
+    if (groupName.empty() == false)
+    {
+      res = mem->changeGroup(groupName, nullptr);
+      if (res != eIasResultOk)
+      {
+        delete mem;
+        return res;
+      }
+    }
+    try
+    {
+      mem->allocate<IasAudioRingBufferPoolHeader>(cDirectoryName, 1, &mHeader);
+      mem->allocate<IasAudioRingBufferPoolSlot>(cSlotsName, numSlots, &mSlots);
+    }
+    catch (std::exception &)
+    {
+      delete mem;
+      mHeader = nullptr;
+      mSlots = nullptr;
+      return eIasResultMemoryError;
+    }
+    mHeader->numSlots = numSlots;
+  }
+  else
+  {
+    uint32_t numItems = 0;
+    if (mem->find(cDirectoryName, &numItems, &mHeader) != eIasResultOk || numItems != 1 ||
+        mem->find(cSlotsName, &numItems, &mSlots) != eIasResultOk || numItems != mHeader->numSlots)
+    {
+      delete mem;
+      mHeader = nullptr;
+      mSlots = nullptr;
+      return eIasResultObjectNotFound;
+    }
+  }
+  mMemory = mem;
+  return eIasResultOk;
+}
+
+uint32_t IasAudioRingBufferPool::hashName(const std::string &name)
+{
+  uint32_t hash = 2166136261u;
+  for (std::string::const_iterator it = name.begin(); it != name.end(); ++it)
+  {
+    hash ^= static_cast<uint8_t>(*it);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+IasAudioCommonResult IasAudioRingBufferPool::insert(const std::string &name, IasAudioRingBufferReal *ringBufReal, IasMetaData *metaData,
+                                                    void *dataBuf, uint32_t *slot, uint32_t *generation)
+{
+  if (mMemory == nullptr)
+  {
+    return eIasResultNotInitialized;
+  }
+  if (name.empty() == true || name.size() >= cIasAudioRingBufferPoolMaxNameLength || ringBufReal == nullptr ||
+      slot == nullptr || generation == nullptr)
+  {
+    return eIasResultInvalidParam;
+  }
+  IasLockGuard lock(&mHeader->mutex);
+  uint32_t existingSlot = 0;
+  if (lookup(name, &existingSlot, nullptr, nullptr) == eIasResultOk)
+  {
+    return eIasResultAlreadyInitialized;
+  }
+  const uint32_t numSlots = mHeader->numSlots;
+  const uint32_t hash = hashName(name);
+  for (uint32_t probe = 0; probe < numSlots; ++probe)
+  {
+    const uint32_t index = (hash + probe) % numSlots;
+    IasAudioRingBufferPoolSlot &entry = mSlots[index];
+    const uint32_t state = entry.state.load(std::memory_order_relaxed);
+    if (state == eIasSlotUsed || state == eIasSlotRetired)
+    {
+      continue;
+    }
+    // The slot is not visible to readers until the state is set to used
+    entry.nameHash = hash;
+    std::strncpy(entry.name, name.c_str(), cIasAudioRingBufferPoolMaxNameLength - 1);
+    entry.name[cIasAudioRingBufferPoolMaxNameLength - 1] = '\0';
+    entry.ringBufReal = ringBufReal;
+    entry.metaData = metaData;
+    entry.dataBuf = dataBuf;
+    entry.numClients = 0;
+    *generation = entry.generation.fetch_add(1, std::memory_order_relaxed) + 1;
+    entry.state.store(eIasSlotUsed, std::memory_order_release);
+    *slot = index;
+    return eIasResultOk;
+  }
+  return eIasResultMemoryError;
+}
+
+IasAudioCommonResult IasAudioRingBufferPool::lookup(const std::string &name, uint32_t *slot, IasAudioRingBufferReal **ringBufReal, uint32_t *generation) const
+{
+  if (mMemory == nullptr)
+  {
+    return eIasResultNotInitialized;
+  }
+  if (slot == nullptr || name.size() >= cIasAudioRingBufferPoolMaxNameLength)
+  {
+    return eIasResultInvalidParam;
+  }
+  const uint32_t numSlots = mHeader->numSlots;
+  const uint32_t hash = hashName(name);
+  for (uint32_t probe = 0; probe < numSlots; ++probe)
+  {
+    const uint32_t index = (hash + probe) % numSlots;
+    const IasAudioRingBufferPoolSlot &entry = mSlots[index];
+    const uint32_t state = entry.state.load(std::memory_order_acquire);
+    if (state == eIasSlotEmpty)
+    {
+      break;
+    }
+    if (state != eIasSlotUsed || entry.nameHash != hash)
+    {
+      continue;
+    }
+    const uint32_t slotGeneration = entry.generation.load(std::memory_order_acquire);
+    const bool nameMatches = (std::strncmp(entry.name, name.c_str(), cIasAudioRingBufferPoolMaxNameLength) == 0);
+    IasAudioRingBufferReal *real = entry.ringBufReal.get();
+    // A concurrent erase or re-insert changes the generation, so the copied fields are only valid if it is unchanged
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (entry.generation.load(std::memory_order_relaxed) != slotGeneration ||
+        entry.state.load(std::memory_order_relaxed) != eIasSlotUsed)
+    {
+      continue;
+    }
+    if (nameMatches == true)
+    {
+      *slot = index;
+      if (ringBufReal != nullptr)
+      {
+        *ringBufReal = real;
+      }
+      if (generation != nullptr)
+      {
+        *generation = slotGeneration;
+      }
+      return eIasResultOk;
+    }
+  }
+  return eIasResultObjectNotFound;
+}
+
+void IasAudioRingBufferPool::getNames(std::vector<std::string> *names) const
+{
+  IAS_ASSERT(names != nullptr);
+  names->clear();
+  if (mMemory == nullptr)
+  {
+    return;
+  }
+  // The mutex keeps the names from being overwritten by a concurrent insert while they are copied
+  IasLockGuard lock(&mHeader->mutex);
+  for (uint32_t index = 0; index < mHeader->numSlots; ++index)
+  {
+    const IasAudioRingBufferPoolSlot &entry = mSlots[index];
+    if (entry.state.load(std::memory_order_relaxed) == eIasSlotUsed)
+    {
+      names->push_back(std::string(entry.name));
+    }
+  }
+}
+
+IasAudioCommonResult IasAudioRingBufferPool::erase(uint32_t slot, IasAudioRingBufferReal **ringBufReal, IasMetaData **metaData, void **dataBuf)
+{
+  if (mMemory == nullptr)
+  {
+    return eIasResultNotInitialized;
+  }
+  if (slot >= mHeader->numSlots || ringBufReal == nullptr || metaData == nullptr || dataBuf == nullptr)
+  {
+    return eIasResultInvalidParam;
+  }
+  IasLockGuard lock(&mHeader->mutex);
+  IasAudioRingBufferPoolSlot &entry = mSlots[slot];
+  if (entry.state.load(std::memory_order_relaxed) != eIasSlotUsed)
+  {
+    return eIasResultObjectNotFound;
+  }
+  entry.generation.fetch_add(1, std::memory_order_release);
+  if (entry.numClients > 0)
+  {
+    // The clients still access the memory, the last one to detach hands it out
+    entry.state.store(eIasSlotRetired, std::memory_order_release);
+    *ringBufReal = nullptr;
+    *metaData = nullptr;
+    *dataBuf = nullptr;
+    return eIasResultOk;
+  }
+  releaseSlot(entry, ringBufReal, metaData, dataBuf);
+  return eIasResultOk;
+}
+
+IasAudioCommonResult IasAudioRingBufferPool::attach(uint32_t slot, uint32_t generation)
+{
+  if (mMemory == nullptr)
+  {
+    return eIasResultNotInitialized;
+  }
+  if (slot >= mHeader->numSlots)
+  {
+    return eIasResultInvalidParam;
+  }
+  IasLockGuard lock(&mHeader->mutex);
+  IasAudioRingBufferPoolSlot &entry = mSlots[slot];
+  if (entry.state.load(std::memory_order_relaxed) != eIasSlotUsed ||
+      entry.generation.load(std::memory_order_relaxed) != generation)
+  {
+    return eIasResultObjectNotFound;
+  }
+  entry.numClients++;
+  return eIasResultOk;
+}
+
+IasAudioCommonResult IasAudioRingBufferPool::detach(uint32_t slot, IasAudioRingBufferReal **ringBufReal, IasMetaData **metaData, void **dataBuf)
+{
+  if (mMemory == nullptr)
+  {
+    return eIasResultNotInitialized;
+  }
+  if (slot >= mHeader->numSlots || ringBufReal == nullptr || metaData == nullptr || dataBuf == nullptr)
+  {
+    return eIasResultInvalidParam;
+  }
+  *ringBufReal = nullptr;
+  *metaData = nullptr;
+  *dataBuf = nullptr;
+  IasLockGuard lock(&mHeader->mutex);
+  IasAudioRingBufferPoolSlot &entry = mSlots[slot];
+  if (entry.numClients == 0)
+  {
+    return eIasResultObjectNotFound;
+  }
+  entry.numClients--;
+  if (entry.numClients == 0 && entry.state.load(std::memory_order_relaxed) == eIasSlotRetired)
+  {
+    releaseSlot(entry, ringBufReal, metaData, dataBuf);
+  }
+  return eIasResultOk;
+}
+
+void IasAudioRingBufferPool::releaseSlot(IasAudioRingBufferPoolSlot &entry, IasAudioRingBufferReal **ringBufReal, IasMetaData **metaData, void **dataBuf)
+{
+  *ringBufReal = entry.ringBufReal.get();
+  *metaData = entry.metaData.get();
+  *dataBuf = entry.dataBuf.get();
+  // The slot stays part of the probe sequences of other names, so it is marked as erased instead of empty
+  entry.state.store(eIasSlotErased, std::memory_order_release);
+  entry.ringBufReal = nullptr;
+  entry.metaData = nullptr;
+  entry.dataBuf = nullptr;
+}
+
+IasAudioCommonResult IasAudioRingBufferPool::setDataBuffer(uint32_t slot, void *dataBuf)
+{
+  if (mMemory == nullptr)
+  {
+    return eIasResultNotInitialized;
+  }
+  if (slot >= mHeader->numSlots || dataBuf == nullptr)
+  {
+    return eIasResultInvalidParam;
+  }
+  IasLockGuard lock(&mHeader->mutex);
+  IasAudioRingBufferPoolSlot &entry = mSlots[slot];
+  if (entry.state.load(std::memory_order_relaxed) != eIasSlotUsed)
+  {
+    return eIasResultObjectNotFound;
+  }
+  entry.dataBuf = dataBuf;
+  return eIasResultOk;
+}
+
+uint32_t IasAudioRingBufferPool::getGeneration(uint32_t slot) const
+{
+  if (mMemory == nullptr || slot >= mHeader->numSlots)
+  {
+    return 0;
+  }
+  return mSlots[slot].generation.load(std::memory_order_acquire);
+}
+
+const std::atomic<uint32_t>* IasAudioRingBufferPool::getGenerationCounter(uint32_t slot) const
+{
+  if (mMemory == nullptr || slot >= mHeader->numSlots)
+  {
+    return nullptr;
+  }
+  return &mSlots[slot].generation;
+}
+
+uint32_t IasAudioRingBufferPool::getNextObjectId()
+{
+  if (mMemory == nullptr)
+  {
+    return 0;
+  }
+  return mHeader->objectId.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+} // namespace IasAudio
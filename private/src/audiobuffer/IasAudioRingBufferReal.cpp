@@ -12,8 +12,11 @@
 #include "internal/audio/common/audiobuffer/IasAudioRingBufferReal.hpp"
 #include "internal/audio/common/IasAudioLogging.hpp"
 #include "internal/audio/common/IasFdSignal.hpp"
+#include "internal/audio/common/helper/IasCopyAudioAreaBuffers.hpp"
+#include "audio/common/audiobuffer/IasMetaData.hpp"
 
 #include <limits.h>
+#include <algorithm>
 #include <chrono>
 #include <stdio.h>
 #include <stdlib.h>
@@ -21,12 +24,84 @@
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <unistd.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
 
 namespace IasAudio
 {
 
 using namespace boost::interprocess;
 
+static uint64_t getMonotonicNs()
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+/*
+ * The TSC calibration of this process: a pair of (TSC, CLOCK_MONOTONIC) values and the TSC period.
+ */
+struct IasTscCalibration
+{
+  bool      valid;
+  uint64_t  baseTicks;
+  uint64_t  baseNs;
+  double    nsPerTick;
+};
+
+/*
+ * Take a (TSC, CLOCK_MONOTONIC) pair. The TSC is read between two clock readings and the
+ * tightest of a few tries is used, so that the pair is accurate to a few ten nanoseconds.
+ */
+static void sampleTsc(uint64_t *ticks, uint64_t *ns)
+{
+  uint64_t bestSpan = UINT64_MAX;
+  for (uint32_t i = 0; i < 5; i++)
+  {
+    const uint64_t before = getMonotonicNs();
+    const uint64_t tsc = __rdtsc();
+    const uint64_t after = getMonotonicNs();
+    if ((after - before) < bestSpan)
+    {
+      bestSpan = after - before;
+      *ticks = tsc;
+      *ns = before + (after - before) / 2;
+    }
+  }
+}
+
+/*
+ * The calibration is done once per process, it takes about 20ms. It is only valid if the
+ * CPU has an invariant TSC, i.e. the TSC runs at a constant rate in all P-, C- and T-states.
+ */
+static IasTscCalibration calibrateTsc()
+{
+  IasTscCalibration calibration = {false, 0, 0, 0.0};
+  uint32_t eax = 0, ebx = 0, ecx = 0, edx = 0;
+  if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) == 0 || (edx & (1u << 8)) == 0)
+  {
+    return calibration;
+  }
+  uint64_t endTicks = 0;
+  uint64_t endNs = 0;
+  sampleTsc(&calibration.baseTicks, &calibration.baseNs);
+  usleep(20000);
+  sampleTsc(&endTicks, &endNs);
+  if (endTicks <= calibration.baseTicks || endNs <= calibration.baseNs)
+  {
+    return calibration;
+  }
+  calibration.nsPerTick = static_cast<double>(endNs - calibration.baseNs) / static_cast<double>(endTicks - calibration.baseTicks);
+  calibration.valid = true;
+  return calibration;
+}
+#endif
+
 
 IasAudioRingBufferReal::IasAudioRingBufferReal()
   :mPeriodSize(0)
@@ -42,14 +117,13 @@ IasAudioRingBufferReal::IasAudioRingBufferReal()
   ,mInitialized(false)
   ,mReadInProgress(false)
   ,mWriteInProgress(false)
+  ,mReadWrapAround(false)
+  ,mWriteWrapAround(false)
   ,mDataBuf(nullptr)
   ,mMutex()
   ,mMutexReadInProgress()
   ,mMutexWriteInProgress()
-  ,mCondRead()
-  ,mCondWrite()
-  ,mReadWaitLevel(0)
-  ,mWriteWaitLevel(0)
+  ,mFutexWrite()
   ,mAudioTimestampAccessRead()
   ,mAudioTimestampAccessWrite()
   ,mStreamingState(eIasRingBuffStreamingStateRunning)
@@ -59,10 +133,108 @@ IasAudioRingBufferReal::IasAudioRingBufferReal()
   ,mHwPtrRead(0)
   ,mHwPtrWrite(0)
   ,mBoundary(0)
+  ,mDataLayout(eIasLayoutNonInterleaved)
+  ,mDoubleMapped(false)
+  ,mSyncMode(eIasRingBuffSyncModeMutex)
+  ,mWriteCount(0)
+  ,mReaders()
+  ,mMaxReadFillLevel(0)
+  ,mReadCrossfadeFrames(0)
+  ,mNumDroppedFrames(0)
+  ,mOverrunMode(eIasRingBuffOverrunClamp)
+  ,mWriteReserve(0)
+  ,mNumOverwrittenFrames(0)
+  ,mMutexChannelGroups()
+  ,mReadGroups()
+  ,mWriteGroups()
+  ,mClockSource(eIasRingBuffClockMonotonic)
+  ,mTscBaseTicks(0)
+  ,mTscBaseNs(0)
+  ,mTscNsPerTick(0.0)
+  ,mReadHistory()
+  ,mWriteHistory()
+  ,mStatistics()
+  ,mPublishedRead()
+  ,mPublishedWrite()
+  ,mGeneration(0)
+  ,mRetiredDataBuf(nullptr)
+  ,mPlanePaddingOption(0)
+  ,mPlanePadding(0)
+  ,mMetaData(nullptr)
+  ,mMetaDataSize(0)
+  ,mNumMetaData(0)
 {
   //Nothing to do here
 }
 
+IasAudioRingBufferReal::IasAudioRingBufferReader::IasAudioRingBufferReader()
+  :attached(false)
+  ,readInProgress(false)
+  ,wrapAround(false)
+  ,readOffset(0)
+  ,readCount(0)
+  ,readCountBegin(0)
+  ,numLostFrames(0)
+  ,futex()
+{
+}
+
+IasAudioRingBufferReal::IasAudioRingBufferChannelGroups::IasAudioRingBufferChannelGroups()
+  :beganMask(0)
+  ,committedMask(0)
+  ,offset(0)
+  ,frames(0)
+  ,committedFrames(0)
+{
+}
+
+IasAudioRingBufferReal::IasAudioRingBufferTimestampSlot::IasAudioRingBufferTimestampSlot()
+  :sequence(0)
+  ,framePosition(0)
+  ,timestampNs(0)
+{
+}
+
+IasAudioRingBufferReal::IasAudioRingBufferTimestampHistory::IasAudioRingBufferTimestampHistory()
+  :framePosition(0)
+  ,numEntries(0)
+  ,slots()
+{
+}
+
+IasAudioRingBufferReal::IasAudioRingBufferPublishedState::IasAudioRingBufferPublishedState()
+  :sequence(0)
+  ,offset(0)
+  ,hwPtr(0)
+  ,timestamp(0)
+  ,frames(0)
+{
+}
+
+IasAudioRingBufferReal::IasAudioRingBufferAccessCounters::IasAudioRingBufferAccessCounters()
+  :numCommits(0)
+  ,numFrames(0)
+  ,numXruns(0)
+  ,numErrors(0)
+  ,numWaits(0)
+  ,numWaitTimeouts(0)
+  ,waitTimeNs(0)
+  ,maxWaitTimeNs(0)
+{
+}
+
+IasAudioRingBufferReal::IasAudioRingBufferStatisticsBlock::IasAudioRingBufferStatisticsBlock()
+  :read()
+  ,write()
+  ,fillLevelMin(UINT32_MAX)
+  ,fillLevelMax(0)
+{
+  for (uint32_t i = 0; i < cIasAudioRingBufferFillLevelBins; i++)
+  {
+    fillLevelHistogram[i] = 0;
+  }
+}
+
 IasAudioRingBufferReal::~IasAudioRingBufferReal()
 {
   //Nothing to do here
@@ -74,10 +246,10 @@ IasAudioRingBufferResult IasAudioRingBufferReal::init(uint32_t periodSize,
                                                       IasAudioCommonDataFormat dataFormat,
                                                       void* dataBuf,
                                                       bool shared,
-                                                      IasMetaData* metaData)
+                                                      IasMetaData* metaData,
+                                                      const IasAudioRingBufferOptions &options,
+                                                      bool doubleMapped)
 {
-
-  (void)metaData;
   mShared = shared;
   if (periodSize == 0 ||
       nChannels == 0 ||
@@ -87,22 +259,74 @@ IasAudioRingBufferResult IasAudioRingBufferReal::init(uint32_t periodSize,
   {
     return eIasRingBuffInvalidParam;
   }
+  // The address of the entries is only valid in the creating process, so it is stored as offset pointer
+  const IasMetaDataHeader *metaDataHeader = static_cast<const IasMetaDataHeader*>(metaData->getAddr());
+  if (metaDataHeader == nullptr ||
+      metaDataHeader->mMagicNumber != IasMetaDataHeader::cMagicNumber ||
+      metaDataHeader->mSize < sizeof(IasMetaDataHeader))
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  mMetaData = static_cast<uint8_t*>(metaData->getAddr());
+  mMetaDataSize = metaDataHeader->mSize;
+  mNumMetaData = metaData->getMaxIndex() + 1;
   mSampleSize = toSize(dataFormat);
   if (mSampleSize == -1)
   {
     return eIasRingBuffInvalidSampleSize;
   }
+  if (options.dataLayout != eIasLayoutInterleaved && options.dataLayout != eIasLayoutNonInterleaved)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  if (options.overrunMode == eIasRingBuffOverrunOverwrite && options.syncMode != eIasRingBuffSyncModeLockFree)
+  {
+    // Only the monotonic counters of the lock-free mode allow a reader to detect that it was lapped
+    return eIasRingBuffInvalidParam;
+  }
+  mDataLayout = options.dataLayout;
   mPeriodSize = periodSize;
   mNumPeriods = nPeriods;
   mNumChannels = nChannels;
+  mNumChannelsMax = std::max(nChannels, options.maxChannels);
   mDataFormat = dataFormat;
   mDataBuf = dataBuf;
-  // Set it to an initial value similar like the default value used in the alsa-lib.
-  mBoundary = mPeriodSize*mNumPeriods;
-  while (mBoundary * 2 <= static_cast<uint64_t>(LONG_MAX) - mPeriodSize*mNumPeriods)
+  mDoubleMapped = doubleMapped;
+  mSyncMode = options.syncMode;
+  mOverrunMode = options.overrunMode;
+  mPlanePaddingOption = options.planePadding;
+  mPlanePadding = 0;
+  if (mDataLayout == eIasLayoutNonInterleaved && mDoubleMapped == false)
   {
-    mBoundary *= 2;
+    mPlanePadding = calculatePlanePadding(mNumPeriods*mPeriodSize*mSampleSize, mPlanePaddingOption);
+  }
+  mWriteCount = 0;
+  mWriteReserve = 0;
+  mNumDroppedFrames = 0;
+  mNumOverwrittenFrames = 0;
+  for (uint32_t i = 0; i < cIasAudioRingBufferMaxReaders; i++)
+  {
+    mReaders[i].readCount = 0;
+    mReaders[i].numLostFrames = 0;
+    mReaders[i].readInProgress = false;
+    mReaders[i].attached = (i == 0);
+  }
+  mClockSource = eIasRingBuffClockMonotonic;
+#if defined(__x86_64__) || defined(__i386__)
+  if (options.clockSource == eIasRingBuffClockTsc)
+  {
+    static const IasTscCalibration tscCalibration = calibrateTsc();
+    if (tscCalibration.valid == true)
+    {
+      mClockSource = eIasRingBuffClockTsc;
+      mTscBaseTicks = tscCalibration.baseTicks;
+      mTscBaseNs = tscCalibration.baseNs;
+      mTscNsPerTick = tscCalibration.nsPerTick;
+    }
   }
+#endif
+  initBoundary();
+  publishState(eIasRingBufferAccessUndef);
   mInitialized = true;
 
   return eIasRingBuffOk;
@@ -119,18 +343,28 @@ IasAudioRingBufferResult IasAudioRingBufferReal::updateAvailable(IasRingBufferAc
     return eIasRingBuffNotInitialized;
   }
 
+  uint32_t bufferLevel = mBufferLevel;
+  if (mSyncMode == eIasRingBuffSyncModeLockFree)
+  {
+    if (access == eIasRingBufferAccessRead)
+    {
+      return updateAvailableRead(0, samples);
+    }
+    // An overwriting writer never has to wait for the readers
+    bufferLevel = (mOverrunMode == eIasRingBuffOverrunOverwrite) ? 0 : getWriterFillLevel(mWriteCount.load(std::memory_order_relaxed));
+  }
   if(access == eIasRingBufferAccessRead)
   {
-    *samples = mBufferLevel;
+    *samples = bufferLevel;
   }
   else
   {
-    *samples = mNumPeriods*mPeriodSize - mBufferLevel;
+    *samples = mNumPeriods*mPeriodSize - bufferLevel;
   }
   return  eIasRingBuffOk;
 }
 
-IasAudioRingBufferResult IasAudioRingBufferReal::beginAccess(IasRingBufferAccess access, uint32_t* offset, uint32_t* frames)
+IasAudioRingBufferResult IasAudioRingBufferReal::beginAccess(IasRingBufferAccess access, uint32_t* offset, uint32_t* frames, bool wrapAround)
 {
 
   if (offset == NULL || frames == NULL || access == eIasRingBufferAccessUndef)
@@ -141,42 +375,30 @@ IasAudioRingBufferResult IasAudioRingBufferReal::beginAccess(IasRingBufferAccess
   {
     return eIasRingBuffNotInitialized;
   }
-
-  if (access == eIasRingBufferAccessRead)
+  // In a double mapped buffer the frames behind the end of the buffer are always accessible
+  wrapAround = wrapAround || mDoubleMapped;
+  if (mSyncMode == eIasRingBuffSyncModeLockFree)
   {
-    if (mReadInProgress)
+    if (access == eIasRingBufferAccessRead)
     {
-      return eIasRingBuffNotAllowed;
+      return beginReadAccess(0, offset, frames, wrapAround);
     }
-    mReadInProgress.exchange(true);
-    mMutexReadInProgress.lock();
-    *offset = mReadOffset;
+    return beginWriteLockFree(offset, frames, wrapAround);
+  }
 
-    // If reading from the buffer is blocked -> return with 0 frames.
-    if (mStreamingState == eIasRingBuffStreamingStateStopRead)
-    {
-      *frames = 0;
-    }
-    else
-    {
-      if ( (*frames) > mBufferLevel )
-      {
-        *frames = mBufferLevel;
-      }
-      if ( (mReadOffset + *frames) >= (mNumPeriods*mPeriodSize))
-      {
-        *frames = (mNumPeriods*mPeriodSize) - mReadOffset;
-      }
-    }
+  if (access == eIasRingBufferAccessRead)
+  {
+    return beginReadMutex(offset, frames, wrapAround, false);
   }
   else
   {
     if (mWriteInProgress)
     {
-      return eIasRingBuffNotAllowed;
+      return countError(access, eIasRingBuffNotAllowed);
     }
     mWriteInProgress.exchange(true);
     mMutexWriteInProgress.lock();
+    mWriteWrapAround = wrapAround;
     *offset = mWriteOffset;
 
     // If writing into the buffer is blocked -> return with 0 frames.
@@ -189,8 +411,9 @@ IasAudioRingBufferResult IasAudioRingBufferReal::beginAccess(IasRingBufferAccess
       if ( (*frames) > (mNumPeriods*mPeriodSize - mBufferLevel) )
       {
         *frames = (mNumPeriods*mPeriodSize - mBufferLevel);
+        countXrun(access);
       }
-      if ( (mWriteOffset + *frames) >= (mNumPeriods*mPeriodSize) )
+      if ( (wrapAround == false) && ((mWriteOffset + *frames) >= (mNumPeriods*mPeriodSize)) )
       {
         *frames = (mNumPeriods*mPeriodSize) - mWriteOffset;
       }
@@ -199,20 +422,69 @@ IasAudioRingBufferResult IasAudioRingBufferReal::beginAccess(IasRingBufferAccess
   return eIasRingBuffOk;
 }
 
+IasAudioRingBufferResult IasAudioRingBufferReal::beginReadMutex(uint32_t* offset, uint32_t* frames, bool wrapAround, bool peeked)
+{
+  if (mReadInProgress)
+  {
+    return countError(eIasRingBufferAccessRead, eIasRingBuffNotAllowed);
+  }
+  mReadInProgress.exchange(true);
+  mMutexReadInProgress.lock();
+  mReadWrapAround = wrapAround;
+  if (peeked == false)
+  {
+    applyReadLatencyBound(0);
+  }
+  *offset = mReadOffset;
+
+  // If reading from the buffer is blocked -> return with 0 frames.
+  if (mStreamingState == eIasRingBuffStreamingStateStopRead)
+  {
+    *frames = 0;
+  }
+  else
+  {
+    if ( (*frames) > mBufferLevel )
+    {
+      *frames = mBufferLevel;
+      countXrun(eIasRingBufferAccessRead);
+    }
+    if ( (wrapAround == false) && ((mReadOffset + *frames) >= (mNumPeriods*mPeriodSize)) )
+    {
+      *frames = (mNumPeriods*mPeriodSize) - mReadOffset;
+    }
+  }
+  return eIasRingBuffOk;
+}
+
 IasAudioRingBufferResult IasAudioRingBufferReal::endAccess(IasRingBufferAccess access, uint32_t offset, uint32_t frames)
+{
+  return endAccess(access, offset, frames, getCurrentTimestamp(), true);
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::endAccess(IasRingBufferAccess access, uint32_t offset, uint32_t frames,
+                                                           uint64_t timestamp, bool notify)
 {
   (void)offset;
   if (access == eIasRingBufferAccessUndef)
   {
     return eIasRingBuffInvalidParam;
   }
+  if (mSyncMode == eIasRingBuffSyncModeLockFree)
+  {
+    if (access == eIasRingBufferAccessRead)
+    {
+      return endReadAccess(0, offset, frames, timestamp, notify);
+    }
+    return endWriteLockFree(frames, timestamp, notify);
+  }
   if (access == eIasRingBufferAccessRead )
   {
     if (mReadInProgress)
     {
       if ( static_cast<int32_t>(mBufferLevel - frames) < 0)
       {
-        return eIasRingBuffInvalidParam;
+        return countError(access, eIasRingBuffInvalidParam);
       }
       IasLockGuard lock(&mMutex);
       if( (mReadOffset+frames) == (mNumPeriods*mPeriodSize) )
@@ -221,39 +493,35 @@ IasAudioRingBufferResult IasAudioRingBufferReal::endAccess(IasRingBufferAccess a
       }
       else if ( (mReadOffset+frames) > (mNumPeriods*mPeriodSize) )
       {
-        return eIasRingBuffInvalidParam;
+        if (mReadWrapAround == false)
+        {
+          return countError(access, eIasRingBuffInvalidParam);
+        }
+        mReadOffset = mReadOffset + frames - mNumPeriods*mPeriodSize;
       }
       else
       {
         mReadOffset += frames;
       }
       mBufferLevel -= frames;
+      mReaders[0].readCount.fetch_add(frames, std::memory_order_release);
       mHwPtrRead += frames;
       if (static_cast<uint64_t>(mHwPtrRead) >= mBoundary)
       {
         mHwPtrRead -= mBoundary;
       }
 
-      // Get the current time stamp and write it to mAudioTimestampAccessRead
-      auto durationSinceEpoch = std::chrono::high_resolution_clock::now().time_since_epoch();
-      uint64_t timestamp   = std::chrono::duration_cast<std::chrono::microseconds>(durationSinceEpoch).count();
       mAudioTimestampAccessRead.timestamp = timestamp;
       mAudioTimestampAccessRead.numTransmittedFrames += frames;
+      recordTimestamp(mReadHistory, frames);
+      updateCommitStatistics(access, frames, mBufferLevel);
+      publishState(access);
 
       mReadInProgress.exchange(false);
       mMutexReadInProgress.unlock();
-      if (mBufferLevel <= mWriteWaitLevel)
-      {
-        mCondWrite.signal();
-      }
-      if (mFdSignal != nullptr && frames > 0 && mDeviceType == eIasDeviceTypeSource)
+      if (notify == true)
       {
-        // The snd_pcm_wait function on the plugin (client) side shall not return
-        // before at least avail_min frames are available (free).
-        if ((mNumPeriods*mPeriodSize - mBufferLevel) >= mAvailMin)
-        {
-          mFdSignal->write();
-        }
+        signalAccess(access, frames);
       }
     }
   }
@@ -263,7 +531,7 @@ IasAudioRingBufferResult IasAudioRingBufferReal::endAccess(IasRingBufferAccess a
     {
       if ( (mBufferLevel + frames) > (mNumPeriods*mPeriodSize) )
       {
-        return eIasRingBuffInvalidParam;
+        return countError(access, eIasRingBuffInvalidParam);
       }
       IasLockGuard lock(&mMutex);
       if ( (mWriteOffset + frames) == (mNumPeriods*mPeriodSize) )
@@ -272,157 +540,1231 @@ IasAudioRingBufferResult IasAudioRingBufferReal::endAccess(IasRingBufferAccess a
       }
       else if ( (mWriteOffset + frames) > (mNumPeriods*mPeriodSize) )
       {
-        return eIasRingBuffInvalidParam;
+        if (mWriteWrapAround == false)
+        {
+          return countError(access, eIasRingBuffInvalidParam);
+        }
+        mWriteOffset = mWriteOffset + frames - mNumPeriods*mPeriodSize;
       }
       else
       {
         mWriteOffset += frames;
       }
       mBufferLevel += frames;
+      mWriteCount.fetch_add(frames, std::memory_order_release);
       mHwPtrWrite += frames;
       if (static_cast<uint64_t>(mHwPtrWrite) >= mBoundary)
       {
         mHwPtrWrite -= mBoundary;
       }
 
-      // Get the current time stamp and write it to mAudioTimestampAccessWrite
-      auto durationSinceEpoch = std::chrono::high_resolution_clock::now().time_since_epoch();
-      uint64_t timestamp   = std::chrono::duration_cast<std::chrono::microseconds>(durationSinceEpoch).count();
       mAudioTimestampAccessWrite.timestamp = timestamp;
       mAudioTimestampAccessWrite.numTransmittedFrames += frames;
+      recordTimestamp(mWriteHistory, frames);
+      updateCommitStatistics(access, frames, mBufferLevel);
+      publishState(access);
 
       mWriteInProgress.exchange(false);
       mMutexWriteInProgress.unlock();
-      if (mBufferLevel >= mReadWaitLevel)
+      if (notify == true)
       {
-        mCondRead.signal();
-      }
-      if (mFdSignal != nullptr && frames > 0 && mDeviceType == eIasDeviceTypeSink)
-      {
-        // The snd_pcm_wait function on the plugin (client) side shall not return
-        // before at least avail_min frames are available (filled).
-        if (mBufferLevel >= mAvailMin)
-        {
-          mFdSignal->write();
-        }
+        signalAccess(access, frames);
       }
     }
   }
   return eIasRingBuffOk;
 }
 
-void IasAudioRingBufferReal::triggerFdSignal()
+IasAudioRingBufferResult IasAudioRingBufferReal::peek(uint32_t offsetFromRead, uint32_t* offset, uint32_t* frames, uint32_t* generation)
 {
-  if (mFdSignal != nullptr)
+  if (offset == nullptr || frames == nullptr || generation == nullptr)
   {
-    mFdSignal->write();
+    return eIasRingBuffInvalidParam;
+  }
+  if (mInitialized == false)
+  {
+    return eIasRingBuffNotInitialized;
+  }
+  uint32_t bufferSize;
+  uint32_t readOffset;
+  uint32_t bufferLevel;
+  // The read flag is held, so that a concurrent reconfigure cannot change the geometry while it is
+  // evaluated. The frames are dropped for the latency bound and skipped after a lap here, like at the
+  // begin of a read access, so that consume advances exactly over the frames that have been peeked.
+  if (mSyncMode == eIasRingBuffSyncModeLockFree)
+  {
+    IasAudioRingBufferReader &reader = mReaders[0];
+    if (reader.attached.load(std::memory_order_acquire) == false)
+    {
+      return eIasRingBuffNotAllowed;
+    }
+    bool expected = false;
+    if (reader.readInProgress.compare_exchange_strong(expected, true) == false)
+    {
+      return eIasRingBuffNotAllowed;
+    }
+    reader.readCountBegin = reader.readCount.load(std::memory_order_acquire);
+    if (mOverrunMode == eIasRingBuffOverrunOverwrite)
+    {
+      skipOverwrittenFrames(0);
+    }
+    applyReadLatencyBound(0);
+    bufferSize  = mNumPeriods*mPeriodSize;
+    *generation = mGeneration.load(std::memory_order_acquire);
+    readOffset  = static_cast<uint32_t>(reader.readCountBegin % bufferSize);
+    bufferLevel = getReaderFillLevel(reader);
+    reader.readInProgress.store(false, std::memory_order_release);
+  }
+  else
+  {
+    if (mReadInProgress)
+    {
+      return eIasRingBuffNotAllowed;
+    }
+    mReadInProgress.exchange(true);
+    mMutexReadInProgress.lock();
+    applyReadLatencyBound(0);
+    {
+      IasLockGuard lock(&mMutex);
+      bufferSize  = mNumPeriods*mPeriodSize;
+      *generation = mGeneration.load(std::memory_order_acquire);
+      readOffset  = mReadOffset;
+      bufferLevel = mBufferLevel;
+    }
+    mReadInProgress.exchange(false);
+    mMutexReadInProgress.unlock();
+  }
+
+  *offset = (readOffset + offsetFromRead) % bufferSize;
+  if (mStreamingState == eIasRingBuffStreamingStateStopRead || offsetFromRead >= bufferLevel)
+  {
+    *frames = 0;
+    return eIasRingBuffOk;
+  }
+  if ( (*frames) > (bufferLevel - offsetFromRead) )
+  {
+    *frames = bufferLevel - offsetFromRead;
+  }
+  if ( (mDoubleMapped == false) && ((*offset + *frames) > bufferSize) )
+  {
+    *frames = bufferSize - *offset;
   }
+  return eIasRingBuffOk;
 }
 
-IasAudioRingBufferResult IasAudioRingBufferReal::getDataFormat(IasAudioCommonDataFormat *dataFormat) const
+IasAudioRingBufferResult IasAudioRingBufferReal::consume(uint32_t frames)
 {
-  if (dataFormat == nullptr)
+  if (mInitialized == false)
+  {
+    return eIasRingBuffNotInitialized;
+  }
+  // Use a regular read access, so that the hw pointer, the timestamp and the wake-ups are handled as usual.
+  // The access neither drops frames for the latency bound nor skips overwritten frames, so it advances
+  // exactly over the peeked frames. If the writer has overwritten them since the peek, the end of the
+  // access counts them as lost and returns eIasRingBuffDataOverwritten.
+  uint32_t offset = 0;
+  uint32_t accessibleFrames = frames;
+  IasAudioRingBufferResult result = eIasRingBuffOk;
+  if (mSyncMode == eIasRingBuffSyncModeLockFree)
+  {
+    if (mReaders[0].attached.load(std::memory_order_acquire) == false)
+    {
+      return eIasRingBuffNotAllowed;
+    }
+    result = beginReadLockFree(0, &offset, &accessibleFrames, true, true);
+  }
+  else
+  {
+    result = beginReadMutex(&offset, &accessibleFrames, true, true);
+  }
+  if (result != eIasRingBuffOk)
+  {
+    return result;
+  }
+  if (accessibleFrames < frames)
   {
+    endAccess(eIasRingBufferAccessRead, offset, 0);
     return eIasRingBuffInvalidParam;
   }
+  return endAccess(eIasRingBufferAccessRead, offset, frames);
+}
 
-  *dataFormat = mDataFormat;
+IasAudioRingBufferResult IasAudioRingBufferReal::setReadLatencyBound(uint32_t maxFillLevel, uint32_t crossfadeFrames)
+{
+  // The crossfade is written into the shared frames, which must not be seen by other readers
+  // or be overwritten by the writer while the reader fades them.
+  if (crossfadeFrames > 0 && (getNumAttachedReaders() > 1 || mOverrunMode == eIasRingBuffOverrunOverwrite))
+  {
+    return eIasRingBuffNotAllowed;
+  }
+  mMaxReadFillLevel = maxFillLevel;
+  mReadCrossfadeFrames = crossfadeFrames;
   return eIasRingBuffOk;
 }
 
-IasAudioRingBufferResult IasAudioRingBufferReal::waitWrite(uint32_t numPeriods, uint32_t timeout_ms )
+uint32_t IasAudioRingBufferReal::getNumAttachedReaders() const
 {
-  if ( (numPeriods > mNumPeriods) || numPeriods == 0 || timeout_ms == 0)
+  if (mSyncMode != eIasRingBuffSyncModeLockFree)
   {
-    return eIasRingBuffInvalidParam;
+    return 1;
+  }
+  uint32_t numReaders = 0;
+  for (uint32_t i = 0; i < cIasAudioRingBufferMaxReaders; i++)
+  {
+    if (mReaders[i].attached.load(std::memory_order_acquire) == true)
+    {
+      numReaders++;
+    }
   }
+  return numReaders;
+}
 
-  IasAudioRingBufferResult result = eIasRingBuffOk;
-  IasLockGuard lock(&mMutex);
-  mWriteWaitLevel = (mNumPeriods-numPeriods)*mPeriodSize;
-  IasIntProcCondVar::IasResult cndres = IasIntProcCondVar::eIasOk;
-  if (mBufferLevel > mWriteWaitLevel)
+void IasAudioRingBufferReal::applyReadLatencyBound(uint32_t readerId)
+{
+  const uint32_t bufferSize = mNumPeriods*mPeriodSize;
+  if (mSyncMode != eIasRingBuffSyncModeLockFree)
   {
-    cndres = mCondWrite.wait(mMutex, timeout_ms);
-    if (cndres == IasIntProcCondVar::eIasTimeout)
+    uint32_t dropFrames = getLatencyBoundDrop(mReadOffset, mBufferLevel);
+    if (dropFrames > 0)
     {
-      result = eIasRingBuffTimeOut;
+      crossfadeDroppedFrames(mReadOffset, dropFrames, mBufferLevel);
+      IasLockGuard lock(&mMutex);
+      mReadOffset = (mReadOffset + dropFrames) % bufferSize;
+      mBufferLevel -= dropFrames;
+      mReaders[0].readCount.fetch_add(dropFrames, std::memory_order_release);
+      mHwPtrRead += dropFrames;
+      if (static_cast<uint64_t>(mHwPtrRead) >= mBoundary)
+      {
+        mHwPtrRead -= mBoundary;
+      }
+      mNumDroppedFrames.fetch_add(dropFrames, std::memory_order_relaxed);
+      publishState(eIasRingBufferAccessRead);
     }
-    else if (cndres != IasIntProcCondVar::eIasOk)
+    return;
+  }
+  IasAudioRingBufferReader &reader = mReaders[readerId];
+  const uint32_t bufferLevel = getReaderFillLevel(reader);
+  const uint32_t dropFrames = getLatencyBoundDrop(static_cast<uint32_t>(reader.readCountBegin % bufferSize), bufferLevel);
+  if (dropFrames > 0)
+  {
+    // The faded frames are still owned by this reader, since the read counter is moved afterwards.
+    // A failing exchange means that the writer has reset the buffer, then nothing has to be dropped
+    // anymore. The faded frames are behind the write position then, so no reader ever reads them.
+    crossfadeDroppedFrames(static_cast<uint32_t>(reader.readCountBegin % bufferSize), dropFrames, bufferLevel);
+    uint64_t readCount = reader.readCountBegin;
+    if (reader.readCount.compare_exchange_strong(readCount, reader.readCountBegin + dropFrames) == true)
     {
-      result = eIasRingBuffCondWaitFailed;
+      reader.readCountBegin += dropFrames;
+      mNumDroppedFrames.fetch_add(dropFrames, std::memory_order_relaxed);
+      if (readerId == 0)
+      {
+        mHwPtrRead += dropFrames;
+        if (static_cast<uint64_t>(mHwPtrRead) >= mBoundary)
+        {
+          mHwPtrRead -= mBoundary;
+        }
+        mReadOffset = static_cast<uint32_t>(reader.readCountBegin % bufferSize);
+        publishState(eIasRingBufferAccessRead);
+      }
+    }
+    else
+    {
+      reader.readCountBegin = readCount;
     }
   }
-  return result;
 }
 
-IasAudioRingBufferResult IasAudioRingBufferReal::waitRead(uint32_t numPeriods, uint32_t timeout_ms)
+uint32_t IasAudioRingBufferReal::getLatencyBoundDrop(uint32_t readOffset, uint32_t bufferLevel) const
 {
-  if ( (numPeriods > mNumPeriods) || numPeriods == 0 || timeout_ms == 0)
+  if (mMaxReadFillLevel == 0 || bufferLevel <= mMaxReadFillLevel)
   {
-    return eIasRingBuffInvalidParam;
+    return 0;
   }
+  // Continue at the next period boundary behind the frames that exceed the bound. The buffer
+  // size is a multiple of the period size, so the boundary does not depend on the wrap-around.
+  uint32_t newReadOffset = readOffset + bufferLevel - mMaxReadFillLevel;
+  newReadOffset = ((newReadOffset + mPeriodSize - 1) / mPeriodSize) * mPeriodSize;
+  return std::min(newReadOffset - readOffset, bufferLevel);
+}
 
-  IasAudioRingBufferResult result = eIasRingBuffOk;
-  IasLockGuard lock(&mMutex);
-  mReadWaitLevel = numPeriods*mPeriodSize;
-  IasIntProcCondVar::IasResult cndres = IasIntProcCondVar::eIasOk;
-  if (mBufferLevel < mReadWaitLevel)
+void IasAudioRingBufferReal::crossfadeDroppedFrames(uint32_t readOffset, uint32_t dropFrames, uint32_t bufferLevel)
+{
+  const uint32_t crossfadeFrames = std::min(std::min(mReadCrossfadeFrames, dropFrames), bufferLevel - dropFrames);
+  if (crossfadeFrames == 0 || mStreamingState == eIasRingBuffStreamingStateStopRead)
   {
-    cndres = mCondRead.wait(mMutex, timeout_ms);
-    if (cndres == IasIntProcCondVar::eIasTimeout)
-    {
-      result = eIasRingBuffTimeOut;
-    }
-    else if (cndres != IasIntProcCondVar::eIasOk)
+    return;
+  }
+  // Another reader, attached after setReadLatencyBound, might still have to read these frames
+  if (getNumAttachedReaders() > 1)
+  {
+    return;
+  }
+  const uint32_t bufferSize = mNumPeriods*mPeriodSize;
+  IasAudioArea area;
+  area.start = getDataBuffer();
+  area.step  = getFrameStride() * 8;
+  uint32_t done = 0;
+  while (done < crossfadeFrames)
+  {
+    // Split the crossfade where one of both regions wraps around the end of the buffer
+    const uint32_t fadeOutOffset = (readOffset + done) % bufferSize;
+    const uint32_t fadeInOffset  = (readOffset + dropFrames + done) % bufferSize;
+    const uint32_t frames = std::min(crossfadeFrames - done, std::min(bufferSize - fadeOutOffset, bufferSize - fadeInOffset));
+    for (uint32_t channel = 0; channel < mNumChannels; channel++)
     {
-      result = eIasRingBuffCondWaitFailed;
+      area.first = getPlaneStride() * 8 * channel;
+      crossfadeAudioAreaBuffers(&area, mDataFormat, fadeInOffset, 1, 0, frames, &area, fadeOutOffset, done, crossfadeFrames);
     }
+    done += frames;
   }
-  return result;
- }
-
+}
 
-IasAudioRingBufferResult IasAudioRingBufferReal::getTimestamp(IasRingBufferAccess access, IasAudioTimestamp *audioTimestamp)
+IasAudioRingBufferResult IasAudioRingBufferReal::attachReader(uint32_t *readerId)
 {
-  if (audioTimestamp == nullptr)
+  if (readerId == nullptr)
   {
     return eIasRingBuffInvalidParam;
   }
-
-  IasLockGuard lock(&mMutex);
-  if (access == eIasRingBufferAccessRead)
+  if (mInitialized == false)
   {
-    *audioTimestamp = mAudioTimestampAccessRead;
+    return eIasRingBuffNotInitialized;
   }
-  else if (access == eIasRingBufferAccessWrite)
+  if (mSyncMode != eIasRingBuffSyncModeLockFree)
   {
-    *audioTimestamp = mAudioTimestampAccessWrite;
+    return eIasRingBuffNotAllowed;
   }
-  else
+  for (uint32_t i = 0; i < cIasAudioRingBufferMaxReaders; i++)
+  {
+    bool expected = false;
+    if (mReaders[i].attached.compare_exchange_strong(expected, true) == true)
+    {
+      // The new reader starts at the current write position. Until this store is visible the
+      // writer might see an outdated read counter, which only means that it sees less free space.
+      mReaders[i].readInProgress.store(false);
+      mReaders[i].numLostFrames.store(0, std::memory_order_relaxed);
+      mReaders[i].readCount.store(mWriteCount.load(std::memory_order_acquire), std::memory_order_release);
+      *readerId = i;
+      return eIasRingBuffOk;
+    }
+  }
+  return eIasRingBuffNotAllowed;
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::detachReader(uint32_t readerId)
+{
+  if (readerId >= cIasAudioRingBufferMaxReaders)
   {
     return eIasRingBuffInvalidParam;
   }
+  if (mSyncMode != eIasRingBuffSyncModeLockFree)
+  {
+    return eIasRingBuffNotAllowed;
+  }
+  IasAudioRingBufferReader &reader = mReaders[readerId];
+  if (reader.attached.load() == false || reader.readInProgress.load() == true)
+  {
+    return eIasRingBuffNotAllowed;
+  }
+  reader.attached.store(false, std::memory_order_release);
+  // The writer might have been waiting for this reader
+  mFutexWrite.wake(mNumPeriods*mPeriodSize - getWriterFillLevel(mWriteCount.load(std::memory_order_acquire)));
   return eIasRingBuffOk;
 }
 
-
+IasAudioRingBufferResult IasAudioRingBufferReal::updateAvailableRead(uint32_t readerId, uint32_t *samples)
+{
+  if (samples == nullptr || readerId >= cIasAudioRingBufferMaxReaders)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  if (mInitialized == false)
+  {
+    return eIasRingBuffNotInitialized;
+  }
+  if (mSyncMode != eIasRingBuffSyncModeLockFree)
+  {
+    if (readerId != 0)
+    {
+      return eIasRingBuffNotAllowed;
+    }
+    *samples = mBufferLevel;
+    return eIasRingBuffOk;
+  }
+  if (mReaders[readerId].attached.load(std::memory_order_acquire) == false)
+  {
+    return eIasRingBuffNotAllowed;
+  }
+  *samples = getReaderFillLevel(mReaders[readerId]);
+  return eIasRingBuffOk;
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::beginReadAccess(uint32_t readerId, uint32_t* offset, uint32_t* frames, bool wrapAround)
+{
+  if (offset == nullptr || frames == nullptr || readerId >= cIasAudioRingBufferMaxReaders)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  if (mInitialized == false)
+  {
+    return eIasRingBuffNotInitialized;
+  }
+  if (mSyncMode != eIasRingBuffSyncModeLockFree)
+  {
+    if (readerId != 0)
+    {
+      return eIasRingBuffNotAllowed;
+    }
+    return beginAccess(eIasRingBufferAccessRead, offset, frames, wrapAround);
+  }
+  if (mReaders[readerId].attached.load(std::memory_order_acquire) == false)
+  {
+    return eIasRingBuffNotAllowed;
+  }
+  // In a double mapped buffer the frames behind the end of the buffer are always accessible
+  return beginReadLockFree(readerId, offset, frames, wrapAround || mDoubleMapped, false);
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::endReadAccess(uint32_t readerId, uint32_t offset, uint32_t frames)
+{
+  return endReadAccess(readerId, offset, frames, getCurrentTimestamp(), true);
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::endReadAccess(uint32_t readerId, uint32_t offset, uint32_t frames,
+                                                               uint64_t timestamp, bool notify)
+{
+  if (readerId >= cIasAudioRingBufferMaxReaders)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  if (mSyncMode != eIasRingBuffSyncModeLockFree)
+  {
+    if (readerId != 0)
+    {
+      return eIasRingBuffNotAllowed;
+    }
+    return endAccess(eIasRingBufferAccessRead, offset, frames, timestamp, notify);
+  }
+  return endReadLockFree(readerId, frames, timestamp, notify);
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::beginChannelGroupAccess(IasRingBufferAccess access, uint32_t firstChannel, uint32_t numChannels,
+                                                                         uint32_t* offset, uint32_t* frames)
+{
+  if (offset == nullptr || frames == nullptr || access == eIasRingBufferAccessUndef ||
+      numChannels == 0 || (firstChannel + numChannels) > mNumChannels)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  if (mInitialized == false)
+  {
+    return eIasRingBuffNotInitialized;
+  }
+  // The last group that commits ends the access, which is usually a different thread than the
+  // one that has begun it. This is not possible with the mutexes of the mutex based mode.
+  if (mSyncMode != eIasRingBuffSyncModeLockFree || mNumChannels > cIasAudioRingBufferMaxGroupChannels)
+  {
+    return eIasRingBuffNotAllowed;
+  }
+  const uint64_t groupMask = (numChannels == 64) ? ~0ull : (((1ull << numChannels) - 1) << firstChannel);
+  IasAudioRingBufferChannelGroups &groups = (access == eIasRingBufferAccessRead) ? mReadGroups : mWriteGroups;
+  IasLockGuard lock(&mMutexChannelGroups);
+  if ((groups.beganMask & groupMask) != 0)
+  {
+    // Some of the channels are already accessed by another group
+    return eIasRingBuffNotAllowed;
+  }
+  if (groups.beganMask == 0)
+  {
+    groups.frames = *frames;
+    IasAudioRingBufferResult result = beginAccess(access, &groups.offset, &groups.frames);
+    if (result != eIasRingBuffOk)
+    {
+      return result;
+    }
+    groups.committedMask = 0;
+    groups.committedFrames = groups.frames;
+  }
+  groups.beganMask |= groupMask;
+  *offset = groups.offset;
+  *frames = groups.frames;
+  return eIasRingBuffOk;
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::endChannelGroupAccess(IasRingBufferAccess access, uint32_t firstChannel, uint32_t numChannels, uint32_t frames)
+{
+  if (access == eIasRingBufferAccessUndef || numChannels == 0 || (firstChannel + numChannels) > mNumChannels)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  if (mSyncMode != eIasRingBuffSyncModeLockFree || mNumChannels > cIasAudioRingBufferMaxGroupChannels)
+  {
+    return eIasRingBuffNotAllowed;
+  }
+  const uint64_t groupMask = (numChannels == 64) ? ~0ull : (((1ull << numChannels) - 1) << firstChannel);
+  const uint64_t allChannelsMask = (mNumChannels == 64) ? ~0ull : ((1ull << mNumChannels) - 1);
+  IasAudioRingBufferChannelGroups &groups = (access == eIasRingBufferAccessRead) ? mReadGroups : mWriteGroups;
+  IasLockGuard lock(&mMutexChannelGroups);
+  if ((groups.beganMask & groupMask) != groupMask || (groups.committedMask & groupMask) != 0)
+  {
+    return eIasRingBuffNotAllowed;
+  }
+  if (frames > groups.frames)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  groups.committedMask |= groupMask;
+  groups.committedFrames = std::min(groups.committedFrames, frames);
+  if (groups.committedMask != allChannelsMask)
+  {
+    return eIasRingBuffOk;
+  }
+  // All channels are committed now, so the region can be released
+  IasAudioRingBufferResult result = endAccess(access, groups.offset, groups.committedFrames);
+  groups.beganMask = 0;
+  groups.committedMask = 0;
+  return result;
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::beginReadLockFree(uint32_t readerId, uint32_t* offset, uint32_t* frames, bool wrapAround, bool peeked)
+{
+  const uint32_t bufferSize = mNumPeriods*mPeriodSize;
+  IasAudioRingBufferReader &reader = mReaders[readerId];
+  bool expected = false;
+  if (reader.readInProgress.compare_exchange_strong(expected, true) == false)
+  {
+    return countError(eIasRingBufferAccessRead, eIasRingBuffNotAllowed);
+  }
+  reader.wrapAround = wrapAround;
+  reader.readCountBegin = reader.readCount.load(std::memory_order_acquire);
+  // Frames that have been peeked are consumed exactly, a lap since the peek is reported by the end of the access
+  if (mOverrunMode == eIasRingBuffOverrunOverwrite && peeked == false)
+  {
+    skipOverwrittenFrames(readerId);
+  }
+  if (peeked == false)
+  {
+    applyReadLatencyBound(readerId);
+  }
+  const uint32_t bufferLevel = getReaderFillLevel(reader);
+  reader.readOffset = static_cast<uint32_t>(reader.readCountBegin % bufferSize);
+  if (readerId == 0)
+  {
+    mReadOffset = reader.readOffset;
+  }
+  *offset = reader.readOffset;
+
+  // If reading from the buffer is blocked -> return with 0 frames.
+  if (mStreamingState == eIasRingBuffStreamingStateStopRead)
+  {
+    *frames = 0;
+  }
+  else
+  {
+    if ( (*frames) > bufferLevel )
+    {
+      *frames = bufferLevel;
+      countXrun(eIasRingBufferAccessRead);
+    }
+    if ( (wrapAround == false) && ((reader.readOffset + *frames) >= bufferSize) )
+    {
+      *frames = bufferSize - reader.readOffset;
+    }
+  }
+  return eIasRingBuffOk;
+}
+
+void IasAudioRingBufferReal::skipOverwrittenFrames(uint32_t readerId)
+{
+  const uint32_t bufferSize = mNumPeriods*mPeriodSize;
+  IasAudioRingBufferReader &reader = mReaders[readerId];
+  const uint64_t writeReserve = mWriteReserve.load(std::memory_order_acquire);
+  if (writeReserve <= reader.readCountBegin + bufferSize)
+  {
+    return;
+  }
+  // The writer has lapped this reader. Continue with the oldest frames, which are not touched by
+  // the write access that might be in progress right now.
+  const uint64_t oldestValid = writeReserve - bufferSize;
+  uint64_t readCount = reader.readCountBegin;
+  if (reader.readCount.compare_exchange_strong(readCount, oldestValid) == false)
+  {
+    // The writer has reset the buffer in the meantime
+    reader.readCountBegin = readCount;
+    return;
+  }
+  const uint64_t lostFrames = oldestValid - reader.readCountBegin;
+  reader.readCountBegin = oldestValid;
+  reader.numLostFrames.fetch_add(lostFrames, std::memory_order_relaxed);
+  mNumOverwrittenFrames.fetch_add(lostFrames, std::memory_order_relaxed);
+  if (readerId == 0)
+  {
+    mHwPtrRead = static_cast<int64_t>((static_cast<uint64_t>(mHwPtrRead) + lostFrames) % mBoundary);
+    mReadOffset = static_cast<uint32_t>(reader.readCountBegin % bufferSize);
+    publishState(eIasRingBufferAccessRead);
+  }
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::getNumLostFrames(uint32_t readerId, uint64_t *numLostFrames) const
+{
+  if (numLostFrames == nullptr || readerId >= cIasAudioRingBufferMaxReaders)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  if (mInitialized == false)
+  {
+    return eIasRingBuffNotInitialized;
+  }
+  *numLostFrames = mReaders[readerId].numLostFrames.load(std::memory_order_relaxed);
+  return eIasRingBuffOk;
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::beginWriteLockFree(uint32_t* offset, uint32_t* frames, bool wrapAround)
+{
+  const uint32_t bufferSize = mNumPeriods*mPeriodSize;
+  bool expected = false;
+  if (mWriteInProgress.compare_exchange_strong(expected, true) == false)
+  {
+    return countError(eIasRingBufferAccessWrite, eIasRingBuffNotAllowed);
+  }
+  mWriteWrapAround = wrapAround;
+  uint64_t writeCount = mWriteCount.load(std::memory_order_relaxed);
+  // An overwriting writer may use the whole buffer, regardless of the position of the readers
+  uint32_t bufferLevel = (mOverrunMode == eIasRingBuffOverrunOverwrite) ? 0 : getWriterFillLevel(writeCount);
+  mWriteOffset = static_cast<uint32_t>(writeCount % bufferSize);
+  *offset = mWriteOffset;
+
+  // If writing into the buffer is blocked -> return with 0 frames.
+  if (mStreamingState == eIasRingBuffStreamingStateStopWrite)
+  {
+    *frames = 0;
+  }
+  else
+  {
+    if ( (*frames) > (bufferSize - bufferLevel) )
+    {
+      *frames = bufferSize - bufferLevel;
+      countXrun(eIasRingBufferAccessWrite);
+    }
+    if ( (wrapAround == false) && ((mWriteOffset + *frames) >= bufferSize) )
+    {
+      *frames = bufferSize - mWriteOffset;
+    }
+  }
+  if (mOverrunMode == eIasRingBuffOverrunOverwrite)
+  {
+    // Announce the region before the first sample is written into it. A reader that checks the
+    // reserve after reading its frames (see endReadLockFree) then detects that they were overwritten.
+    const uint64_t writeReserve = writeCount + *frames;
+    if (writeReserve > mWriteReserve.load(std::memory_order_relaxed))
+    {
+      mWriteReserve.store(writeReserve, std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+  return eIasRingBuffOk;
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::endReadLockFree(uint32_t readerId, uint32_t frames, uint64_t timestamp, bool notify)
+{
+  const uint32_t bufferSize = mNumPeriods*mPeriodSize;
+  IasAudioRingBufferReader &reader = mReaders[readerId];
+  if (reader.readInProgress)
+  {
+    uint64_t bufferLevel = mWriteCount.load(std::memory_order_acquire) - reader.readCountBegin;
+    if ( (frames > bufferLevel) || ((reader.wrapAround == false) && ((reader.readOffset + frames) > bufferSize)) )
+    {
+      return countError(eIasRingBufferAccessRead, eIasRingBuffInvalidParam);
+    }
+    uint64_t lostFrames = 0;
+    if (mOverrunMode == eIasRingBuffOverrunOverwrite)
+    {
+      // The samples have been read before, so this fence orders the check behind them
+      std::atomic_thread_fence(std::memory_order_acquire);
+      const uint64_t oldestValid = mWriteReserve.load(std::memory_order_relaxed);
+      if (oldestValid > reader.readCountBegin + bufferSize)
+      {
+        lostFrames = std::min(oldestValid - bufferSize - reader.readCountBegin, static_cast<uint64_t>(frames));
+        reader.numLostFrames.fetch_add(lostFrames, std::memory_order_relaxed);
+        mNumOverwrittenFrames.fetch_add(lostFrames, std::memory_order_relaxed);
+      }
+      bufferLevel = std::min(bufferLevel, static_cast<uint64_t>(bufferSize));
+    }
+    // The read counter is only modified by somebody else if the writer has reset the buffer
+    // in the meantime. In this case the frames are discarded anyway, so a failing exchange
+    // is not an error.
+    uint64_t readCount = reader.readCountBegin;
+    if (reader.readCount.compare_exchange_strong(readCount, reader.readCountBegin + frames) == true)
+    {
+      readCount = reader.readCountBegin + frames;
+    }
+    reader.readOffset = static_cast<uint32_t>(readCount % bufferSize);
+    if (readerId == 0)
+    {
+      // The hw pointer and the timestamp belong to the default reader, which is the one the ALSA plugin uses
+      mReadOffset = reader.readOffset;
+      mHwPtrRead += frames;
+      if (static_cast<uint64_t>(mHwPtrRead) >= mBoundary)
+      {
+        mHwPtrRead -= mBoundary;
+      }
+
+      mAudioTimestampAccessRead.timestamp = timestamp;
+      mAudioTimestampAccessRead.numTransmittedFrames += frames;
+      recordTimestamp(mReadHistory, frames);
+      publishState(eIasRingBufferAccessRead);
+    }
+    updateCommitStatistics(eIasRingBufferAccessRead, frames, static_cast<uint32_t>(bufferLevel - frames));
+
+    reader.readInProgress.store(false, std::memory_order_release);
+    if (notify == true)
+    {
+      signalAccess(eIasRingBufferAccessRead, frames);
+    }
+    if (lostFrames > 0)
+    {
+      // The access is committed anyway, but the caller has to discard what it has read
+      return eIasRingBuffDataOverwritten;
+    }
+  }
+  return eIasRingBuffOk;
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::endWriteLockFree(uint32_t frames, uint64_t timestamp, bool notify)
+{
+  const uint32_t bufferSize = mNumPeriods*mPeriodSize;
+  if (mWriteInProgress)
+  {
+    uint64_t writeCount = mWriteCount.load(std::memory_order_relaxed);
+    uint32_t bufferLevel = (mOverrunMode == eIasRingBuffOverrunOverwrite) ? 0 : getWriterFillLevel(writeCount);
+    if ( ((bufferLevel + frames) > bufferSize) ||
+         ((mWriteWrapAround == false) && ((mWriteOffset + frames) > bufferSize)) ||
+         ((mOverrunMode == eIasRingBuffOverrunOverwrite) && ((writeCount + frames) > mWriteReserve.load(std::memory_order_relaxed))) )
+    {
+      return countError(eIasRingBufferAccessWrite, eIasRingBuffInvalidParam);
+    }
+    mWriteCount.store(writeCount + frames, std::memory_order_release);
+    bufferLevel = (mOverrunMode == eIasRingBuffOverrunOverwrite) ? getWriterFillLevel(writeCount + frames) : bufferLevel + frames;
+    mWriteOffset = static_cast<uint32_t>((writeCount + frames) % bufferSize);
+    mHwPtrWrite += frames;
+    if (static_cast<uint64_t>(mHwPtrWrite) >= mBoundary)
+    {
+      mHwPtrWrite -= mBoundary;
+    }
+
+    mAudioTimestampAccessWrite.timestamp = timestamp;
+    mAudioTimestampAccessWrite.numTransmittedFrames += frames;
+    recordTimestamp(mWriteHistory, frames);
+    updateCommitStatistics(eIasRingBufferAccessWrite, frames, bufferLevel);
+    publishState(eIasRingBufferAccessWrite);
+
+    mWriteInProgress.store(false, std::memory_order_release);
+    if (notify == true)
+    {
+      signalAccess(eIasRingBufferAccessWrite, frames);
+    }
+  }
+  return eIasRingBuffOk;
+}
+
+IasFdSignal* IasAudioRingBufferReal::notifyAccess(IasRingBufferAccess access)
+{
+  const uint32_t bufferSize = mNumPeriods*mPeriodSize;
+  if (access == eIasRingBufferAccessRead)
+  {
+    // The free space of the writer is determined by the slowest reader
+    uint32_t freeSpace = bufferSize - mBufferLevel;
+    if (mSyncMode == eIasRingBuffSyncModeLockFree)
+    {
+      freeSpace = bufferSize - getWriterFillLevel(mWriteCount.load(std::memory_order_acquire));
+    }
+    mFutexWrite.wake(freeSpace);
+    // The snd_pcm_wait function on the plugin (client) side shall not return
+    // before at least avail_min frames are available (free).
+    if (mFdSignal != nullptr && mDeviceType == eIasDeviceTypeSource && freeSpace >= mAvailMin)
+    {
+      return mFdSignal;
+    }
+  }
+  else if (access == eIasRingBufferAccessWrite)
+  {
+    uint32_t bufferLevel = mBufferLevel;
+    if (mSyncMode == eIasRingBuffSyncModeLockFree)
+    {
+      bufferLevel = getWriterFillLevel(mWriteCount.load(std::memory_order_acquire));
+      for (uint32_t i = 0; i < cIasAudioRingBufferMaxReaders; i++)
+      {
+        if (mReaders[i].attached.load(std::memory_order_acquire) == true)
+        {
+          mReaders[i].futex.wake(getReaderFillLevel(mReaders[i]));
+        }
+      }
+    }
+    else
+    {
+      mReaders[0].futex.wake(bufferLevel);
+    }
+    // The snd_pcm_wait function on the plugin (client) side shall not return
+    // before at least avail_min frames are available (filled).
+    if (mFdSignal != nullptr && mDeviceType == eIasDeviceTypeSink && bufferLevel >= mAvailMin)
+    {
+      return mFdSignal;
+    }
+  }
+  return nullptr;
+}
+
+void IasAudioRingBufferReal::signalAccess(IasRingBufferAccess access, uint32_t frames)
+{
+  IasFdSignal *fdSignal = notifyAccess(access);
+  if (fdSignal != nullptr && frames > 0)
+  {
+    fdSignal->write();
+  }
+}
+
+uint64_t IasAudioRingBufferReal::getCurrentTimestamp()
+{
+  auto durationSinceEpoch = std::chrono::high_resolution_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::microseconds>(durationSinceEpoch).count();
+}
+
+uint32_t IasAudioRingBufferReal::getReaderFillLevel(const IasAudioRingBufferReader &reader) const
+{
+  const uint64_t readCount  = reader.readCount.load(std::memory_order_acquire);
+  const uint64_t writeCount = mWriteCount.load(std::memory_order_acquire);
+  return static_cast<uint32_t>(std::min(writeCount - readCount, static_cast<uint64_t>(mNumPeriods*mPeriodSize)));
+}
+
+uint32_t IasAudioRingBufferReal::getWriterFillLevel(uint64_t writeCount) const
+{
+  // The level is clamped, because a reader that is attaching right now might still have an outdated read counter.
+  uint64_t bufferLevel = 0;
+  for (uint32_t i = 0; i < cIasAudioRingBufferMaxReaders; i++)
+  {
+    if (mReaders[i].attached.load(std::memory_order_acquire) == true)
+    {
+      // If called by a reader, another reader might already be beyond the given write counter
+      const uint64_t readCount = mReaders[i].readCount.load(std::memory_order_acquire);
+      if (readCount < writeCount)
+      {
+        bufferLevel = std::max(bufferLevel, writeCount - readCount);
+      }
+    }
+  }
+  return static_cast<uint32_t>(std::min(bufferLevel, static_cast<uint64_t>(mNumPeriods*mPeriodSize)));
+}
+
+void IasAudioRingBufferReal::triggerFdSignal()
+{
+  if (mFdSignal != nullptr)
+  {
+    mFdSignal->write();
+  }
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::getPeriodMetaData(uint32_t offset, void **metaData) const
+{
+  if (metaData == nullptr || offset >= mNumPeriods*mPeriodSize)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  if (mInitialized == false)
+  {
+    return eIasRingBuffNotInitialized;
+  }
+  const uint32_t period = offset / mPeriodSize;
+  if (period >= mNumMetaData)
+  {
+    return eIasRingBuffNotAllowed;
+  }
+  *metaData = mMetaData.get() + static_cast<size_t>(period) * mMetaDataSize;
+  return eIasRingBuffOk;
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::getDataFormat(IasAudioCommonDataFormat *dataFormat) const
+{
+  if (dataFormat == nullptr)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+
+  *dataFormat = mDataFormat;
+  return eIasRingBuffOk;
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::waitWrite(uint32_t numPeriods, uint32_t timeout_ms )
+{
+  if ( (numPeriods > mNumPeriods) || numPeriods == 0 || timeout_ms == 0)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  return waitForFrames(eIasRingBufferAccessWrite, 0, numPeriods*mPeriodSize, timeout_ms);
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::waitRead(uint32_t numPeriods, uint32_t timeout_ms)
+{
+  return waitRead(0, numPeriods, timeout_ms);
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::waitRead(uint32_t readerId, uint32_t numPeriods, uint32_t timeout_ms)
+{
+  if ( (numPeriods > mNumPeriods) || numPeriods == 0 || timeout_ms == 0 || readerId >= cIasAudioRingBufferMaxReaders)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  return waitForFrames(eIasRingBufferAccessRead, readerId, numPeriods*mPeriodSize, timeout_ms);
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::waitForFrames(IasRingBufferAccess access, uint32_t readerId, uint32_t numFrames, uint32_t timeout_ms)
+{
+  IasIntProcFutex &futex = (access == eIasRingBufferAccessRead) ? mReaders[readerId].futex : mFutexWrite;
+  IasAudioRingBufferResult result = eIasRingBuffOk;
+  std::chrono::steady_clock::time_point timeout = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+  // Only the time spent in the futex counts as a wait, not an early return with enough frames
+  std::chrono::steady_clock::time_point waitStart;
+  bool waited = false;
+
+  // The waiter has to be registered before the fill level is checked. Then the counterpart
+  // either sees the waiter in endAccess or we see the new fill level here.
+  futex.registerWaiter(numFrames);
+  while (true)
+  {
+    uint32_t sequence = futex.getSequence();
+    uint32_t available = 0;
+    IasAudioRingBufferResult res;
+    if (access == eIasRingBufferAccessRead)
+    {
+      res = updateAvailableRead(readerId, &available);
+    }
+    else
+    {
+      res = updateAvailable(access, &available);
+    }
+    if (res != eIasRingBuffOk)
+    {
+      result = res;
+      break;
+    }
+    if (available >= numFrames)
+    {
+      break;
+    }
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now >= timeout)
+    {
+      result = eIasRingBuffTimeOut;
+      break;
+    }
+    uint64_t remaining_ms = std::chrono::duration_cast<std::chrono::milliseconds>(timeout - now).count() + 1;
+    if (waited == false)
+    {
+      waited = true;
+      waitStart = now;
+    }
+    IasIntProcFutex::IasResult futres = futex.wait(sequence, remaining_ms);
+    if (futres == IasIntProcFutex::eIasTimeout)
+    {
+      result = eIasRingBuffTimeOut;
+      break;
+    }
+    else if (futres != IasIntProcFutex::eIasOk)
+    {
+      result = eIasRingBuffCondWaitFailed;
+      break;
+    }
+  }
+  futex.unregisterWaiter();
+
+  if (waited == false)
+  {
+    return result;
+  }
+  IasAudioRingBufferAccessCounters &counters = (access == eIasRingBufferAccessRead) ? mStatistics.read : mStatistics.write;
+  const uint64_t waitTimeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - waitStart).count();
+  counters.numWaits.fetch_add(1, std::memory_order_relaxed);
+  counters.waitTimeNs.fetch_add(waitTimeNs, std::memory_order_relaxed);
+  uint64_t maxWaitTimeNs = counters.maxWaitTimeNs.load(std::memory_order_relaxed);
+  while (waitTimeNs > maxWaitTimeNs &&
+         counters.maxWaitTimeNs.compare_exchange_weak(maxWaitTimeNs, waitTimeNs, std::memory_order_relaxed) == false)
+  {
+  }
+  if (result == eIasRingBuffTimeOut)
+  {
+    counters.numWaitTimeouts.fetch_add(1, std::memory_order_relaxed);
+  }
+  return result;
+}
+
+
+IasAudioRingBufferResult IasAudioRingBufferReal::getTimestamp(IasRingBufferAccess access, IasAudioTimestamp *audioTimestamp)
+{
+  if (audioTimestamp == nullptr)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+
+  if (access != eIasRingBufferAccessRead && access != eIasRingBufferAccessWrite)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  IasAudioRingBufferState state;
+  getState(&state);
+  *audioTimestamp = (access == eIasRingBufferAccessRead) ? state.timestampRead : state.timestampWrite;
+  return eIasRingBuffOk;
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::getState(IasAudioRingBufferState *state) const
+{
+  if (state == nullptr)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  // Both sequences are combined, so the snapshot is retried if either side has published in the
+  // meantime. Only the snapshot reader retries, the reader and the writer side never wait.
+  uint32_t readSequence = 0;
+  uint32_t writeSequence = 0;
+  do
+  {
+    readSequence  = mPublishedRead.sequence.load(std::memory_order_acquire);
+    writeSequence = mPublishedWrite.sequence.load(std::memory_order_acquire);
+    state->readOffset                          = mPublishedRead.offset.load(std::memory_order_relaxed);
+    state->hwPtrRead                           = mPublishedRead.hwPtr.load(std::memory_order_relaxed);
+    state->timestampRead.timestamp             = mPublishedRead.timestamp.load(std::memory_order_relaxed);
+    state->timestampRead.numTransmittedFrames  = mPublishedRead.frames.load(std::memory_order_relaxed);
+    state->writeOffset                         = mPublishedWrite.offset.load(std::memory_order_relaxed);
+    state->hwPtrWrite                          = mPublishedWrite.hwPtr.load(std::memory_order_relaxed);
+    state->timestampWrite.timestamp            = mPublishedWrite.timestamp.load(std::memory_order_relaxed);
+    state->timestampWrite.numTransmittedFrames = mPublishedWrite.frames.load(std::memory_order_relaxed);
+    // The frame counters are maintained in both sync modes, so the level seen by the default
+    // reader follows from them and is not published by either side.
+    state->bufferLevel = getReaderFillLevel(mReaders[0]);
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while (((readSequence | writeSequence) & 1) != 0 ||
+           readSequence != mPublishedRead.sequence.load(std::memory_order_relaxed) ||
+           writeSequence != mPublishedWrite.sequence.load(std::memory_order_relaxed));
+  return eIasRingBuffOk;
+}
+
+void IasAudioRingBufferReal::publishState(IasRingBufferAccess access)
+{
+  if (access != eIasRingBufferAccessWrite)
+  {
+    publishDirection(mPublishedRead, mReadOffset, mHwPtrRead, mAudioTimestampAccessRead);
+  }
+  if (access != eIasRingBufferAccessRead)
+  {
+    publishDirection(mPublishedWrite, mWriteOffset, mHwPtrWrite, mAudioTimestampAccessWrite);
+  }
+}
+
+void IasAudioRingBufferReal::publishDirection(IasAudioRingBufferPublishedState &published, uint32_t offset, int64_t hwPtr,
+                                              const IasAudioTimestamp &timestamp)
+{
+  // Single writer, so the odd sequence number can simply be stored
+  const uint32_t sequence = published.sequence.load(std::memory_order_relaxed);
+  published.sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  published.offset.store(offset, std::memory_order_relaxed);
+  published.hwPtr.store(hwPtr, std::memory_order_relaxed);
+  published.timestamp.store(timestamp.timestamp, std::memory_order_relaxed);
+  published.frames.store(timestamp.numTransmittedFrames, std::memory_order_relaxed);
+  published.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::getTimestampHistory(IasRingBufferAccess access,
+                                                                     IasAudioRingBufferTimestampEntry *entries,
+                                                                     uint32_t *numEntries) const
+{
+  if (entries == nullptr || numEntries == nullptr || access == eIasRingBufferAccessUndef)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  if (mInitialized == false)
+  {
+    return eIasRingBuffNotInitialized;
+  }
+  const IasAudioRingBufferTimestampHistory &history = (access == eIasRingBufferAccessRead) ? mReadHistory : mWriteHistory;
+  const uint64_t count = history.numEntries.load(std::memory_order_acquire);
+  uint32_t numValid = 0;
+  for (uint64_t entry = count; entry > 0 && numValid < *numEntries && (count - entry) < cIasAudioRingBufferTimestampHistorySize; entry--)
+  {
+    const IasAudioRingBufferTimestampSlot &slot = history.slots[(entry - 1) % cIasAudioRingBufferTimestampHistorySize];
+    const uint64_t sequenceBegin = slot.sequence.load(std::memory_order_acquire);
+    entries[numValid].framePosition = slot.framePosition.load(std::memory_order_relaxed);
+    entries[numValid].timestampNs = slot.timestampNs.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t sequenceEnd = slot.sequence.load(std::memory_order_relaxed);
+    if (sequenceBegin != entry || sequenceEnd != entry)
+    {
+      // The writer has wrapped around in the meantime, all older slots are outdated as well
+      break;
+    }
+    numValid++;
+  }
+  *numEntries = numValid;
+  return eIasRingBuffOk;
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::getStatistics(IasAudioRingBufferStatistics *statistics) const
+{
+  if (statistics == nullptr)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  if (mInitialized == false)
+  {
+    return eIasRingBuffNotInitialized;
+  }
+  const IasAudioRingBufferAccessCounters *counters[2] = { &mStatistics.read, &mStatistics.write };
+  IasAudioRingBufferAccessStatistics *accessStatistics[2] = { &statistics->read, &statistics->write };
+  for (uint32_t i = 0; i < 2; i++)
+  {
+    accessStatistics[i]->numCommits      = counters[i]->numCommits.load(std::memory_order_relaxed);
+    accessStatistics[i]->numFrames       = counters[i]->numFrames.load(std::memory_order_relaxed);
+    accessStatistics[i]->numXruns        = counters[i]->numXruns.load(std::memory_order_relaxed);
+    accessStatistics[i]->numErrors       = counters[i]->numErrors.load(std::memory_order_relaxed);
+    accessStatistics[i]->numWaits        = counters[i]->numWaits.load(std::memory_order_relaxed);
+    accessStatistics[i]->numWaitTimeouts = counters[i]->numWaitTimeouts.load(std::memory_order_relaxed);
+    accessStatistics[i]->waitTimeNs      = counters[i]->waitTimeNs.load(std::memory_order_relaxed);
+    accessStatistics[i]->maxWaitTimeNs   = counters[i]->maxWaitTimeNs.load(std::memory_order_relaxed);
+  }
+  statistics->bufferSize = mNumPeriods*mPeriodSize;
+  const uint32_t fillLevelMin = mStatistics.fillLevelMin.load(std::memory_order_relaxed);
+  statistics->fillLevelMin = (fillLevelMin == UINT32_MAX) ? 0 : fillLevelMin;
+  statistics->fillLevelMax = mStatistics.fillLevelMax.load(std::memory_order_relaxed);
+  for (uint32_t i = 0; i < cIasAudioRingBufferFillLevelBins; i++)
+  {
+    statistics->fillLevelHistogram[i] = mStatistics.fillLevelHistogram[i].load(std::memory_order_relaxed);
+  }
+  statistics->numDroppedFrames = mNumDroppedFrames.load(std::memory_order_relaxed);
+  statistics->numOverwrittenFrames = mNumOverwrittenFrames.load(std::memory_order_relaxed);
+  return eIasRingBuffOk;
+}
+
+void IasAudioRingBufferReal::updateCommitStatistics(IasRingBufferAccess access, uint32_t frames, uint32_t bufferLevel)
+{
+  IasAudioRingBufferAccessCounters &counters = (access == eIasRingBufferAccessRead) ? mStatistics.read : mStatistics.write;
+  counters.numCommits.fetch_add(1, std::memory_order_relaxed);
+  counters.numFrames.fetch_add(frames, std::memory_order_relaxed);
+
+  uint32_t fillLevelMin = mStatistics.fillLevelMin.load(std::memory_order_relaxed);
+  while (bufferLevel < fillLevelMin &&
+         mStatistics.fillLevelMin.compare_exchange_weak(fillLevelMin, bufferLevel, std::memory_order_relaxed) == false)
+  {
+  }
+  uint32_t fillLevelMax = mStatistics.fillLevelMax.load(std::memory_order_relaxed);
+  while (bufferLevel > fillLevelMax &&
+         mStatistics.fillLevelMax.compare_exchange_weak(fillLevelMax, bufferLevel, std::memory_order_relaxed) == false)
+  {
+  }
+  const uint64_t bin = (static_cast<uint64_t>(bufferLevel) * cIasAudioRingBufferFillLevelBins) / (mNumPeriods*mPeriodSize);
+  mStatistics.fillLevelHistogram[std::min(bin, static_cast<uint64_t>(cIasAudioRingBufferFillLevelBins - 1))].fetch_add(1, std::memory_order_relaxed);
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::countError(IasRingBufferAccess access, IasAudioRingBufferResult result)
+{
+  IasAudioRingBufferAccessCounters &counters = (access == eIasRingBufferAccessRead) ? mStatistics.read : mStatistics.write;
+  counters.numErrors.fetch_add(1, std::memory_order_relaxed);
+  return result;
+}
+
+void IasAudioRingBufferReal::countXrun(IasRingBufferAccess access)
+{
+  IasAudioRingBufferAccessCounters &counters = (access == eIasRingBufferAccessRead) ? mStatistics.read : mStatistics.write;
+  counters.numXruns.fetch_add(1, std::memory_order_relaxed);
+}
+
+void IasAudioRingBufferReal::recordTimestamp(IasAudioRingBufferTimestampHistory &history, uint32_t frames)
+{
+  const uint64_t previousPosition = history.framePosition;
+  history.framePosition += frames;
+  if ((previousPosition / mPeriodSize) == (history.framePosition / mPeriodSize))
+  {
+    return;
+  }
+  const uint64_t entry = history.numEntries.load(std::memory_order_relaxed) + 1;
+  IasAudioRingBufferTimestampSlot &slot = history.slots[(entry - 1) % cIasAudioRingBufferTimestampHistorySize];
+  slot.sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  slot.framePosition.store(history.framePosition, std::memory_order_relaxed);
+  slot.timestampNs.store(getTimeNs(), std::memory_order_relaxed);
+  slot.sequence.store(entry, std::memory_order_release);
+  history.numEntries.store(entry, std::memory_order_release);
+}
+
+uint64_t IasAudioRingBufferReal::getTimeNs() const
+{
+#if defined(__x86_64__) || defined(__i386__)
+  if (mClockSource == eIasRingBuffClockTsc)
+  {
+    return mTscBaseNs + static_cast<uint64_t>(static_cast<double>(__rdtsc() - mTscBaseTicks) * mTscNsPerTick);
+  }
+#endif
+  return getMonotonicNs();
+}
+
+
 void IasAudioRingBufferReal::resetFromWriter()
 {
+  if (mSyncMode == eIasRingBuffSyncModeLockFree)
+  {
+    // The read counters belong to the readers, so move them forward to the write counter
+    // with an exchange instead of locking out the readers.
+    const uint64_t writeCount = mWriteCount.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < cIasAudioRingBufferMaxReaders; i++)
+    {
+      if (mReaders[i].attached.load(std::memory_order_acquire) == true)
+      {
+        uint64_t readCount = mReaders[i].readCount.load(std::memory_order_acquire);
+        while (mReaders[i].readCount.compare_exchange_weak(readCount, writeCount) == false)
+        {
+        }
+      }
+    }
+    publishState(eIasRingBufferAccessWrite);
+    return;
+  }
   mMutexReadInProgress.lock();
   mReadOffset  = 0;
   mWriteOffset = 0;
   mBufferLevel = 0;
+  mReaders[0].readCount.store(mWriteCount.load(std::memory_order_relaxed), std::memory_order_release);
+  publishState(eIasRingBufferAccessUndef);
   mMutexReadInProgress.unlock();
 };
 
 
 void IasAudioRingBufferReal::resetFromReader()
 {
+  resetFromReader(0);
+}
+
+
+void IasAudioRingBufferReal::resetFromReader(uint32_t readerId)
+{
+  if (mSyncMode == eIasRingBuffSyncModeLockFree)
+  {
+    if (readerId < cIasAudioRingBufferMaxReaders)
+    {
+      // Discard everything the writer has committed so far.
+      mReaders[readerId].readCount.store(mWriteCount.load(std::memory_order_acquire));
+      if (readerId == 0)
+      {
+        publishState(eIasRingBufferAccessRead);
+      }
+    }
+    return;
+  }
+  if (readerId != 0)
+  {
+    return;
+  }
   mMutexWriteInProgress.lock();
   mReadOffset  = 0;
   mWriteOffset = 0;
   mBufferLevel = 0;
+  mReaders[0].readCount.store(mWriteCount.load(std::memory_order_relaxed), std::memory_order_release);
+  publishState(eIasRingBufferAccessUndef);
   mMutexWriteInProgress.unlock();
 };
 
@@ -449,6 +1791,7 @@ void IasAudioRingBufferReal::setBoundary(uint64_t boundary)
   //instead of holding the current availability in one "hardware" pointer (which in this case
   //really be something like (mHwPtrWrite - mApplPtrWrite)).
   mHwPtrWrite = mAvailMin;
+  publishState(eIasRingBufferAccessUndef);
 }
 
 void IasAudioRingBufferReal::setFdSignal(IasFdSignal *fdSignal, IasDeviceType deviceType)
@@ -468,16 +1811,224 @@ uint32_t IasAudioRingBufferReal::getNumberPeriods() const
   return mNumPeriods;
 }
 
+uint32_t IasAudioRingBufferReal::getPlaneStride() const
+{
+  if (mDataLayout == eIasLayoutInterleaved)
+  {
+    return mSampleSize;
+  }
+  uint32_t planeStride = mNumPeriods*mPeriodSize*mSampleSize;
+  if (mDoubleMapped == true)
+  {
+    planeStride *= 2;
+  }
+  return planeStride + mPlanePadding;
+}
+
+uint32_t IasAudioRingBufferReal::calculatePlanePadding(uint32_t planeSize, uint32_t requested)
+{
+  if (requested != cIasAudioRingBufferPlanePaddingAuto)
+  {
+    return requested;
+  }
+  // Keep every plane on a cache line boundary
+  uint32_t planeStride = (planeSize + cIasAudioRingBufferDataAlignment - 1) & ~(cIasAudioRingBufferDataAlignment - 1);
+  // With an even number of cache lines, e.g. for the usual power of two geometries, the planes map to a
+  // few cache sets only (and to the same 4K alias for a multiple of 4096 bytes). With an odd number of
+  // cache lines, consecutive planes start in different cache sets.
+  if (((planeStride / cIasAudioRingBufferDataAlignment) % 2) == 0)
+  {
+    planeStride += cIasAudioRingBufferDataAlignment;
+  }
+  return planeStride - planeSize;
+}
+
+uint32_t IasAudioRingBufferReal::getDataSize(uint32_t periodSize, uint32_t nPeriods, uint32_t nChannels) const
+{
+  const uint32_t planeSize = nPeriods*periodSize*mSampleSize;
+  if (mDataLayout == eIasLayoutInterleaved)
+  {
+    return planeSize*nChannels;
+  }
+  return calculateDataSize(planeSize, nChannels, mPlanePaddingOption);
+}
+
+uint32_t IasAudioRingBufferReal::calculateDataSize(uint32_t planeSize, uint32_t numChannels, uint32_t requested)
+{
+  // The padding behind the last plane is not needed
+  return numChannels * planeSize + (numChannels - 1) * calculatePlanePadding(planeSize, requested);
+}
+
+uint32_t IasAudioRingBufferReal::getFrameStride() const
+{
+  if (mDataLayout == eIasLayoutInterleaved)
+  {
+    return mNumChannels*mSampleSize;
+  }
+  return mSampleSize;
+}
+
+void IasAudioRingBufferReal::initBoundary()
+{
+  // Set it to an initial value similar like the default value used in the alsa-lib.
+  mBoundary = mPeriodSize*mNumPeriods;
+  while (mBoundary * 2 <= static_cast<uint64_t>(LONG_MAX) - mPeriodSize*mNumPeriods)
+  {
+    mBoundary *= 2;
+  }
+}
+
+bool IasAudioRingBufferReal::claimAccessFlags()
+{
+  bool expected = false;
+  if (mWriteInProgress.compare_exchange_strong(expected, true) == false)
+  {
+    return false;
+  }
+  for (uint32_t i = 0; i < cIasAudioRingBufferMaxReaders; i++)
+  {
+    expected = false;
+    if (mReaders[i].readInProgress.compare_exchange_strong(expected, true) == false)
+    {
+      while (i > 0)
+      {
+        i--;
+        mReaders[i].readInProgress.store(false, std::memory_order_release);
+      }
+      mWriteInProgress.store(false, std::memory_order_release);
+      return false;
+    }
+  }
+  return true;
+}
+
+void IasAudioRingBufferReal::releaseAccessFlags()
+{
+  for (uint32_t i = 0; i < cIasAudioRingBufferMaxReaders; i++)
+  {
+    mReaders[i].readInProgress.store(false, std::memory_order_release);
+  }
+  mWriteInProgress.store(false, std::memory_order_release);
+}
+
+IasAudioRingBufferResult IasAudioRingBufferReal::reconfigure(uint32_t periodSize, uint32_t nPeriods, uint32_t nChannels, void* dataBuf)
+{
+  if (periodSize == 0 || nPeriods == 0 || nChannels == 0 || dataBuf == nullptr)
+  {
+    return eIasRingBuffInvalidParam;
+  }
+  if (mInitialized == false)
+  {
+    return eIasRingBuffNotInitialized;
+  }
+  if (nChannels > mNumChannelsMax)
+  {
+    // The IasAudioRingBuffer instances hold the areas for the maximum number of channels
+    return eIasRingBuffInvalidParam;
+  }
+  if (mDoubleMapped == true)
+  {
+    // The planes of a double mapped buffer are mappings of their own, they cannot be resized here
+    return eIasRingBuffNotAllowed;
+  }
+  if (mSyncMode == eIasRingBuffSyncModeLockFree)
+  {
+    if (claimAccessFlags() == false)
+    {
+      return eIasRingBuffNotAllowed;
+    }
+  }
+  else
+  {
+    // Lock both mutexes, to ensure nobody is accessing the buffer right now
+    mMutexReadInProgress.lock();
+    mMutexWriteInProgress.lock();
+  }
+  {
+    IasLockGuard lock(&mMutex);
+    mPeriodSize = periodSize;
+    mNumPeriods = nPeriods;
+    mNumChannels = nChannels;
+    if (dataBuf != mDataBuf.get())
+    {
+      mRetiredDataBuf = mDataBuf;
+    }
+    mDataBuf = dataBuf;
+    if (mDataLayout == eIasLayoutNonInterleaved)
+    {
+      mPlanePadding = calculatePlanePadding(mNumPeriods*mPeriodSize*mSampleSize, mPlanePaddingOption);
+    }
+    mReadOffset = 0;
+    mWriteOffset = 0;
+    mBufferLevel = 0;
+    mHwPtrRead = 0;
+    mHwPtrWrite = 0;
+    mWriteCount.store(0, std::memory_order_relaxed);
+    mWriteReserve.store(0, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < cIasAudioRingBufferMaxReaders; i++)
+    {
+      mReaders[i].readCount.store(0, std::memory_order_relaxed);
+    }
+    initBoundary();
+    {
+      IasLockGuard groupLock(&mMutexChannelGroups);
+      mReadGroups = IasAudioRingBufferChannelGroups();
+      mWriteGroups = IasAudioRingBufferChannelGroups();
+    }
+    publishState(eIasRingBufferAccessUndef);
+    mGeneration.fetch_add(1, std::memory_order_release);
+  }
+  if (mSyncMode == eIasRingBuffSyncModeLockFree)
+  {
+    releaseAccessFlags();
+  }
+  else
+  {
+    mMutexWriteInProgress.unlock();
+    mMutexReadInProgress.unlock();
+  }
+  return eIasRingBuffOk;
+}
+
 void IasAudioRingBufferReal::zeroOut()
 {
-  // Lock both mutexes, to ensure nobody is accessing the buffer right now
-  mMutexReadInProgress.lock();
-  mMutexWriteInProgress.lock();
-  uint32_t sizeOfBufferInBytes = mNumPeriods*mPeriodSize*mNumChannels*mSampleSize;
+  if (mSyncMode == eIasRingBuffSyncModeLockFree)
+  {
+    // The lock-free accessors never take the mutexes, so claim their in-progress flags instead.
+    // Never wait for an access to finish, the content is simply left unchanged in this case.
+    if (claimAccessFlags() == false)
+    {
+      return;
+    }
+  }
+  else
+  {
+    // Lock both mutexes, to ensure nobody is accessing the buffer right now
+    mMutexReadInProgress.lock();
+    mMutexWriteInProgress.lock();
+  }
   IAS_ASSERT(getDataBuffer() != nullptr);
-  memset(getDataBuffer(), 0, sizeOfBufferInBytes);
-  mMutexWriteInProgress.unlock();
-  mMutexReadInProgress.unlock();
+  if (mDataLayout == eIasLayoutInterleaved)
+  {
+    memset(getDataBuffer(), 0, mNumPeriods*mPeriodSize*mNumChannels*mSampleSize);
+  }
+  else
+  {
+    uint32_t sizeOfPlaneInBytes = mNumPeriods*mPeriodSize*mSampleSize;
+    for (uint32_t channel = 0; channel < mNumChannels; channel++)
+    {
+      memset(static_cast<char*>(getDataBuffer()) + channel*getPlaneStride(), 0, sizeOfPlaneInBytes);
+    }
+  }
+  if (mSyncMode == eIasRingBuffSyncModeLockFree)
+  {
+    releaseAccessFlags();
+  }
+  else
+  {
+    mMutexWriteInProgress.unlock();
+    mMutexReadInProgress.unlock();
+  }
 }
 
 
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2018 Intel Corporation.All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file   IasAudioRingBufferRegistry.cpp
+ * @date   2018
+ * @brief  Shared directory of the shared memory segments of ring buffers and ring buffer pools.
+ */
+
+#include <cstring>
+#include <exception>
+
+#include "internal/audio/common/audiobuffer/IasAudioRingBufferRegistry.hpp"
+
+namespace IasAudio {
+
+static const std::string cHeaderName = "registryHeader";
+static const std::string cEntriesName = "registryEntries";
+
+/**
+ * @brief Find a named object of the registry, or allocate it if no other process did it before
+ */
+template <class T>
+static IasAudioCommonResult findOrAllocate(IasMemoryAllocator *mem, const std::string &name, uint32_t numberItems, T **array)
+{
+  uint32_t numItems = 0;
+  if (mem->find(name, &numItems, array) == eIasResultOk && numItems == numberItems)
+  {
+    return eIasResultOk;
+  }
+  try
+  {
+    mem->allocate<T>(name, numberItems, array);
+    return eIasResultOk;
+  }
+  catch (std::exception &)
+  {
+    // Another process has allocated it in the meantime
+  }
+  if (mem->find(name, &numItems, array) == eIasResultOk && numItems == numberItems)
+  {
+    return eIasResultOk;
+  }
+  return eIasResultMemoryError;
+}
+
+IasAudioRingBufferRegistry::IasAudioRingBufferRegistryEntry::IasAudioRingBufferRegistryEntry()
+  :type(eIasSegmentUnused)
+  ,generation(0)
+{
+  name[0] = '\0';
+}
+
+IasAudioRingBufferRegistry::IasAudioRingBufferRegistryHeader::IasAudioRingBufferRegistryHeader()
+  :generation(0)
+  ,mutex()
+{
+}
+
+IasAudioRingBufferRegistry::IasAudioRingBufferRegistry()
+  :mMemory(nullptr)
+  ,mHeader(nullptr)
+  ,mEntries(nullptr)
+{
+}
+
+IasAudioRingBufferRegistry::~IasAudioRingBufferRegistry()
+{
+  delete mMemory;
+}
+
+IasAudioCommonResult IasAudioRingBufferRegistry::init(const std::string &groupName)
+{
+  if (mMemory != nullptr)
+  {
+    return eIasResultAlreadyInitialized;
+  }
+  uint32_t size = static_cast<uint32_t>(sizeof(IasAudioRingBufferRegistryHeader) +
+                                        cIasAudioRingBufferRegistryMaxSegments * sizeof(IasAudioRingBufferRegistryEntry));
+  IasMemoryAllocator *mem = new IasMemoryAllocator(cIasAudioRingBufferRegistryName, size, true);
+  IAS_ASSERT(mem != nullptr);
+  IasAudioCommonResult res = mem->init(IasMemoryAllocator::eIasConnectOrCreate, nullptr);
+  if (res != eIasResultOk)
+  {
+    delete mem;
+    return res;
+  }
+  if (groupName.empty() == false)
+  {
+    // Only succeeds for the process that created the registry, the others find it already changed
+    (void)mem->changeGroup(groupName, nullptr);
+  }
+  if (findOrAllocate<IasAudioRingBufferRegistryHeader>(mem, cHeaderName, 1, &mHeader) != eIasResultOk ||
+      findOrAllocate<IasAudioRingBufferRegistryEntry>(mem, cEntriesName, cIasAudioRingBufferRegistryMaxSegments, &mEntries) != eIasResultOk)
+  {
+    delete mem;
+    mHeader = nullptr;
+    mEntries = nullptr;
+    return eIasResultMemoryError;
+  }
+  mMemory = mem;
+  return eIasResultOk;
+}
+
+IasAudioCommonResult IasAudioRingBufferRegistry::add(const std::string &name, IasSegmentType type, uint32_t *generation)
+{
+  if (mMemory == nullptr)
+  {
+    return eIasResultNotInitialized;
+  }
+  if (name.empty() == true || name.size() >= cIasAudioRingBufferRegistryMaxNameLength ||
+      type == eIasSegmentUnused || generation == nullptr)
+  {
+    return eIasResultInvalidParam;
+  }
+  IasLockGuard lock(&mHeader->mutex);
+  IasAudioRingBufferRegistryEntry *freeEntry = nullptr;
+  for (uint32_t index = 0; index < cIasAudioRingBufferRegistryMaxSegments; ++index)
+  {
+    IasAudioRingBufferRegistryEntry &entry = mEntries[index];
+    if (entry.type == eIasSegmentUnused)
+    {
+      if (freeEntry == nullptr)
+      {
+        freeEntry = &entry;
+      }
+    }
+    else if (std::strncmp(entry.name, name.c_str(), cIasAudioRingBufferRegistryMaxNameLength) == 0)
+    {
+      // The segment has been created again, e.g. after its creator terminated without removing it
+      freeEntry = &entry;
+      break;
+    }
+  }
+  if (freeEntry == nullptr)
+  {
+    return eIasResultMemoryError;
+  }
+  std::strncpy(freeEntry->name, name.c_str(), cIasAudioRingBufferRegistryMaxNameLength - 1);
+  freeEntry->name[cIasAudioRingBufferRegistryMaxNameLength - 1] = '\0';
+  freeEntry->type = type;
+  freeEntry->generation = ++mHeader->generation;
+  *generation = freeEntry->generation;
+  return eIasResultOk;
+}
+
+IasAudioCommonResult IasAudioRingBufferRegistry::remove(const std::string &name, uint32_t generation)
+{
+  if (mMemory == nullptr)
+  {
+    return eIasResultNotInitialized;
+  }
+  IasLockGuard lock(&mHeader->mutex);
+  for (uint32_t index = 0; index < cIasAudioRingBufferRegistryMaxSegments; ++index)
+  {
+    IasAudioRingBufferRegistryEntry &entry = mEntries[index];
+    if (entry.type != eIasSegmentUnused && entry.generation == generation &&
+        std::strncmp(entry.name, name.c_str(), cIasAudioRingBufferRegistryMaxNameLength) == 0)
+    {
+      entry.type = eIasSegmentUnused;
+      entry.name[0] = '\0';
+      return eIasResultOk;
+    }
+  }
+  return eIasResultObjectNotFound;
+}
+
+void IasAudioRingBufferRegistry::getSegments(std::vector<IasSegment> *segments) const
+{
+  IAS_ASSERT(segments != nullptr);
+  segments->clear();
+  if (mMemory == nullptr)
+  {
+    return;
+  }
+  IasLockGuard lock(&mHeader->mutex);
+  for (uint32_t index = 0; index < cIasAudioRingBufferRegistryMaxSegments; ++index)
+  {
+    const IasAudioRingBufferRegistryEntry &entry = mEntries[index];
+    if (entry.type != eIasSegmentUnused)
+    {
+      IasSegment segment;
+      segment.name = entry.name;
+      segment.type = static_cast<IasSegmentType>(entry.type);
+      segment.generation = entry.generation;
+      segments->push_back(segment);
+    }
+  }
+}
+
+} // namespace IasAudio
@@ -31,6 +31,7 @@ __attribute__ ((visibility ("default"))) std::string toString(const IasAudioRing
     STRING_RETURN_CASE(eIasRingBuffTimeOut);
     STRING_RETURN_CASE(eIasRingBuffProbeError);
     STRING_RETURN_CASE(eIasRingBuffCondWaitFailed);
+    STRING_RETURN_CASE(eIasRingBuffDataOverwritten);
     DEFAULT_STRING("Unknown Error");
   }
 }
@@ -28,6 +28,36 @@ __attribute__ ((visibility ("default"))) std::string toString(const IasAudioRing
   }
 }
 
+__attribute__ ((visibility ("default"))) std::string toString(const IasAudioRingBufferSyncMode&  type)
+{
+  switch(type)
+  {
+    STRING_RETURN_CASE(eIasRingBuffSyncModeMutex);
+    STRING_RETURN_CASE(eIasRingBuffSyncModeLockFree);
+    DEFAULT_STRING("Unknown Error");
+  }
+}
+
+__attribute__ ((visibility ("default"))) std::string toString(const IasAudioRingBufferClockSource&  type)
+{
+  switch(type)
+  {
+    STRING_RETURN_CASE(eIasRingBuffClockMonotonic);
+    STRING_RETURN_CASE(eIasRingBuffClockTsc);
+    DEFAULT_STRING("Unknown Error");
+  }
+}
+
+__attribute__ ((visibility ("default"))) std::string toString(const IasAudioRingBufferOverrunMode&  type)
+{
+  switch(type)
+  {
+    STRING_RETURN_CASE(eIasRingBuffOverrunClamp);
+    STRING_RETURN_CASE(eIasRingBuffOverrunOverwrite);
+    DEFAULT_STRING("Unknown Error");
+  }
+}
+
 #undef STRING_RETURN_CASE
 #undef DEFAULT_STRING
 }
@@ -10,7 +10,12 @@
  */
 
 #include <sys/types.h>
+#include <sys/mman.h>
 #include <grp.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <exception>
 #include <boost/system/error_code.hpp>
@@ -28,6 +33,44 @@ namespace IasAudio {
 #endif
 const std::string cShmRoot = SHM_ROOT_PATH;
 
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif
+
+/**
+ * @brief Check whether the kernel backs any mapping of the given address range with huge pages
+ *
+ * madvise(MADV_HUGEPAGE) succeeds also for mappings that never get huge pages, so the
+ * huge page counters of all mappings overlapping the range are read from /proc/self/smaps.
+ */
+static bool hasHugePages(uintptr_t begin, uintptr_t end)
+{
+  std::ifstream smaps("/proc/self/smaps");
+  std::string line;
+  bool overlapping = false;
+  while (std::getline(smaps, line))
+  {
+    unsigned long vmaBegin = 0;
+    unsigned long vmaEnd = 0;
+    unsigned long kiloBytes = 0;
+    char key[32];
+    if (sscanf(line.c_str(), "%lx-%lx ", &vmaBegin, &vmaEnd) == 2)
+    {
+      // The header line of the next mapping
+      overlapping = (vmaBegin < end) && (vmaEnd > begin);
+    }
+    else if ((overlapping == true) && (sscanf(line.c_str(), "%31[^:]: %lu kB", key, &kiloBytes) == 2) && (kiloBytes > 0))
+    {
+      const std::string name(key);
+      if (name == "AnonHugePages" || name == "ShmemPmdMapped" || name == "FilePmdMapped")
+      {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
 IasMemoryAllocator::IasMemoryAllocator(const std::string &name, uint32_t totalMemorySize, bool shared)
   :mInitialized(false)
   ,mName(name)
@@ -37,6 +80,7 @@ IasMemoryAllocator::IasMemoryAllocator(const std::string &name, uint32_t totalMe
   ,mManaged_shm(NULL)
   ,mManaged_heap(NULL)
   ,mOpenFlag(eIasConnect)
+  ,mMemoryReport()
 {
   //Nothing to do here
 }
@@ -45,6 +89,13 @@ IasMemoryAllocator::~IasMemoryAllocator()
 {
   if (mInitialized == true)
   {
+    if (mMemoryReport.locked == true)
+    {
+      // The heap memory might be given back to the process heap, so it has to be unlocked explicitly
+      void *address = (mShared == true) ? mManaged_shm->get_address() : mManaged_heap->get_address();
+      size_t size   = (mShared == true) ? mManaged_shm->get_size() : mManaged_heap->get_size();
+      munlock(address, size);
+    }
     if (mShared == true && mOpenFlag == eIasCreate)
     {
       shared_memory_object::remove(mFullName.c_str());
@@ -59,6 +110,83 @@ IasAudioCommonResult IasMemoryAllocator::init(IasOpenFlag flag)
   return init(flag, nullptr);
 }
 
+IasAudioCommonResult IasMemoryAllocator::init(IasOpenFlag flag, const IasMemoryOptions &options, std::string *errorMsg)
+{
+  if (mInitialized == true)
+  {
+    return eIasResultOk;
+  }
+  IasAudioCommonResult result = init(flag, errorMsg);
+  if (result != eIasResultOk)
+  {
+    return result;
+  }
+  if (mShared == true)
+  {
+    applyMemoryOptions(mManaged_shm->get_address(), mManaged_shm->get_size(), options, &mMemoryReport);
+  }
+  else
+  {
+    applyMemoryOptions(mManaged_heap->get_address(), mManaged_heap->get_size(), options, &mMemoryReport);
+  }
+  return eIasResultOk;
+}
+
+void IasMemoryAllocator::applyMemoryOptions(void *address, size_t size, const IasMemoryOptions &options, IasMemoryReport *report)
+{
+  IAS_ASSERT(report != nullptr);
+  *report = IasMemoryReport();
+  if (address == nullptr || size == 0)
+  {
+    return;
+  }
+  // madvise and mlock work on whole pages
+  const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  const uintptr_t begin = reinterpret_cast<uintptr_t>(address) & ~(pageSize - 1);
+  const uintptr_t end = (reinterpret_cast<uintptr_t>(address) + size + pageSize - 1) & ~(pageSize - 1);
+  char *start = reinterpret_cast<char*>(begin);
+  const size_t length = static_cast<size_t>(end - begin);
+  report->size = length;
+
+  if (options.hugePages != eIasHugePagesNone)
+  {
+    // This has to be done before the pages are faulted in
+    if (madvise(start, length, MADV_HUGEPAGE) == 0)
+    {
+      report->hugePagesRequested = true;
+    }
+  }
+  if (options.prefault == true)
+  {
+    if (madvise(start, length, MADV_POPULATE_WRITE) != 0)
+    {
+      // Older kernels: write to each page without changing its content. The memory might be
+      // used by another process already, so an atomic read-modify-write is required.
+      for (size_t offset = 0; offset < length; offset += pageSize)
+      {
+        __atomic_fetch_or(start + offset, 0, __ATOMIC_RELAXED);
+      }
+    }
+    report->prefaulted = true;
+  }
+  if (options.lock == true)
+  {
+    if (mlock(start, length) == 0)
+    {
+      report->locked = true;
+    }
+    else
+    {
+      report->lockError = errno;
+    }
+  }
+  // The huge pages are allocated when the pages are faulted in, so check them at the end
+  if (report->hugePagesRequested == true && hasHugePages(begin, end) == true)
+  {
+    report->hugePages = eIasHugePagesTransparent;
+  }
+}
+
 IasAudioCommonResult IasMemoryAllocator::init(IasOpenFlag flag, std::string *errorMsg)
 {
   if (mInitialized == false)
@@ -111,6 +239,25 @@ IasAudioCommonResult IasMemoryAllocator::init(IasOpenFlag flag, std::string *err
           return eIasResultMemoryError;
         }
       }
+      else if (flag == eIasConnectOrCreate)
+      {
+        // Several processes may race for the creation, so the memory is neither removed before nor by the destructor
+        managed_shared_memory::size_type totalSize = mTotalMemorySize + pageSize;
+        try
+        {
+          mManaged_shm = new managed_shared_memory(open_or_create, mFullName.c_str(), totalSize, nullptr,
+                                                   boost::interprocess::permissions(S_IRUSR|S_IWUSR|S_IRGRP|S_IWGRP));
+        }
+        catch(std::exception &e)
+        {
+          if (errorMsg != nullptr)
+          {
+            errorMsg->append("Error allocating managed_shared_memory: ");
+            errorMsg->append(e.what());
+          }
+          return eIasResultMemoryError;
+        }
+      }
       else
       {
         std::string absPath = cShmRoot + mFullName;
@@ -61,6 +61,16 @@ __attribute__ ((visibility ("default"))) std::string toString ( const IasAudioCo
   }
 }
 
+__attribute__ ((visibility ("default"))) std::string toString ( const IasHugePageMode& type )
+{
+  switch(type)
+  {
+    STRING_RETURN_CASE(eIasHugePagesNone);
+    STRING_RETURN_CASE(eIasHugePagesTransparent);
+    DEFAULT_STRING("eIasHugePagesInvalid");
+  }
+}
+
 __attribute__ ((visibility ("default"))) std::string toString ( const IasAudioCommonAccess& type)
 {
   switch(type)
@@ -172,6 +182,7 @@ __attribute__ ((visibility ("default"))) std::string toString ( const IasRingbuf
     STRING_RETURN_CASE(eIasRingBufferShared);
     STRING_RETURN_CASE(eIasRingBufferLocalMirror);
     STRING_RETURN_CASE(eIasRingBufferLocalReal);
+    STRING_RETURN_CASE(eIasRingBufferLocalDoubleMapped);
     STRING_RETURN_CASE(eIasRingBufferUndef);
     DEFAULT_STRING("eIasRingBufferInvalid");
   }
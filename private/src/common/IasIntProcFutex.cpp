@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2018 Intel Corporation.All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file   IasIntProcFutex.cpp
+ * @date   2018
+ * @brief
+ */
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <climits>
+#include <cerrno>
+#include <ctime>
+#include "internal/audio/common/IasIntProcFutex.hpp"
+
+namespace IasAudio {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "std::atomic<uint32_t> can't be used as futex word");
+
+/*
+ * The futex lives in shared memory and is used by several processes, so the
+ * FUTEX_PRIVATE_FLAG must not be used here.
+ */
+static long futex(std::atomic<uint32_t> *uaddr, int32_t op, uint32_t val, const struct timespec *timeout)
+{
+  return syscall(SYS_futex, reinterpret_cast<uint32_t*>(uaddr), op, val, timeout, nullptr, 0);
+}
+
+IasIntProcFutex::IasIntProcFutex()
+  :mSequence(0)
+  ,mThreshold(0)
+  ,mNumWaiters(0)
+  ,mNativeResult(0)
+{
+}
+
+IasIntProcFutex::~IasIntProcFutex()
+{
+}
+
+void IasIntProcFutex::registerWaiter(uint32_t threshold)
+{
+  mThreshold.store(threshold);
+  mNumWaiters.fetch_add(1);
+}
+
+void IasIntProcFutex::unregisterWaiter()
+{
+  mNumWaiters.fetch_sub(1);
+}
+
+IasIntProcFutex::IasResult IasIntProcFutex::wait(uint32_t sequence, uint64_t time_ms)
+{
+  struct timespec timespecValue;
+  timespecValue.tv_sec = static_cast<time_t>(time_ms / 1000);
+  timespecValue.tv_nsec = static_cast<long>((time_ms % 1000) * 1000000);
+
+  const long result = futex(&mSequence, FUTEX_WAIT, sequence, &timespecValue);
+  if (result == 0)
+  {
+    mNativeResult = 0;
+    return eIasOk;
+  }
+  const int32_t nativeResult = errno;
+  mNativeResult = nativeResult;
+  if (nativeResult == ETIMEDOUT)
+  {
+    return eIasTimeout;
+  }
+  else if (nativeResult == EAGAIN || nativeResult == EINTR)
+  {
+    // The sequence was already changed or we were interrupted, the caller has to check its condition again
+    return eIasOk;
+  }
+  else
+  {
+    return eIasFutexWaitFailed;
+  }
+}
+
+IasIntProcFutex::IasResult IasIntProcFutex::wake(uint32_t available)
+{
+  // The caller has updated the fill level before. This fence makes sure that the update is
+  // visible before the waiter count is checked, see registerWaiter.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (mNumWaiters.load() == 0 || available < mThreshold.load())
+  {
+    return eIasOk;
+  }
+  mSequence.fetch_add(1);
+  if (futex(&mSequence, FUTEX_WAKE, INT_MAX, nullptr) < 0)
+  {
+    mNativeResult = errno;
+    return eIasFutexWakeFailed;
+  }
+  return eIasOk;
+}
+
+#define STRING_RETURN_CASE(name) case name: return std::string(#name); break
+#define DEFAULT_STRING(name) default: return std::string(name)
+
+__attribute__ ((visibility ("default"))) std::string toString(const IasIntProcFutex::IasResult& type)
+{
+  switch(type)
+  {
+    STRING_RETURN_CASE(IasIntProcFutex::eIasOk);
+    STRING_RETURN_CASE(IasIntProcFutex::eIasTimeout);
+    STRING_RETURN_CASE(IasIntProcFutex::eIasFutexWaitFailed);
+    STRING_RETURN_CASE(IasIntProcFutex::eIasFutexWakeFailed);
+    DEFAULT_STRING("Invalid IasIntProcFutex::IasResult => " + std::to_string(type));
+  }
+}
+
+
+} /* namespace IasAudio */
@@ -14,9 +14,11 @@
 
 #include "audio/common/IasAudioCommonTypes.hpp"
 #include "internal/audio/common/helper/IasCopyAudioAreaBuffers.hpp"
+#include "internal/audio/common/helper/IasCpuFeatures.hpp"
 
 #include <xmmintrin.h>
 #include <emmintrin.h>
+#include <immintrin.h>
 
 namespace IasAudio {
 
@@ -310,6 +312,96 @@ static void copyChannelFloat32toFloat32(uint8_t *destinPtr, uint32_t destinStep,
 }
 
 
+/*
+ * AVX2 variants of the format conversions for non-interleaved buffers, i.e., the samples of one channel
+ * are contiguous. They are selected at runtime if the CPU supports AVX2 (see getSimdLevel()). Each of them
+ * converts blocks of 8 samples and leaves the remaining samples and the zero padding to the scalar variant,
+ * which produces the same results.
+ */
+
+__attribute__ ((target ("avx2")))
+static void copyNonInterleavedChannelInt16toFloat32Avx2(uint8_t *destinPtr, uint32_t destinStep, uint32_t destinNumSamples,
+                                                        uint8_t *sourcePtr, uint32_t sourceStep, uint32_t sourceNumSamples)
+{
+  float   * __restrict destinSample = (float*)destinPtr;
+  int16_t * __restrict sourceSample = (int16_t*)sourcePtr;
+  uint32_t numVectorSamples = std::min(destinNumSamples, sourceNumSamples) & ~7u;
+  const __m256 factor = _mm256_set1_ps(cFactorInt16toFloat32);
+  for (uint32_t cntSamples = 0; cntSamples < numVectorSamples; cntSamples+=8)
+  {
+    __m256i a = _mm256_cvtepi16_epi32(_mm_loadu_si128((__m128i const*)(sourceSample + cntSamples)));
+    _mm256_storeu_ps(destinSample + cntSamples, _mm256_mul_ps(_mm256_cvtepi32_ps(a), factor));
+  }
+  copyChannelInt16toFloat32((uint8_t*)(destinSample + numVectorSamples), destinStep, destinNumSamples - numVectorSamples,
+                            (uint8_t*)(sourceSample + numVectorSamples), sourceStep, sourceNumSamples - numVectorSamples);
+}
+
+
+__attribute__ ((target ("avx2")))
+static void copyNonInterleavedChannelInt32toFloat32Avx2(uint8_t *destinPtr, uint32_t destinStep, uint32_t destinNumSamples,
+                                                        uint8_t *sourcePtr, uint32_t sourceStep, uint32_t sourceNumSamples)
+{
+  float   * __restrict destinSample = (float*)destinPtr;
+  int32_t * __restrict sourceSample = (int32_t*)sourcePtr;
+  uint32_t numVectorSamples = std::min(destinNumSamples, sourceNumSamples) & ~7u;
+  const __m256 factor = _mm256_set1_ps(cFactorInt32toFloat32);
+  for (uint32_t cntSamples = 0; cntSamples < numVectorSamples; cntSamples+=8)
+  {
+    __m256i a = _mm256_loadu_si256((__m256i const*)(sourceSample + cntSamples));
+    _mm256_storeu_ps(destinSample + cntSamples, _mm256_mul_ps(_mm256_cvtepi32_ps(a), factor));
+  }
+  copyChannelInt32toFloat32((uint8_t*)(destinSample + numVectorSamples), destinStep, destinNumSamples - numVectorSamples,
+                            (uint8_t*)(sourceSample + numVectorSamples), sourceStep, sourceNumSamples - numVectorSamples);
+}
+
+
+__attribute__ ((target ("avx2")))
+static void copyNonInterleavedChannelFloat32toInt16Avx2(uint8_t *destinPtr, uint32_t destinStep, uint32_t destinNumSamples,
+                                                        uint8_t *sourcePtr, uint32_t sourceStep, uint32_t sourceNumSamples)
+{
+  int16_t * __restrict destinSample = (int16_t*)destinPtr;
+  float   * __restrict sourceSample = (float*)sourcePtr;
+  uint32_t numVectorSamples = std::min(destinNumSamples, sourceNumSamples) & ~7u;
+  const __m256 factor = _mm256_set1_ps(cFactorFloat32toInt16);
+  for (uint32_t cntSamples = 0; cntSamples < numVectorSamples; cntSamples+=8)
+  {
+    __m256  a = _mm256_mul_ps(_mm256_loadu_ps(sourceSample + cntSamples), factor); // multiply with 32768.0f
+    __m256i b = _mm256_cvtps_epi32(a);                                               // convert according to rounding mode
+    __m128i c = _mm_packs_epi32(_mm256_castsi256_si128(b), _mm256_extracti128_si256(b, 1)); // Int32 to Int16 with saturation
+    _mm_storeu_si128((__m128i*)(destinSample + cntSamples), c);
+  }
+  copyChannelFloat32toInt16((uint8_t*)(destinSample + numVectorSamples), destinStep, destinNumSamples - numVectorSamples,
+                            (uint8_t*)(sourceSample + numVectorSamples), sourceStep, sourceNumSamples - numVectorSamples);
+}
+
+
+__attribute__ ((target ("avx2")))
+static void copyNonInterleavedChannelFloat32toInt32Avx2(uint8_t *destinPtr, uint32_t destinStep, uint32_t destinNumSamples,
+                                                        uint8_t *sourcePtr, uint32_t sourceStep, uint32_t sourceNumSamples)
+{
+  int32_t * __restrict destinSample = (int32_t*)destinPtr;
+  float   * __restrict sourceSample = (float*)sourcePtr;
+  uint32_t numVectorSamples = std::min(destinNumSamples, sourceNumSamples) & ~7u;
+  const __m256  factor   = _mm256_set1_ps(cFactorFloat32toInt32);
+  const __m256  half     = _mm256_set1_ps(0.5f);
+  const __m256  plusOne  = _mm256_set1_ps(1.0f);
+  const __m256  minusOne = _mm256_set1_ps(-1.0f);
+  const __m256i int32Max = _mm256_set1_epi32(cInt32Max);
+  const __m256i int32Min = _mm256_set1_epi32(cInt32Min);
+  for (uint32_t cntSamples = 0; cntSamples < numVectorSamples; cntSamples+=8)
+  {
+    __m256  a = _mm256_loadu_ps(sourceSample + cntSamples);
+    __m256i b = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(a, factor), half));
+    // Saturate the samples outside of [-1, 1], like the scalar variant
+    b = _mm256_blendv_epi8(b, int32Max, _mm256_castps_si256(_mm256_cmp_ps(a, plusOne, _CMP_GT_OQ)));
+    b = _mm256_blendv_epi8(b, int32Min, _mm256_castps_si256(_mm256_cmp_ps(a, minusOne, _CMP_LT_OQ)));
+    _mm256_storeu_si256((__m256i*)(destinSample + cntSamples), b);
+  }
+  copyChannelFloat32toInt32((uint8_t*)(destinSample + numVectorSamples), destinStep, destinNumSamples - numVectorSamples,
+                            (uint8_t*)(sourceSample + numVectorSamples), sourceStep, sourceNumSamples - numVectorSamples);
+}
+
+
 /**
  * @brief Public fuction to copy between two audio (ring) buffers, which are desribed
  *        by IasAudioArea structs.
@@ -335,6 +427,9 @@ void copyAudioAreaBuffers(IasAudioArea const       *destinAreas,
   bool isNonInterleaved = ((static_cast<int32_t>(destinAreas[0].step) == 8 * toSize(destinFormat)) &&
                                 (static_cast<int32_t>(sourceAreas[0].step) == 8 * toSize(sourceFormat)));
 
+  // The AVX2 variants require contiguous samples, so they are used only for non-interleaved buffers.
+  bool useAvx2 = isNonInterleaved && (getSimdLevel() >= eIasSimdAvx2);
+
   void (*copyFunction)(uint8_t*, uint32_t, uint32_t, uint8_t*, uint32_t, uint32_t);
   copyFunction = nullptr;
 
@@ -352,7 +447,7 @@ void copyAudioAreaBuffers(IasAudioArea const       *destinAreas,
           copyFunction = copyChannelInt16toInt32;
           break;
         case eIasFormatFloat32:
-          copyFunction = copyChannelInt16toFloat32;
+          copyFunction = useAvx2 ? copyNonInterleavedChannelInt16toFloat32Avx2 : copyChannelInt16toFloat32;
           break;
         default:
           IAS_ASSERT(0); // format is not supported
@@ -369,7 +464,7 @@ void copyAudioAreaBuffers(IasAudioArea const       *destinAreas,
           copyFunction = isNonInterleaved ? copyNonInterleavedChannel32bit : copyChannelInt32toInt32;
           break;
         case eIasFormatFloat32:
-          copyFunction = copyChannelInt32toFloat32;
+          copyFunction = useAvx2 ? copyNonInterleavedChannelInt32toFloat32Avx2 : copyChannelInt32toFloat32;
           break;
         default:
           IAS_ASSERT(0); // format is not supported
@@ -380,10 +475,10 @@ void copyAudioAreaBuffers(IasAudioArea const       *destinAreas,
       switch (destinFormat)
       {
         case eIasFormatInt16:
-          copyFunction = copyChannelFloat32toInt16;
+          copyFunction = useAvx2 ? copyNonInterleavedChannelFloat32toInt16Avx2 : copyChannelFloat32toInt16;
           break;
         case eIasFormatInt32:
-          copyFunction = copyChannelFloat32toInt32;
+          copyFunction = useAvx2 ? copyNonInterleavedChannelFloat32toInt32Avx2 : copyChannelFloat32toInt32;
           break;
         case eIasFormatFloat32:
           copyFunction = isNonInterleaved ? copyNonInterleavedChannel32bit : copyChannelFloat32toFloat32;
@@ -482,4 +577,74 @@ void zeroAudioAreaBuffers(IasAudioArea const       *destinAreas,
 }
 
 
+// Crossfade one channel, the gain of the destination sample rises linearly from 0 to 1 over fadeLength frames.
+template <typename T>
+static void crossfadeChannel(uint8_t *destinPtr, uint32_t destinStep, uint8_t *fadeOutPtr, uint32_t fadeOutStep,
+                             uint32_t numSamples, uint32_t fadePosition, uint32_t fadeLength)
+{
+  T * __restrict destinSample  = (T*)destinPtr;
+  T * __restrict fadeOutSample = (T*)fadeOutPtr;
+  // Calculate in double precision, so that 32 bit integer samples cannot overflow
+  const double gainStep = 1.0 / static_cast<double>(fadeLength + 1);
+  destinStep  = destinStep / static_cast<uint32_t>(sizeof(T));
+  fadeOutStep = fadeOutStep / static_cast<uint32_t>(sizeof(T));
+  for (uint32_t cntSamples = 0; cntSamples < numSamples; cntSamples++)
+  {
+    const double gain = static_cast<double>(fadePosition + cntSamples + 1) * gainStep;
+    *destinSample = static_cast<T>(static_cast<double>(*fadeOutSample) * (1.0 - gain) + static_cast<double>(*destinSample) * gain);
+    destinSample  += destinStep;
+    fadeOutSample += fadeOutStep;
+  }
+}
+
+/**
+ * @brief Public fuction to crossfade between two parts of audio (ring) buffers, which are desribed
+ *        by IasAudioArea structs.
+ */
+void crossfadeAudioAreaBuffers(IasAudioArea const       *destinAreas,
+                               IasAudioCommonDataFormat  format,
+                               uint32_t               destinOffset,
+                               uint32_t               numChannels,
+                               uint32_t               chanIdx,
+                               uint32_t               numFrames,
+                               IasAudioArea const       *fadeOutAreas,
+                               uint32_t               fadeOutOffset,
+                               uint32_t               fadePosition,
+                               uint32_t               fadeLength)
+{
+  IAS_ASSERT(destinAreas != nullptr);
+  IAS_ASSERT(fadeOutAreas != nullptr);
+  IAS_ASSERT((numChannels+chanIdx) <= destinAreas[0].maxIndex + 1);
+  IAS_ASSERT((numChannels+chanIdx) <= fadeOutAreas[0].maxIndex + 1);
+
+  for (uint32_t cntChannels = 0; cntChannels < numChannels; cntChannels++)
+  {
+    IAS_ASSERT(destinAreas[cntChannels+chanIdx].start != nullptr);
+    IAS_ASSERT(fadeOutAreas[cntChannels+chanIdx].start != nullptr);
+
+    uint32_t  fadeOutStep  = fadeOutAreas[cntChannels+chanIdx].step >> 3; // step size expressed in bytes
+    uint8_t  *fadeOutPtr   = ((uint8_t*)fadeOutAreas[cntChannels+chanIdx].start) + (fadeOutAreas[cntChannels+chanIdx].first >> 3) + fadeOutOffset * fadeOutStep;
+
+    uint32_t  destinStep   = destinAreas[cntChannels+chanIdx].step >> 3; // step size expressed in bytes
+    uint8_t  *destinPtr    = ((uint8_t*)destinAreas[cntChannels+chanIdx].start) + (destinAreas[cntChannels+chanIdx].first >> 3) + destinOffset * destinStep;
+
+    switch (format)
+    {
+      case eIasFormatInt16:
+        crossfadeChannel<int16_t>(destinPtr, destinStep, fadeOutPtr, fadeOutStep, numFrames, fadePosition, fadeLength);
+        break;
+      case eIasFormatInt32:
+        crossfadeChannel<int32_t>(destinPtr, destinStep, fadeOutPtr, fadeOutStep, numFrames, fadePosition, fadeLength);
+        break;
+      case eIasFormatFloat32:
+        crossfadeChannel<float>(destinPtr, destinStep, fadeOutPtr, fadeOutStep, numFrames, fadePosition, fadeLength);
+        break;
+      default:
+        IAS_ASSERT(0); // format is not supported
+        break;
+    }
+  }
+}
+
+
 } //namespace IasAudio
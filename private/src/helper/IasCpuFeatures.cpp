@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2018 Intel Corporation.All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file   IasCpuFeatures.cpp
+ * @date   2018
+ * @brief  Runtime detection of the SIMD instruction sets, used to select the optimized kernels.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal/audio/common/helper/IasCpuFeatures.hpp"
+#include "internal/audio/common/IasAudioLogging.hpp"
+
+namespace IasAudio {
+
+static const std::string cClassName = "IasCpuFeatures::";
+#define LOG_PREFIX cClassName + __func__ + "(" + std::to_string(__LINE__) + "):"
+
+/*
+ * Name of the environment variable to limit the SIMD level, e.g. IAS_AUDIO_SIMD=sse2
+ */
+static const char cSimdEnvironmentVariable[] = "IAS_AUDIO_SIMD";
+
+IasSimdLevel detectSimdLevel()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  // __builtin_cpu_supports also verifies via xgetbv that the OS saves the AVX registers
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+  {
+    return eIasSimdAvx2;
+  }
+#endif
+  // The library itself is built for SSE2, so it does not run on a CPU without it
+  return eIasSimdSse2;
+}
+
+static IasSimdLevel selectSimdLevel()
+{
+  IasSimdLevel level = detectSimdLevel();
+  const char *requested = getenv(cSimdEnvironmentVariable);
+  if (requested != nullptr)
+  {
+    // The environment can only lower the level, the kernels must never run on a CPU that lacks them
+    if (strcmp(requested, "sse2") == 0)
+    {
+      level = eIasSimdSse2;
+    }
+    else if (strcmp(requested, "avx2") != 0 || level < eIasSimdAvx2)
+    {
+      // Make a forced level that did not take effect visible, e.g. for a misspelled value
+      DltContext *logCtx = IasAudioLogging::registerDltContext("CPU", "CPU Features");
+      DLT_LOG_CXX(*logCtx, DLT_LOG_WARN, LOG_PREFIX, "Ignoring", cSimdEnvironmentVariable, "=", requested,
+                  ", using", toString(level));
+    }
+  }
+  return level;
+}
+
+IasSimdLevel getSimdLevel()
+{
+  static const IasSimdLevel level = selectSimdLevel();
+  return level;
+}
+
+#define STRING_RETURN_CASE(name) case name: return std::string(#name); break
+#define DEFAULT_STRING(name) default: return std::string(name)
+
+std::string toString(const IasSimdLevel& type)
+{
+  switch(type)
+  {
+    STRING_RETURN_CASE(eIasSimdSse2);
+    STRING_RETURN_CASE(eIasSimdAvx2);
+    DEFAULT_STRING("Invalid IasSimdLevel => " + std::to_string(type));
+  }
+}
+
+#undef STRING_RETURN_CASE
+#undef DEFAULT_STRING
+
+} //namespace IasAudio
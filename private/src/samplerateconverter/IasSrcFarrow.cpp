@@ -9,6 +9,7 @@
  * @date    2015
  */
 
+#include <algorithm>
 #include <cmath>                                  // declare fabsf()
 #include <stdio.h>
 #include <stdlib.h>
@@ -23,6 +24,8 @@
 #if IASSRCFARROWCONFIG_USE_SSE
 #include <xmmintrin.h>
 #include <emmintrin.h>
+#include <immintrin.h>
+#include "internal/audio/common/helper/IasCpuFeatures.hpp"
 #endif
 
 #ifdef __linux__
@@ -191,6 +194,29 @@ inline uint32_t incrementBufferIndex(uint32_t currentIndex, uint32_t bufferLengt
 }
 
 
+/**
+ * @brief Check whether a t value is a multiple of 1/numSteps, i.e. whether it
+ *        lies on the grid of the phases of an exact conversion ratio.
+ *
+ * The tolerance covers the round-off errors of a float t value.
+ *
+ * @returns                  True if the value lies on the grid.
+ * @param[in]  value         The t value.
+ * @param[in]  numSteps      The number of grid steps per unit.
+ * @param[out] numerator     The value in units of 1/numSteps.
+ */
+inline bool isOnPhaseGrid(double value, uint32_t numSteps, uint32_t *numerator)
+{
+  double scaledValue = value * static_cast<double>(numSteps);
+  if (!((scaledValue >= 0.0) && (scaledValue < 65536.0)))
+  {
+    return false;
+  }
+  *numerator = static_cast<uint32_t>(scaledValue + 0.5);
+  return fabs(scaledValue - static_cast<double>(*numerator)) < 1e-4;
+}
+
+
 /**
  * @brief Calculate the number of free samples within the ring buffer.
  *
@@ -264,8 +290,11 @@ IasSrcFarrow::IasSrcFarrow()
   ,mRingBufferIndex(0)
   ,mFilterLength(0)
   ,mNumFilters(0)
+  ,mNumPhases(0)
+  ,mPhaseStep(0)
   ,mIsInitialized(false)
   ,mTimeVarImpResp(NULL)
+  ,mPhaseImpResp(NULL)
   ,mFirFilterMultiChan(NULL)
   ,mUpdateImpulseResponseFunction(NULL)
 {
@@ -306,15 +335,17 @@ IasSrcFarrow::IasResult IasSrcFarrow::init(uint32_t  maxNumChannels)
   }
 
   // Allocate the buffer with the time-variant impulse response.
+  // The SSE variant calculates the time-variant impulse responses of a whole block in advance.
+  // Behind them, it keeps the impulse responses of the phases of an exact conversion ratio.
 #if MS_VC
 #if IASSRCFARROWCONFIG_USE_SSE
-  mTimeVarImpResp = (float*) _aligned_malloc((cMaxFilterLength+4)*sizeof(float), 16);
+  mTimeVarImpResp = (float*) _aligned_malloc((cBlockLength+cMaxNumPhases+1)*cTimeVarImpRespStride*sizeof(float), 32);
 #else
   mTimeVarImpResp = (float*) _aligned_malloc(cMaxFilterLength*sizeof(float), 16);
 #endif // #if IASSRCFARROWCONFIG_USE_SSE
 #else
 #if IASSRCFARROWCONFIG_USE_SSE
-  mTimeVarImpResp = (float*) memalign(16, (cMaxFilterLength+4)*sizeof(float));
+  mTimeVarImpResp = (float*) memalign(32, (cBlockLength+cMaxNumPhases+1)*cTimeVarImpRespStride*sizeof(float));
 #else
   mTimeVarImpResp = (float*) memalign(16, cMaxFilterLength*sizeof(float));
 #endif
@@ -324,6 +355,9 @@ IasSrcFarrow::IasResult IasSrcFarrow::init(uint32_t  maxNumChannels)
   {
     return eIasInitFailed;
   }
+#if IASSRCFARROWCONFIG_USE_SSE
+  mPhaseImpResp = &mTimeVarImpResp[cBlockLength*cTimeVarImpRespStride];
+#endif
 
   // Create the multi-channel FIR filter object.
   mFirFilterMultiChan = new IasSrcFarrowFirFilter();
@@ -332,7 +366,7 @@ IasSrcFarrow::IasResult IasSrcFarrow::init(uint32_t  maxNumChannels)
     return eIasInitFailed;
   }
 
-  mFirFilterMultiChan->init(cMaxFilterLength, 1, maxNumChannels);
+  mFirFilterMultiChan->init(cMaxFilterLength, 1, maxNumChannels, cBlockLength);
 
   mMaxNumChannels = maxNumChannels;
   mIsInitialized  = true;
@@ -439,6 +473,18 @@ IasSrcFarrow::IasResult IasSrcFarrow::setConversionRatio(uint32_t inputRate,
   IAS_ASSERT(filterParams.filterLength <= cMaxFilterLength);
   IAS_ASSERT(filterParams.numFilters   <= cMaxNumFilters);
 
+  // Reduce the conversion ratio. If the denominator is small, the t values of the output
+  // samples only take the values k/numPhases, k = 0..numPhases.
+  uint32_t gcd = inputRate;
+  uint32_t remainder = outputRate;
+  while (remainder != 0)
+  {
+    uint32_t tmp = gcd % remainder;
+    gcd = remainder;
+    remainder = tmp;
+  }
+  uint32_t numPhases = outputRate / gcd;
+
   IasCommandQueueEntry queuedCommand;
   queuedCommand.commandId    = eIasSetConversionRatio;
   queuedCommand.fsRatio      = (static_cast<double>(inputRate) /
@@ -448,6 +494,8 @@ IasSrcFarrow::IasResult IasSrcFarrow::setConversionRatio(uint32_t inputRate,
   queuedCommand.coeff        = coeff;
   queuedCommand.filterLength = filterParams.filterLength;
   queuedCommand.numFilters   = filterParams.numFilters;
+  queuedCommand.numPhases    = (numPhases <= cMaxNumPhases) ? numPhases : 0;
+  queuedCommand.phaseStep    = inputRate / gcd;
   mCommandQueue.push(queuedCommand);
 
   return eIasOk;
@@ -540,7 +588,10 @@ IasSrcFarrow::IasResult IasSrcFarrow::executeQueuedCommands()
         mNumFilters   = queuedCommand.numFilters;
         mFsRatio = queuedCommand.fsRatio;
         mFsRatioInv = queuedCommand.fsRatioInv;
+        mNumPhases = queuedCommand.numPhases;
+        mPhaseStep = queuedCommand.phaseStep;
         mTValue  = 0.0;
+        mTValueHat = 0.0f;
         for (uint32_t cnt=0; cnt < mNumFilters; cnt++)
         {
           mImpulseResponses[cnt] = &(queuedCommand.coeff[cnt*mFilterLength]);
@@ -548,23 +599,57 @@ IasSrcFarrow::IasResult IasSrcFarrow::executeQueuedCommands()
 
 #if (IASSRCFARROWCONFIG_USE_SSE)
         // Only for the SSE optimized variant, we need the function pointer for updating the impulse response.
-        switch (mNumFilters)
+        // The AVX2/FMA variants are used instead of the SSE variants if the CPU supports them.
+        if (getSimdLevel() >= eIasSimdAvx2)
+        {
+          switch (mNumFilters)
+          {
+            case 4:
+              mUpdateImpulseResponseFunction = &IasSrcFarrow::updateImpulseResponseAvx2<4>;
+              break;
+            case 5:
+              mUpdateImpulseResponseFunction = &IasSrcFarrow::updateImpulseResponseAvx2<5>;
+              break;
+            case 6:
+              mUpdateImpulseResponseFunction = &IasSrcFarrow::updateImpulseResponseAvx2<6>;
+              break;
+            case 7:
+              mUpdateImpulseResponseFunction = &IasSrcFarrow::updateImpulseResponseAvx2<7>;
+              break;
+            default:
+              mUpdateImpulseResponseFunction = NULL;
+              return eIasFailed;
+          }
+        }
+        else
         {
-          case 4:
-            mUpdateImpulseResponseFunction = &IasSrcFarrow::updateImpulseResponseN4;
-            break;
-          case 5:
-            mUpdateImpulseResponseFunction = &IasSrcFarrow::updateImpulseResponseN5;
-            break;
-          case 6:
-            mUpdateImpulseResponseFunction = &IasSrcFarrow::updateImpulseResponseN6;
-            break;
-          case 7:
-            mUpdateImpulseResponseFunction = &IasSrcFarrow::updateImpulseResponseN7;
-            break;
-          default:
-            mUpdateImpulseResponseFunction = NULL;
-            return eIasFailed;
+          switch (mNumFilters)
+          {
+            case 4:
+              mUpdateImpulseResponseFunction = &IasSrcFarrow::updateImpulseResponseN4;
+              break;
+            case 5:
+              mUpdateImpulseResponseFunction = &IasSrcFarrow::updateImpulseResponseN5;
+              break;
+            case 6:
+              mUpdateImpulseResponseFunction = &IasSrcFarrow::updateImpulseResponseN6;
+              break;
+            case 7:
+              mUpdateImpulseResponseFunction = &IasSrcFarrow::updateImpulseResponseN7;
+              break;
+            default:
+              mUpdateImpulseResponseFunction = NULL;
+              return eIasFailed;
+          }
+        }
+
+        // Precompute the impulse responses of the phases k/mNumPhases of an exact conversion ratio.
+        // The push mode uses k = 0..mNumPhases-1, the pull mode uses k = 1..mNumPhases.
+        for (uint32_t cnt=0; (mNumPhases > 0) && (cnt <= mNumPhases); cnt++)
+        {
+          float * __restrict phaseImpResp = &mPhaseImpResp[cnt*cTimeVarImpRespStride];
+          (this->*mUpdateImpulseResponseFunction)(phaseImpResp, static_cast<float>(cnt) / static_cast<float>(mNumPhases));
+          _mm_storeu_ps(&phaseImpResp[mFilterLength], _mm_setzero_ps());
         }
 #endif
 
@@ -611,6 +696,7 @@ IasSrcFarrow::IasResult IasSrcFarrow::executeQueuedCommands()
 
         mRingBufferIndex = 0;
         mTValue = 0.0;
+        mTValueHat = 0.0f;
         break;
       }
       default:
@@ -891,8 +977,6 @@ IasSrcFarrow::IasResult IasSrcFarrow::processPushMode(T2                 **outpu
     maxOutputSamples = numFreeSamplesRingbuffer(readIndex, mRingBufferIndex, lengthOutputBuffers);
   }
 
-  float * __restrict       timeVarImpResp = mTimeVarImpResp;
-
   // Consider the adjustment value for the conversion ratio. This is required
   // for asynchronous operation, if the sample rate converter is combined with
   // a closed-loop controller, which updates the conversion ratio according to
@@ -908,70 +992,100 @@ IasSrcFarrow::IasResult IasSrcFarrow::processPushMode(T2                 **outpu
     mTValue = 0.0;
   }
 
+  // For an exact conversion ratio, the t values are multiples of 1/mNumPhases. As long as
+  // the ratio is not adjusted, mTValue is tracked as integer phase in units of 1/mNumPhases
+  // and the output samples use the precomputed impulse responses of their phases.
+  uint32_t  phase = 0;
+  bool const usePhases = ((mNumPhases > 0) && (ratioAdjustment == 1.0f) && !mDetunedMode &&
+                          isOnPhaseGrid(mTValue, mNumPhases, &phase));
+
   uint32_t  cntOutputSamples  = 0;
   uint32_t  cntInputSamples   = 0;
   uint32_t  currentWriteIndex = mRingBufferIndex;
-  __m128 const cZero             = _mm_setzero_ps();
+  bool      outputBufferFull  = false;
 
-  while (cntInputSamples < numInputSamples)
+  // The samples are processed in blocks. For each block, we first schedule the input
+  // and output samples by running the state machine of mTValue. Then all input samples
+  // of the block are inserted into the FIR filter and finally all output samples of the
+  // block are generated back to back, see processBlock.
+  while ((cntInputSamples < numInputSamples) && !outputBufferFull)
   {
-    if (mTValue < 1.0)
+    uint32_t numBlockInputSamples  = 0;
+    uint32_t numBlockOutputSamples = 0;
+
+    while (cntInputSamples + numBlockInputSamples < numInputSamples)
     {
-      // If the output ring buffer does not provide space for one more sample, exit the loop.
-      if (cntOutputSamples >= maxOutputSamples)
+      if (usePhases ? (phase < mNumPhases) : (mTValue < 1.0))
       {
-        break;
-      }
-
-      // Generate one output sample. To do this, we have to
-      // calculate the time-variant impulse response by polynomial
-      // interpolation based on the polyphase impulse responses.
-      // This is done by means of Horner's method.
-
-      // Fill the head and the tail of the time variant impulse response with zeros.
-      // This is required, since the time variant impulse response might be
-      // shifted by 0, 1, 2, or 3 samples, depending on getPaddingForSSE().
-      _mm_store_ps(&timeVarImpResp[0], cZero);
-      _mm_store_ps(&timeVarImpResp[mFilterLength], cZero);
-
-      // Calculate the time-variant impulse response. The <mFilterLength>
-      // coefficients are stored in the destination buffer using a shift
-      // 0, 1, 2, or 3 samples, depending on getPaddingForSSE()
-      (this->*mUpdateImpulseResponseFunction)(&mTimeVarImpResp[mFirFilterMultiChan->getPaddingForSSE()],
-                                              static_cast<float>(mTValue));
+        // If the output ring buffer does not provide space for one more sample, exit the loop.
+        if (cntOutputSamples + numBlockOutputSamples >= maxOutputSamples)
+        {
+          outputBufferFull = true;
+          break;
+        }
+        if (numBlockOutputSamples == cBlockLength)
+        {
+          break;
+        }
 
-      // Load the time-variant impulse response into the multi-channel filter.
-      firStatus = mFirFilterMultiChan->setImpulseResponse((const float**)&timeVarImpResp, mFilterLength);
-      if (firStatus)
-      {
-        return eIasFailed;
+        if (usePhases)
+        {
+          mBlockImpulseResponses[numBlockOutputSamples] = &mPhaseImpResp[phase*cTimeVarImpRespStride];
+          mBlockTValues[numBlockOutputSamples] = static_cast<float>(phase) / static_cast<float>(mNumPhases);
+          phase = phase + mPhaseStep;
+        }
+        else
+        {
+          mBlockTValues[numBlockOutputSamples] = static_cast<float>(mTValue);
+          mTValue = mTValue + currentFsRatio;
+        }
+        mBlockOutputIndices[numBlockOutputSamples] = currentWriteIndex * outputStride;
+        mBlockInputDelays[numBlockOutputSamples]   = numBlockInputSamples; // converted into a delay by processBlock
+        currentWriteIndex = incrementBufferIndex(currentWriteIndex, lengthOutputBuffers);
+        numBlockOutputSamples++;
       }
-
-      // Execute the FIR filters, generate one output sample for each channel.
-      firStatus = mFirFilterMultiChan->multiInputProcessSample(outputBuffers,
-                                                               currentWriteIndex * outputStride,
-                                                               numChannels);
-      if (firStatus)
+      else
       {
-        return eIasFailed;
+        // Consume one input sample
+        if (numBlockInputSamples == cBlockLength)
+        {
+          break;
+        }
+        if (usePhases)
+        {
+          phase = phase - mNumPhases;
+        }
+        else
+        {
+          mTValue = mTValue - 1.0;
+        }
+        numBlockInputSamples++;
       }
-      currentWriteIndex = incrementBufferIndex(currentWriteIndex, lengthOutputBuffers);
-      cntOutputSamples++;
-      mTValue = mTValue + currentFsRatio;
     }
-    else
+
+    firStatus = mFirFilterMultiChan->multiInputInsertBlock(inputBuffers,
+                                                           cntInputSamples,
+                                                           inputStride,
+                                                           numBlockInputSamples,
+                                                           numChannels);
+    if (firStatus)
     {
-      // Consume one input sample
-      mTValue = mTValue - 1.0;
-      firStatus = mFirFilterMultiChan->multiInputInsertSample(inputBuffers,
-                                                              cntInputSamples * inputStride,
-                                                              numChannels);
-      if (firStatus)
-      {
-        return eIasFailed;
-      }
-      cntInputSamples++;
+      return eIasFailed;
+    }
+
+    status = processBlock(outputBuffers, numBlockInputSamples, numBlockOutputSamples, numChannels, usePhases);
+    if (status != eIasOk)
+    {
+      return status;
     }
+
+    cntInputSamples  += numBlockInputSamples;
+    cntOutputSamples += numBlockOutputSamples;
+  }
+
+  if (usePhases)
+  {
+    mTValue = static_cast<double>(phase) / static_cast<double>(mNumPhases);
   }
 
   *numGeneratedSamples = cntOutputSamples;
@@ -1372,8 +1486,6 @@ IasSrcFarrow::IasResult IasSrcFarrow::processPullMode(T2                **output
     return eIasInvalidParam;
   }
 
-  float * __restrict timeVarImpResp = mTimeVarImpResp;
-
   if (mBufferMode == eIasLinearBufferMode)
   {
     // In linear buffer mode, start reading input samples from the beginning of the input
@@ -1405,74 +1517,118 @@ IasSrcFarrow::IasResult IasSrcFarrow::processPullMode(T2                **output
   }
 
   float currentFsRatio   = 1.0f / static_cast<float>(currentFsRatioInv);
+
+  // For an exact conversion ratio, mTValue is tracked as integer phase in units of 1/mPhaseStep
+  // and mTValueHat in units of 1/mNumPhases, see processPushMode.
+  uint32_t  phase    = 0;
+  uint32_t  phaseHat = 0;
+  bool const usePhases = ((mNumPhases > 0) && (ratioAdjustment == 1.0f) && !mDetunedMode &&
+                          isOnPhaseGrid(mTValue, mPhaseStep, &phase) &&
+                          isOnPhaseGrid(mTValueHat, mNumPhases, &phaseHat) && (phaseHat <= mNumPhases));
+
   uint32_t  cntOutputSamples = 0;
   uint32_t  cntInputSamples  = 0;
   uint32_t  currentReadIndex = mRingBufferIndex;
-  __m128 const cZero            = _mm_setzero_ps();
+  bool      inputBufferEmpty = false;
 
-  while (cntOutputSamples < numOutputSamples)
+  // The samples are processed in blocks, see processPushMode.
+  while ((cntOutputSamples < numOutputSamples) && !inputBufferEmpty)
   {
-    if (mTValue < 1.0)
+    uint32_t numBlockInputSamples  = 0;
+    uint32_t numBlockOutputSamples = 0;
+
+    while (cntOutputSamples + numBlockOutputSamples < numOutputSamples)
     {
-      // Consume one input sample.
-      // If the input ring buffer does not provide any more samples, exit the loop.
-      if (cntInputSamples >= maxInputSamples)
+      if (usePhases ? (phase < mPhaseStep) : (mTValue < 1.0))
       {
-        break;
-      }
-
-      // Resync mTValueHat to mTValue and update mTValue to match the push-mode update.
-      mTValueHat = (1.0f - static_cast<float>(mTValue)) * currentFsRatio;
-      mTValue = mTValue + currentFsRatioInv;
-
-      firStatus = mFirFilterMultiChan->multiInputInsertSample(inputBuffers,
-                                                              currentReadIndex * inputStride,
-                                                              numChannels);
-      currentReadIndex = incrementBufferIndex(currentReadIndex, lengthInputBuffers);
-      cntInputSamples++;
+        // Consume one input sample.
+        // If the input ring buffer does not provide any more samples, exit the loop.
+        if (cntInputSamples + numBlockInputSamples >= maxInputSamples)
+        {
+          inputBufferEmpty = true;
+          break;
+        }
+        if (numBlockInputSamples == cBlockLength)
+        {
+          break;
+        }
 
-      if (firStatus)
+        // Resync mTValueHat to mTValue and update mTValue to match the push-mode update.
+        if (usePhases)
+        {
+          phaseHat = mPhaseStep - phase;
+          phase    = phase + mNumPhases;
+        }
+        else
+        {
+          mTValueHat = (1.0f - static_cast<float>(mTValue)) * currentFsRatio;
+          mTValue = mTValue + currentFsRatioInv;
+        }
+        numBlockInputSamples++;
+      }
+      else
       {
-        return eIasFailed;
+        if (numBlockOutputSamples == cBlockLength)
+        {
+          break;
+        }
+
+        if (usePhases)
+        {
+          mBlockImpulseResponses[numBlockOutputSamples] = &mPhaseImpResp[phaseHat*cTimeVarImpRespStride];
+          mBlockTValues[numBlockOutputSamples] = static_cast<float>(phaseHat) / static_cast<float>(mNumPhases);
+          phaseHat = phaseHat + mPhaseStep;
+          phase    = phase - mPhaseStep;
+        }
+        else
+        {
+          mBlockTValues[numBlockOutputSamples] = mTValueHat;
+          mTValueHat = mTValueHat + currentFsRatio;
+          mTValue    = mTValue - 1.0;
+        }
+        mBlockOutputIndices[numBlockOutputSamples] = (cntOutputSamples + numBlockOutputSamples) * outputStride;
+        mBlockInputDelays[numBlockOutputSamples]   = numBlockInputSamples; // converted into a delay by processBlock
+        numBlockOutputSamples++;
       }
     }
-    else
-    {
-      // Generate one output sample. To do this, we have to
-      // calculate the time-variant impulse response by polynomial
-      // interpolation based on the polyphase impulse responses.
-      // This is done by means of Horner's method.
-
-      // Fill the head and the tail of the time variant impulse response with zeros.
-      // This is required, since the time variant impulse response might be
-      // shifted by 0, 1, 2, or 3 samples, depending on getPaddingForSSE().
-      _mm_store_ps(&timeVarImpResp[0], cZero);
-      _mm_store_ps(&timeVarImpResp[mFilterLength], cZero);
 
-      // Calculate the time-variant impulse response. The <mFilterLength>
-      // coefficients are stored in the destination buffer using a shift
-      // 0, 1, 2, or 3 samples, depending on getPaddingForSSE()
-      (this->*mUpdateImpulseResponseFunction)(&mTimeVarImpResp[mFirFilterMultiChan->getPaddingForSSE()], mTValueHat);
-
-      // Load the time-variant impulse response into the multi-channel filter.
-      firStatus = mFirFilterMultiChan->setImpulseResponse((const float**)&timeVarImpResp, mFilterLength);
+    // Insert the input samples of the block, the input ring buffer might wrap around.
+    uint32_t numInsertedSamples = 0;
+    while (numInsertedSamples < numBlockInputSamples)
+    {
+      uint32_t numContiguousSamples = std::min(numBlockInputSamples - numInsertedSamples,
+                                               lengthInputBuffers - currentReadIndex);
+      firStatus = mFirFilterMultiChan->multiInputInsertBlock(inputBuffers,
+                                                             currentReadIndex,
+                                                             inputStride,
+                                                             numContiguousSamples,
+                                                             numChannels);
       if (firStatus)
       {
         return eIasFailed;
       }
-
-      // Execute the FIR filters, generate one output sample for each channel.
-      firStatus = mFirFilterMultiChan->multiInputProcessSample(outputBuffers,
-                                                            cntOutputSamples * outputStride,
-                                                            numChannels);
-      if (firStatus)
+      numInsertedSamples += numContiguousSamples;
+      currentReadIndex += numContiguousSamples;
+      if (currentReadIndex >= lengthInputBuffers)
       {
-        return eIasFailed;
+        currentReadIndex = 0;
       }
-      cntOutputSamples++;
-      mTValueHat = mTValueHat + currentFsRatio;
-      mTValue    = mTValue - 1.0;
     }
+    // The samples of two insert calls are contiguous in the ring buffers of the filter.
+    status = processBlock(outputBuffers, numBlockInputSamples, numBlockOutputSamples, numChannels, usePhases);
+    if (status != eIasOk)
+    {
+      return status;
+    }
+
+    cntInputSamples  += numBlockInputSamples;
+    cntOutputSamples += numBlockOutputSamples;
+  }
+
+  if (usePhases)
+  {
+    mTValue    = static_cast<double>(phase) / static_cast<double>(mPhaseStep);
+    mTValueHat = static_cast<float>(phaseHat) / static_cast<float>(mNumPhases);
   }
 
   *numGeneratedSamples = cntOutputSamples;
@@ -1607,6 +1763,85 @@ template IasSrcFarrow::IasResult IasSrcFarrow::processPullMode<int16_t, float>(f
 
 #if (IASSRCFARROWCONFIG_USE_SSE)  // The following functions are required only for the SSE optimized variant.
 
+/*****************************************************************************
+ * @brief Generate the output samples of one block, after the input samples of
+ *        the block have been inserted into the FIR filter.
+ *****************************************************************************
+ */
+template <typename T2>
+IasSrcFarrow::IasResult IasSrcFarrow::processBlock(T2       **outputBuffers,
+                                                   uint32_t   numBlockInputSamples,
+                                                   uint32_t   numBlockOutputSamples,
+                                                   uint32_t   numChannels,
+                                                   bool       usePhases)
+{
+  int firStatus;
+
+  // The filter has to know the delays relative to the last inserted sample. Count the
+  // input positions that have at least one output sample.
+  uint32_t numInputPositions = 0;
+  for (uint32_t cnt = 0; cnt < numBlockOutputSamples; cnt++)
+  {
+    mBlockInputDelays[cnt] = numBlockInputSamples - mBlockInputDelays[cnt];
+    if ((cnt == 0) || (mBlockInputDelays[cnt] != mBlockInputDelays[cnt-1]))
+    {
+      numInputPositions++;
+    }
+  }
+
+  // Select the structure with the lower number of multiply-adds for this block.
+  // - Interpolation of the impulse responses: for each output sample, the impulse response
+  //   is interpolated by Horner's method and then it is applied to all channels.
+  // - Classic Farrow structure: for each input position, all channels are filtered by all
+  //   prototype impulse responses; then Horner's method is applied to the sub-filter outputs
+  //   for each output sample of each channel.
+  // The classic structure is cheaper for few channels, especially for upsampling, where
+  // several output samples share one input position. Its multiply-adds are weighted by 3/2,
+  // since the sub-filter outputs need one horizontal sum each (measured with SSE and AVX2).
+  // With the precomputed impulse responses of the phases, nothing has to be interpolated,
+  // but each output sample still loads its impulse response, which costs about two channels.
+  uint32_t const numInterpolationOps = usePhases ? 2 : (mNumFilters - 1);
+  uint32_t const costInterpolation   = numBlockOutputSamples * mFilterLength * (numInterpolationOps + numChannels);
+  uint32_t const costClassic         = 3 * numInputPositions * numChannels * mNumFilters * mFilterLength / 2 +
+                                       numBlockOutputSamples * numChannels * (mNumFilters - 1);
+
+  if (costClassic < costInterpolation)
+  {
+    firStatus = mFirFilterMultiChan->multiInputProcessBlockFarrow(outputBuffers,
+                                                                  mBlockOutputIndices,
+                                                                  mBlockInputDelays,
+                                                                  mBlockTValues,
+                                                                  mImpulseResponses,
+                                                                  mNumFilters,
+                                                                  numBlockOutputSamples,
+                                                                  numChannels);
+  }
+  else
+  {
+    // Calculate the time-variant impulse responses of all output samples, unless they have
+    // been selected from the phases. Fill the 4 coefficients after each impulse response
+    // with zeros, since the FIR filter processes whole 4-tap blocks.
+    __m128 const cZero = _mm_setzero_ps();
+    for (uint32_t cnt = 0; (cnt < numBlockOutputSamples) && !usePhases; cnt++)
+    {
+      float * __restrict timeVarImpResp = &mTimeVarImpResp[cnt*cTimeVarImpRespStride];
+      (this->*mUpdateImpulseResponseFunction)(timeVarImpResp, mBlockTValues[cnt]);
+      _mm_storeu_ps(&timeVarImpResp[mFilterLength], cZero);
+      mBlockImpulseResponses[cnt] = timeVarImpResp;
+    }
+
+    firStatus = mFirFilterMultiChan->multiInputProcessBlock(outputBuffers,
+                                                            mBlockOutputIndices,
+                                                            mBlockInputDelays,
+                                                            mBlockImpulseResponses,
+                                                            numBlockOutputSamples,
+                                                            numChannels);
+  }
+
+  return (firStatus == 0) ? eIasOk : eIasFailed;
+}
+
+
 /**
  *  Update the time variant impulse response, using N=4 prototype impulse responses.
  */
@@ -1869,6 +2104,47 @@ void IasSrcFarrow::updateImpulseResponseN7(float *destination, float tValue) con
   }
 }
 
+/**
+ *  Evaluate the Horner scheme for numFilters prototype impulse responses with AVX2/FMA: the products
+ *  are fused with the additions, 16 coefficients per iteration in two 256 bit registers.
+ *  The impulse responses are only 16-byte aligned, therefore unaligned loads are used.
+ */
+template <uint32_t numFilters>
+__attribute__ ((target ("avx2,fma")))
+static void updateImpulseResponseHornerAvx2(float * __restrict dst, float const * const *impulseResponses,
+                                            uint32_t filterLength, float tValue)
+{
+  __m256 const tValue_pack = _mm256_set1_ps(tValue);
+  __m256 yHorner_pack1;
+  __m256 yHorner_pack2;
+
+  for (uint32_t cnt=0; cnt < filterLength; cnt+=16)
+  {
+    yHorner_pack1 = _mm256_loadu_ps(impulseResponses[numFilters-1]+cnt);
+    yHorner_pack2 = _mm256_loadu_ps(impulseResponses[numFilters-1]+cnt+8);
+
+    for (uint32_t filter=numFilters-1; filter > 0; filter--)
+    {
+      float const *impulseResponse = impulseResponses[filter-1]+cnt;
+      yHorner_pack1 = _mm256_fmadd_ps(tValue_pack, yHorner_pack1, _mm256_loadu_ps(impulseResponse));
+      yHorner_pack2 = _mm256_fmadd_ps(tValue_pack, yHorner_pack2, _mm256_loadu_ps(impulseResponse+8));
+    }
+
+    _mm256_storeu_ps(dst,   yHorner_pack1);
+    _mm256_storeu_ps(dst+8, yHorner_pack2);
+    dst += 16;
+  }
+}
+
+/**
+ *  Update the time variant impulse response, using numFilters prototype impulse responses (AVX2/FMA variant).
+ */
+template <uint32_t numFilters>
+void IasSrcFarrow::updateImpulseResponseAvx2(float *destination, float tValue) const
+{
+  updateImpulseResponseHornerAvx2<numFilters>(destination, mImpulseResponses, mFilterLength, tValue);
+}
+
 #endif // IASSRCFARROWCONFIG_USE_SSE
 
 
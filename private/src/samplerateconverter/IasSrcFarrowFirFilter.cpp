@@ -21,6 +21,8 @@
 #if IASSRCFARROWCONFIG_USE_SSE
 #include <xmmintrin.h>
 #include <emmintrin.h>
+#include <immintrin.h>
+#include "internal/audio/common/helper/IasCpuFeatures.hpp"
 #endif
 
 #ifdef __linux__
@@ -112,6 +114,20 @@ inline uint32_t  decreaseIndex(uint32_t index, uint32_t ringBufferLength)
 }
 
 
+/**
+ * Evaluate the polynomial sum_n coeffs[n]*x^n by means of Horner's method.
+ */
+inline float evaluatePolynomial(float const *coeffs, uint32_t numCoeffs, float x)
+{
+  float y = coeffs[numCoeffs-1];
+  for (uint32_t n=numCoeffs-1; n>0; n--)
+  {
+    y = y*x + coeffs[n-1];
+  }
+  return y;
+}
+
+
 #if !(IASSRCFARROWCONFIG_USE_SSE)
 
 /**
@@ -244,6 +260,236 @@ inline void storeLowValue(int16_t *p, __m128 a)
   *p       = static_cast<int16_t>(intValue);
 }
 
+
+/**
+ * Conversion of 4 contiguous samples from the input format (either float or int32_t
+ * or int16_t) into float. These are the SSE counterparts of convert2Float.
+ */
+inline __m128 convert2Float4(float const *p)
+{
+  return _mm_loadu_ps(p);
+}
+
+inline __m128 convert2Float4(int32_t const *p)
+{
+  static const __m128 cConversionFactor_mm = _mm_load1_ps(&cConversionFactor_int2float);
+  return _mm_mul_ps(_mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<__m128i const*>(p))), cConversionFactor_mm);
+}
+
+inline __m128 convert2Float4(int16_t const *p)
+{
+  static const __m128 cConversionFactor_mm = _mm_load1_ps(&cConversionFactor_short2float);
+  __m128i a = _mm_loadl_epi64(reinterpret_cast<__m128i const*>(p));
+  a = _mm_srai_epi32(_mm_unpacklo_epi16(a, a), 16); // sign extension from Int16 to Int32
+  return _mm_mul_ps(_mm_cvtepi32_ps(a), cConversionFactor_mm);
+}
+
+
+/**
+ * Apply output gain to the 8 single-precision floating-point values of a __m256
+ * register and store the lowest numChans values to the output buffers of
+ * numChans channels. These are the AVX2 counterparts of storeLowValue.
+ */
+__attribute__ ((target ("avx2")))
+inline void storeValues(float **p, uint32_t index, __m256 a, uint32_t numChans)
+{
+  float values[8] __attribute__ ((aligned (32)));
+  _mm256_store_ps(values, _mm256_mul_ps(a, _mm256_set1_ps(cOutputGain))); // apply output gain
+  for (uint32_t chan=0; chan<numChans; chan++)
+  {
+    p[chan][index] = values[chan];
+  }
+}
+
+__attribute__ ((target ("avx2")))
+inline void storeValues(int32_t **p, uint32_t index, __m256 a, uint32_t numChans)
+{
+  int32_t values[8] __attribute__ ((aligned (32)));
+  a = _mm256_mul_ps(a, _mm256_set1_ps(cConversionFactor_float2int)); // multiply with 2^31-1 and apply output gain
+  __m256i b = _mm256_cvttps_epi32(a);
+#if IASSRCFARROWCONFIG_USE_SATURATION
+  // cvttps already returns 0x80000000 for all values out of range, fix the positive ones
+  b = _mm256_blendv_epi8(b, _mm256_set1_epi32(0x7fffffff),
+                         _mm256_castps_si256(_mm256_cmp_ps(a, _mm256_set1_ps(cIntMaxVal), _CMP_GT_OQ)));
+#endif
+  _mm256_store_si256(reinterpret_cast<__m256i*>(values), b);
+  for (uint32_t chan=0; chan<numChans; chan++)
+  {
+    p[chan][index] = values[chan];
+  }
+}
+
+__attribute__ ((target ("avx2")))
+inline void storeValues(int16_t **p, uint32_t index, __m256 a, uint32_t numChans)
+{
+  int32_t values[8] __attribute__ ((aligned (32)));
+  a = _mm256_mul_ps(a, _mm256_set1_ps(cConversionFactor_float2short)); // multiply with 2^15-1 and apply output gain
+  __m256i b = _mm256_cvtps_epi32(a);                                     // convert from Float32 to Int32
+#if IASSRCFARROWCONFIG_USE_SATURATION
+  b = _mm256_min_epi32(_mm256_max_epi32(b, _mm256_set1_epi32(-32768)), _mm256_set1_epi32(32767));
+#endif
+  _mm256_store_si256(reinterpret_cast<__m256i*>(values), b);
+  for (uint32_t chan=0; chan<numChans; chan++)
+  {
+    p[chan][index] = static_cast<int16_t>(values[chan]);
+  }
+}
+
+
+/**
+ * Calculate the convolution sums of numChans channels with the same impulse response,
+ * using AVX2/FMA. Each channel has its own accumulator, so that the impulse response
+ * is loaded only once for all channels and the FMA latency is hidden by the independent
+ * accumulators. The epilogue reduces the accumulators horizontally into one register,
+ * which carries the sums of all channels, and writes all output samples at once.
+ *
+ * The ring buffers are read starting at index, which is only 16-byte aligned. If the number
+ * of 4-tap blocks is odd, the last block is loaded with a mask, so that nothing is read
+ * beyond the 4-tap blocks that are processed by the SSE variant.
+ */
+template <typename T, uint32_t numChans>
+__attribute__ ((target ("avx2,fma")))
+inline void multiChannelConvolutionAvx2(T            **outputBuffers,
+                                        uint32_t    outputBufferIndex,
+                                        float * const *ringBuffers,
+                                        uint32_t    index,
+                                        float const *impulseResponse,
+                                        uint32_t    loop_num)
+{
+  __m256 ac[8];
+  __m256 impulse_responses_pack;
+  uint32_t chan;
+  uint32_t cnt;
+
+  for (chan=0; chan<8; chan++)
+  {
+    ac[chan] = _mm256_setzero_ps();
+  }
+
+  for (cnt=0; cnt<loop_num/2; cnt++)
+  {
+    impulse_responses_pack = _mm256_loadu_ps(&impulseResponse[cnt*8]);
+    // The channel loop has to be unrolled, so that the accumulators are kept in registers.
+#if !(INTEL_COMPILER)
+    #pragma GCC unroll 8
+#endif
+    for (chan=0; chan<numChans; chan++)
+    {
+      ac[chan] = _mm256_fmadd_ps(_mm256_loadu_ps(&ringBuffers[chan][index+cnt*8]), impulse_responses_pack, ac[chan]);
+    }
+  }
+  if ((loop_num & 0x01) != 0)
+  {
+    __m256i const lowMask = _mm256_set_epi32(0, 0, 0, 0, -1, -1, -1, -1);
+    impulse_responses_pack = _mm256_maskload_ps(&impulseResponse[cnt*8], lowMask);
+    for (chan=0; chan<numChans; chan++)
+    {
+      ac[chan] = _mm256_fmadd_ps(_mm256_maskload_ps(&ringBuffers[chan][index+cnt*8], lowMask), impulse_responses_pack, ac[chan]);
+    }
+  }
+
+  // Horizontal reduction: after the hadds, the lower and the upper 128 bit lanes carry the
+  // partial sums of channels 0..3 and 4..7, in the order of the channels.
+  __m256 sum01   = _mm256_hadd_ps(ac[0], ac[1]);
+  __m256 sum23   = _mm256_hadd_ps(ac[2], ac[3]);
+  __m256 sum45   = _mm256_hadd_ps(ac[4], ac[5]);
+  __m256 sum67   = _mm256_hadd_ps(ac[6], ac[7]);
+  __m256 sum0123 = _mm256_hadd_ps(sum01, sum23);
+  __m256 sum4567 = _mm256_hadd_ps(sum45, sum67);
+  __m256 sums    = _mm256_add_ps(_mm256_permute2f128_ps(sum0123, sum4567, 0x20),
+                                 _mm256_permute2f128_ps(sum0123, sum4567, 0x31));
+
+  storeValues(outputBuffers, outputBufferIndex, sums, numChans);
+}
+
+
+/**
+ * Calculate the outputs of numSubFilters sub-filters for one window of one channel (classic
+ * Farrow structure). Each sub-filter has its own accumulator, so that every 4-tap block of
+ * the window is loaded only once for all sub-filters. The sub-filters are 16-byte aligned.
+ */
+template <uint32_t numSubFilters>
+inline void subFilterConvolution(float       *subFilterOutputs,
+                                 float const *window,
+                                 float const * const *subFilters,
+                                 uint32_t    loop_num)
+{
+  __m128 ac[numSubFilters];
+  __m128 ringbuffer_pack;
+  uint32_t n;
+
+  for (n=0; n<numSubFilters; n++)
+  {
+    ac[n] = _mm_setzero_ps();
+  }
+  for (uint32_t cnt=0; cnt<loop_num; cnt++)
+  {
+    ringbuffer_pack = _mm_loadu_ps(&window[cnt*4]);
+    // The sub-filter loop has to be unrolled, so that the accumulators are kept in registers.
+#if !(INTEL_COMPILER)
+    #pragma GCC unroll 8
+#endif
+    for (n=0; n<numSubFilters; n++)
+    {
+      ac[n] = _mm_add_ps(ac[n], _mm_mul_ps(ringbuffer_pack, _mm_load_ps(&subFilters[n][cnt*4])));
+    }
+  }
+  for (n=0; n<numSubFilters; n++)
+  {
+    __m128 tmp = _mm_add_ps(ac[n], _mm_movehl_ps(ac[n], ac[n]));
+    _mm_store_ss(&subFilterOutputs[n], _mm_add_ss(tmp, _mm_shuffle_ps(tmp, tmp, 1)));
+  }
+}
+
+
+/**
+ * AVX2/FMA variant of subFilterConvolution. If the number of 4-tap blocks is odd, the last
+ * block is loaded with a mask, like in multiChannelConvolutionAvx2.
+ */
+template <uint32_t numSubFilters>
+__attribute__ ((target ("avx2,fma")))
+inline void subFilterConvolutionAvx2(float       *subFilterOutputs,
+                                     float const *window,
+                                     float const * const *subFilters,
+                                     uint32_t    loop_num)
+{
+  __m256 ac[numSubFilters];
+  __m256 ringbuffer_pack;
+  uint32_t n;
+  uint32_t cnt;
+
+  for (n=0; n<numSubFilters; n++)
+  {
+    ac[n] = _mm256_setzero_ps();
+  }
+  for (cnt=0; cnt<loop_num/2; cnt++)
+  {
+    ringbuffer_pack = _mm256_loadu_ps(&window[cnt*8]);
+#if !(INTEL_COMPILER)
+    #pragma GCC unroll 8
+#endif
+    for (n=0; n<numSubFilters; n++)
+    {
+      ac[n] = _mm256_fmadd_ps(ringbuffer_pack, _mm256_loadu_ps(&subFilters[n][cnt*8]), ac[n]);
+    }
+  }
+  if ((loop_num & 0x01) != 0)
+  {
+    __m256i const lowMask = _mm256_set_epi32(0, 0, 0, 0, -1, -1, -1, -1);
+    ringbuffer_pack = _mm256_maskload_ps(&window[cnt*8], lowMask);
+    for (n=0; n<numSubFilters; n++)
+    {
+      ac[n] = _mm256_fmadd_ps(ringbuffer_pack, _mm256_maskload_ps(&subFilters[n][cnt*8], lowMask), ac[n]);
+    }
+  }
+  for (n=0; n<numSubFilters; n++)
+  {
+    __m128 tmp = _mm_add_ps(_mm256_castps256_ps128(ac[n]), _mm256_extractf128_ps(ac[n], 1));
+    tmp = _mm_add_ps(tmp, _mm_movehl_ps(tmp, tmp));
+    _mm_store_ss(&subFilterOutputs[n], _mm_add_ss(tmp, _mm_shuffle_ps(tmp, tmp, 1)));
+  }
+}
+
 #endif
 
 
@@ -259,8 +505,11 @@ IasSrcFarrowFirFilter::IasSrcFarrowFirFilter()
   ,mRingBufferIndex(0)
 #if IASSRCFARROWCONFIG_USE_SSE
   ,mPaddingForSSE((mRingBufferIndex+1) & 0x00000003)
+  ,mUseAvx2(false)
 #endif
   ,mMaxFilterLength(0)
+  ,mMaxBlockLength(0)
+  ,mRingBufferLength(0)
   ,mFilterLength(0)
   ,mNumImpulseResponses(0)
   ,mMaxNumInputChannels(0)
@@ -311,9 +560,14 @@ IasSrcFarrowFirFilter::~IasSrcFarrowFirFilter()
  */
 int IasSrcFarrowFirFilter::init(uint32_t  maxFilterLength,
                                 uint32_t  numImpulseResponses,
-                                uint32_t  maxNumInputChannels)
+                                uint32_t  maxNumInputChannels,
+                                uint32_t  maxBlockLength)
 {
   uint32_t chan;
+  // The ring buffers keep maxBlockLength samples more than the filter needs, so that the
+  // input samples of a whole block can be inserted before the output samples are calculated.
+  // The length is a multiple of 4, so that the SSE padding does not change at the wrap-around.
+  uint32_t ringBufferLength = (maxFilterLength + maxBlockLength + 3) & ~3u;
 
   if (mIsInitialized)
   {
@@ -350,9 +604,9 @@ int IasSrcFarrowFirFilter::init(uint32_t  maxFilterLength,
   for (chan=0; chan<maxNumInputChannels; chan++)
   {
 #if MS_VC
-    mRingBuffers[chan] = (float*)_aligned_malloc(2*maxFilterLength*sizeof(float), 16);
+    mRingBuffers[chan] = (float*)_aligned_malloc(2*ringBufferLength*sizeof(float), 16);
 #else
-    mRingBuffers[chan] = (float*)memalign(16, 2*maxFilterLength*sizeof(float));
+    mRingBuffers[chan] = (float*)memalign(16, 2*ringBufferLength*sizeof(float));
 #endif
     if (mRingBuffers[chan] == NULL)
     {
@@ -363,11 +617,14 @@ int IasSrcFarrowFirFilter::init(uint32_t  maxFilterLength,
   mNumImpulseResponses = numImpulseResponses;
   mMaxNumInputChannels = maxNumInputChannels;
   mMaxFilterLength     = maxFilterLength;
+  mMaxBlockLength      = maxBlockLength;
+  mRingBufferLength    = ringBufferLength;
   mFilterLength        = 0;
   mIsInitialized       = true;
 
 #if IASSRCFARROWCONFIG_USE_SSE
   mPaddingForSSE = (mRingBufferIndex+1) & 0x00000003;
+  mUseAvx2       = (getSimdLevel() >= eIasSimdAvx2);
 #endif
 
   // Call the reset function
@@ -446,7 +703,7 @@ int IasSrcFarrowFirFilter::reset()
       return 1;
     }
 
-    memset(mRingBuffers[chan], 0, 2*mMaxFilterLength*sizeof(mRingBuffers[0][0]));
+    memset(mRingBuffers[chan], 0, 2*mRingBufferLength*sizeof(mRingBuffers[0][0]));
   }
   return 0;
 }
@@ -460,16 +717,16 @@ int IasSrcFarrowFirFilter::singleInputInsertSample(float const *inputBuffer,
 {
   // Verify that mRingBufferIndex is valid. In practice, the assert condition
   // will never fail, because mRingBufferIndex is under control of this component.
-  IAS_ASSERT(mRingBufferIndex < mFilterLength);
+  IAS_ASSERT(mRingBufferIndex < mRingBufferLength);
 
   // Insert the current sample into the ring buffer. We need only one
   // channel (channel 0) for this function.
   mRingBuffers[0][mRingBufferIndex]               = inputBuffer[inputBufferIndex];
-  mRingBuffers[0][mRingBufferIndex+mFilterLength] = inputBuffer[inputBufferIndex];
+  mRingBuffers[0][mRingBufferIndex+mRingBufferLength] = inputBuffer[inputBufferIndex];
 
   // Decrease the buffer write index. The ring buffer is organized such that the
   // input samples are written from the right to the left.
-  mRingBufferIndex = decreaseIndex(mRingBufferIndex, mFilterLength);
+  mRingBufferIndex = decreaseIndex(mRingBufferIndex, mRingBufferLength);
 
   return 0;
 }
@@ -489,7 +746,7 @@ int IasSrcFarrowFirFilter::singleInputProcessSample(float *outputSamples)
 
   for (chan=0; chan < mNumImpulseResponses; chan++)
   {
-    index2 = increaseIndex(mRingBufferIndex, mFilterLength);
+    index2 = increaseIndex(mRingBufferIndex, mRingBufferLength);
     sum    = 0.0f;
 
     // Calculate the convolution sum.
@@ -527,12 +784,12 @@ int IasSrcFarrowFirFilter::multiInputInsertSample(T            const **inputBuff
     // Insert the current sample of all input channels into the ring buffers.
     inputSample = convert2Float(inputBuffers[chan][inputBufferIndex]);
     mRingBuffers[chan][mRingBufferIndex]               = inputSample;
-    mRingBuffers[chan][mRingBufferIndex+mFilterLength] = inputSample;
+    mRingBuffers[chan][mRingBufferIndex+mRingBufferLength] = inputSample;
   }
 
   // Decrease the buffer write index. The ring buffer is organized such that the
   // input samples are written from the right to the left.
-  mRingBufferIndex = decreaseIndex(mRingBufferIndex, mFilterLength);
+  mRingBufferIndex = decreaseIndex(mRingBufferIndex, mRingBufferLength);
 
 #if IASSRCFARROWCONFIG_USE_SSE
   mPaddingForSSE = (mRingBufferIndex+1) & 0x00000003;
@@ -557,6 +814,91 @@ template int IasSrcFarrowFirFilter::multiInputInsertSample<int16_t>(int16_t   co
                                                                        uint32_t          inputBufferIndex,
                                                                        uint32_t          numInputChannels);
 
+/*****************************************************************************
+ * @brief Insert a block of new input samples (of M input channels) into the
+ *        internal ring buffers.
+ *****************************************************************************
+ */
+template <typename T>
+int IasSrcFarrowFirFilter::multiInputInsertBlock(T            const **inputBuffers,
+                                                 uint32_t          inputBufferIndex,
+                                                 uint32_t          inputStride,
+                                                 uint32_t          numSamples,
+                                                 uint32_t          numInputChannels)
+{
+  if ((mNumImpulseResponses != 1) || (numInputChannels > mMaxNumInputChannels) || (numSamples > mMaxBlockLength))
+  {
+    return 1;
+  }
+
+  for (uint32_t chan=0; chan<numInputChannels; chan++)
+  {
+    T     const * __restrict inputSample = &inputBuffers[chan][inputBufferIndex*inputStride];
+    float       * __restrict ringBuffer  = mRingBuffers[chan];
+    uint32_t index = mRingBufferIndex;
+    uint32_t cnt   = 0;
+
+#if IASSRCFARROWCONFIG_USE_SSE
+    // For contiguous input samples, convert 4 samples at once. The ring buffer is written from
+    // the right to the left, so the 4 samples are stored in reverse order at index-3..index.
+    if (inputStride == 1)
+    {
+      for (; cnt+4 <= numSamples; cnt+=4)
+      {
+        if (index < 3)
+        {
+          break;
+        }
+        __m128 samples = convert2Float4(&inputSample[cnt]);
+        samples = _mm_shuffle_ps(samples, samples, _MM_SHUFFLE(0, 1, 2, 3));
+        _mm_storeu_ps(&ringBuffer[index-3], samples);
+        _mm_storeu_ps(&ringBuffer[index-3+mRingBufferLength], samples);
+        index -= 4;
+        if (index == static_cast<uint32_t>(-1))
+        {
+          index = mRingBufferLength-1;
+        }
+      }
+    }
+#endif
+
+    // Remaining samples, samples around the wrap-around, or interleaved input samples.
+    for (; cnt<numSamples; cnt++)
+    {
+      float sample = convert2Float(inputSample[cnt*inputStride]);
+      ringBuffer[index]                   = sample;
+      ringBuffer[index+mRingBufferLength] = sample;
+      index = decreaseIndex(index, mRingBufferLength);
+    }
+  }
+
+  mRingBufferIndex = (mRingBufferIndex + mRingBufferLength - numSamples) % mRingBufferLength;
+
+#if IASSRCFARROWCONFIG_USE_SSE
+  mPaddingForSSE = (mRingBufferIndex+1) & 0x00000003;
+#endif
+
+  return 0;
+}
+
+template int IasSrcFarrowFirFilter::multiInputInsertBlock<float>(float const **inputBuffers,
+                                                                 uint32_t      inputBufferIndex,
+                                                                 uint32_t      inputStride,
+                                                                 uint32_t      numSamples,
+                                                                 uint32_t      numInputChannels);
+
+template int IasSrcFarrowFirFilter::multiInputInsertBlock<int32_t>(int32_t const **inputBuffers,
+                                                                   uint32_t        inputBufferIndex,
+                                                                   uint32_t        inputStride,
+                                                                   uint32_t        numSamples,
+                                                                   uint32_t        numInputChannels);
+
+template int IasSrcFarrowFirFilter::multiInputInsertBlock<int16_t>(int16_t const **inputBuffers,
+                                                                   uint32_t        inputBufferIndex,
+                                                                   uint32_t        inputStride,
+                                                                   uint32_t        numSamples,
+                                                                   uint32_t        numInputChannels);
+
 
 #if !(IASSRCFARROWCONFIG_USE_SSE)  // The normal variant (without SSE optimization)
 
@@ -583,7 +925,7 @@ int IasSrcFarrowFirFilter::multiInputProcessSample(T            **outputBuffers,
 
   for (chan=0; chan<numChannels; chan++)
   {
-    index2 = increaseIndex(mRingBufferIndex, mFilterLength);
+    index2 = increaseIndex(mRingBufferIndex, mRingBufferLength);
     sum    = 0.0f;
 
     // Calculate the convolution sum.
@@ -599,6 +941,116 @@ int IasSrcFarrowFirFilter::multiInputProcessSample(T            **outputBuffers,
   return 0;
 }
 
+/*****************************************************************************
+ * @brief Process the FIR filter for a block of output samples, each of them
+ *        with its own impulse response, which is jointly used for all channels.
+ *****************************************************************************
+ */
+template <typename T>
+int IasSrcFarrowFirFilter::multiInputProcessBlock(T              **outputBuffers,
+                                                  uint32_t const  *outputBufferIndices,
+                                                  uint32_t const  *inputDelays,
+                                                  float    const * const *impulseResponses,
+                                                  uint32_t         numOutputSamples,
+                                                  uint32_t         numChannels)
+{
+  uint32_t  chan;
+  uint32_t  cnt;
+  uint32_t  index2;
+  float sum;
+
+  if ((mNumImpulseResponses != 1) || (numChannels > mMaxNumInputChannels))
+  {
+    return 1;
+  }
+
+  for (uint32_t outputSample=0; outputSample<numOutputSamples; outputSample++)
+  {
+    IAS_ASSERT(inputDelays[outputSample] <= mMaxBlockLength);
+    float const *impulseResponse = impulseResponses[outputSample];
+
+    for (chan=0; chan<numChannels; chan++)
+    {
+      index2 = (mRingBufferIndex + inputDelays[outputSample] + 1) % mRingBufferLength;
+      sum    = 0.0f;
+
+      // Calculate the convolution sum.
+      for (cnt=0; cnt<mFilterLength; cnt++)
+      {
+        sum = sum + mRingBuffers[chan][index2] * impulseResponse[cnt];
+        index2++;
+      }
+      // Write sum into output buffer. Do a conversion from float to integer, if required.
+      convertFloat2Output(&outputBuffers[chan][outputBufferIndices[outputSample]], sum);
+    }
+  }
+
+  return 0;
+}
+
+/*****************************************************************************
+ * @brief Process the FIR filter for a block of output samples by means of
+ *        the classic Farrow structure.
+ *****************************************************************************
+ */
+template <typename T>
+int IasSrcFarrowFirFilter::multiInputProcessBlockFarrow(T                   **outputBuffers,
+                                                        uint32_t const       *outputBufferIndices,
+                                                        uint32_t const       *inputDelays,
+                                                        float    const       *tValues,
+                                                        float    const * const *subFilters,
+                                                        uint32_t              numSubFilters,
+                                                        uint32_t              numOutputSamples,
+                                                        uint32_t              numChannels)
+{
+  float     subFilterOutputs[cMaxNumSubFilters];
+  uint32_t  chan;
+  uint32_t  cnt;
+  uint32_t  n;
+
+  if ((mNumImpulseResponses != 1) || (numChannels > mMaxNumInputChannels) ||
+      (numSubFilters < 1) || (numSubFilters > cMaxNumSubFilters))
+  {
+    return 1;
+  }
+
+  uint32_t outputSample = 0;
+  while (outputSample < numOutputSamples)
+  {
+    IAS_ASSERT(inputDelays[outputSample] <= mMaxBlockLength);
+
+    // All output samples with the same input delay share the sub-filter outputs.
+    uint32_t numGroupSamples = 1;
+    while ((outputSample+numGroupSamples < numOutputSamples) &&
+           (inputDelays[outputSample+numGroupSamples] == inputDelays[outputSample]))
+    {
+      numGroupSamples++;
+    }
+    uint32_t index = (mRingBufferIndex + inputDelays[outputSample] + 1) % mRingBufferLength;
+
+    for (chan=0; chan<numChannels; chan++)
+    {
+      for (n=0; n<numSubFilters; n++)
+      {
+        float sum = 0.0f;
+        for (cnt=0; cnt<mFilterLength; cnt++)
+        {
+          sum = sum + mRingBuffers[chan][index+cnt] * subFilters[n][cnt];
+        }
+        subFilterOutputs[n] = sum;
+      }
+      for (cnt=outputSample; cnt<outputSample+numGroupSamples; cnt++)
+      {
+        convertFloat2Output(&outputBuffers[chan][outputBufferIndices[cnt]],
+                            evaluatePolynomial(subFilterOutputs, numSubFilters, tValues[cnt]));
+      }
+    }
+    outputSample += numGroupSamples;
+  }
+
+  return 0;
+}
+
 #else // !(IASSRCFARROWCONFIG_USE_SSE) // Now following... the SSE-optimized variant
 
 template <typename T>
@@ -606,44 +1058,125 @@ int IasSrcFarrowFirFilter::multiInputProcessSample(T            **outputBuffers,
                                                    uint32_t    outputBufferIndex,
                                                    uint32_t    numChannels)
 {
-  uint32_t  chan;
-  uint32_t  cnt;
-  uint32_t  index2;
+  if ((mNumImpulseResponses != 1) || (numChannels > mMaxNumInputChannels) || (numChannels < 1))
+  {
+    return 1;
+  }
 
-  __m128i shift32 = _mm_set_epi32(0, 0, 0, 32);
+  // Determine loop number based on if have any padding
+  uint32_t loop_num = (mPaddingForSSE == 0) ? mFilterLength/4 : mFilterLength/4+1;
+
+  // round index2 to make mRingBuffers[chan][index2] 16-bytes aligned
+  uint32_t index2 = increaseIndex(mRingBufferIndex, mRingBufferLength) - mPaddingForSSE;
+
+  multiInputConvolve(outputBuffers, outputBufferIndex, index2, mImpulseResponses[0], loop_num, numChannels);
+
+  return 0;
+}
 
+/*****************************************************************************
+ * @brief Process the FIR filter for a block of output samples, each of them
+ *        with its own impulse response, which is jointly used for all channels.
+ *****************************************************************************
+ */
+template <typename T>
+int IasSrcFarrowFirFilter::multiInputProcessBlock(T              **outputBuffers,
+                                                  uint32_t const  *outputBufferIndices,
+                                                  uint32_t const  *inputDelays,
+                                                  float    const * const *impulseResponses,
+                                                  uint32_t         numOutputSamples,
+                                                  uint32_t         numChannels)
+{
   if ((mNumImpulseResponses != 1) || (numChannels > mMaxNumInputChannels) || (numChannels < 1))
   {
     return 1;
   }
 
+  // The impulse responses are padded with zeros, so that we can always process whole 4-tap blocks.
+  // The ring buffer index is not aligned here, but the windows of the output samples can
+  // be read without a shifted copy of each impulse response.
+  uint32_t loop_num = (mFilterLength+3)/4;
+
+  for (uint32_t outputSample=0; outputSample<numOutputSamples; outputSample++)
+  {
+    IAS_ASSERT(inputDelays[outputSample] <= mMaxBlockLength);
+    uint32_t index2 = (mRingBufferIndex + inputDelays[outputSample] + 1) % mRingBufferLength;
+    multiInputConvolve(outputBuffers, outputBufferIndices[outputSample], index2,
+                       impulseResponses[outputSample], loop_num, numChannels);
+  }
+
+  return 0;
+}
+
+template <typename T>
+void IasSrcFarrowFirFilter::multiInputConvolve(T            **outputBuffers,
+                                               uint32_t    outputBufferIndex,
+                                               uint32_t    index,
+                                               float const *impulseResponse,
+                                               uint32_t    numBlocks,
+                                               uint32_t    numChannels)
+{
+  uint32_t  chan = 0;
+  uint32_t  cnt;
+  uint32_t  index2;
+
+  // For one or two channels, the SSE kernel is faster, since the AVX2/FMA kernel has only one
+  // or two dependency chains and a longer epilogue, which dominate for short impulse responses.
+  if (mUseAvx2 && (numChannels > 2))
+  {
+    // The AVX2/FMA variant processes 8 taps per iteration for up to 8 channels per pass.
+    for (; chan+8 <= numChannels; chan+=8)
+    {
+      multiChannelConvolutionAvx2<T, 8>(&outputBuffers[chan], outputBufferIndex, &mRingBuffers[chan], index, impulseResponse, numBlocks);
+    }
+    if (chan+4 <= numChannels)
+    {
+      multiChannelConvolutionAvx2<T, 4>(&outputBuffers[chan], outputBufferIndex, &mRingBuffers[chan], index, impulseResponse, numBlocks);
+      chan += 4;
+    }
+    switch (numChannels-chan)
+    {
+      case 3:
+        multiChannelConvolutionAvx2<T, 3>(&outputBuffers[chan], outputBufferIndex, &mRingBuffers[chan], index, impulseResponse, numBlocks);
+        break;
+      case 2:
+        multiChannelConvolutionAvx2<T, 2>(&outputBuffers[chan], outputBufferIndex, &mRingBuffers[chan], index, impulseResponse, numBlocks);
+        break;
+      case 1:
+        multiChannelConvolutionAvx2<T, 1>(&outputBuffers[chan], outputBufferIndex, &mRingBuffers[chan], index, impulseResponse, numBlocks);
+        break;
+      default:
+        break;
+    }
+    return;
+  }
+
+  __m128i shift32 = _mm_set_epi32(0, 0, 0, 32);
+
   __m128       impulse_responses_pack;
   __m128       ringbuffer_pack1, ringbuffer_pack2;
   __m128       ac0, ac1;
 
-  // Determine loop number based on if have any padding
-  uint32_t loop_num = (mPaddingForSSE == 0) ? mFilterLength/4 : mFilterLength/4+1;
-
   // Calcute 2 channels in each iteration.
   // This loop is executed floor(numChannels/2) times.
-  for (chan=0; chan < numChannels-1; chan+=2)
+  for (chan=0; chan+1 < numChannels; chan+=2)
   {
-    // round index2 to make mRingBuffers[chan][index2] 16-bytes aligned
-    index2 = increaseIndex(mRingBufferIndex, mFilterLength) - mPaddingForSSE;
+    index2 = index;
     ac0 = _mm_setzero_ps();
     ac1 = _mm_setzero_ps();
 
-    // Calculate the convolution sum.
+    // Calculate the convolution sum. The ring buffers are read with unaligned loads,
+    // because the block processing does not align the index.
 #if INTEL_COMPILER
     // Let the Intel compiler unroll the following loop by a factor of 4.
     #pragma unroll(4)
 #endif
-    for (cnt=0; cnt<loop_num; cnt++)
+    for (cnt=0; cnt<numBlocks; cnt++)
     {
-      // sum = sum + mRingBuffers[chan][index2] * mImpulseResponses[0][cnt];
-      impulse_responses_pack = _mm_load_ps(&mImpulseResponses[0][cnt*4]);
-      ringbuffer_pack1 = _mm_load_ps(&(mRingBuffers[chan][index2]));
-      ringbuffer_pack2 = _mm_load_ps(&(mRingBuffers[chan+1][index2]));
+      // sum = sum + mRingBuffers[chan][index2] * impulseResponse[cnt];
+      impulse_responses_pack = _mm_load_ps(&impulseResponse[cnt*4]);
+      ringbuffer_pack1 = _mm_loadu_ps(&(mRingBuffers[chan][index2]));
+      ringbuffer_pack2 = _mm_loadu_ps(&(mRingBuffers[chan+1][index2]));
       ac0 = _mm_add_ps(ac0, _mm_mul_ps(ringbuffer_pack1, impulse_responses_pack));
       ac1 = _mm_add_ps(ac1, _mm_mul_ps(ringbuffer_pack2, impulse_responses_pack));
       index2 += 4;
@@ -662,20 +1195,15 @@ int IasSrcFarrowFirFilter::multiInputProcessSample(T            **outputBuffers,
   if ((numChannels & 0x01) != 0)
   {
     chan = numChannels-1;
-
-    // round index2 to make mRingBuffers[chan][index2] 16-bytes aligned
-    index2 = increaseIndex(mRingBufferIndex, mFilterLength) - mPaddingForSSE;
+    index2 = index;
     ac0 = _mm_setzero_ps();
 
-    //#pragma ivdep
-    //   #pragma vector aligned
-    //   #pragma unroll(8)
     // Calculate the convolution sum.
-    for (cnt=0; cnt<loop_num; cnt++)
+    for (cnt=0; cnt<numBlocks; cnt++)
     {
-      // sum = sum + mRingBuffers[chan][index2] * mImpulseResponses[0][cnt];
-      impulse_responses_pack = _mm_load_ps(&mImpulseResponses[0][cnt*4]);
-      ringbuffer_pack1 = _mm_load_ps(&(mRingBuffers[chan][index2]));
+      // sum = sum + mRingBuffers[chan][index2] * impulseResponse[cnt];
+      impulse_responses_pack = _mm_load_ps(&impulseResponse[cnt*4]);
+      ringbuffer_pack1 = _mm_loadu_ps(&(mRingBuffers[chan][index2]));
       ac0 = _mm_add_ps(ac0, _mm_mul_ps(ringbuffer_pack1, impulse_responses_pack));
       index2 += 4;
     }
@@ -689,10 +1217,134 @@ int IasSrcFarrowFirFilter::multiInputProcessSample(T            **outputBuffers,
     __m128 sum = _mm_add_ss(tmp, _mm_shuffle_ps(tmp, tmp, 1));
     storeLowValue(&outputBuffers[chan][outputBufferIndex], sum);   // output
   }
+}
+
+/*****************************************************************************
+ * @brief Process the FIR filter for a block of output samples by means of
+ *        the classic Farrow structure.
+ *****************************************************************************
+ */
+template <typename T>
+int IasSrcFarrowFirFilter::multiInputProcessBlockFarrow(T                   **outputBuffers,
+                                                        uint32_t const       *outputBufferIndices,
+                                                        uint32_t const       *inputDelays,
+                                                        float    const       *tValues,
+                                                        float    const * const *subFilters,
+                                                        uint32_t              numSubFilters,
+                                                        uint32_t              numOutputSamples,
+                                                        uint32_t              numChannels)
+{
+  float subFilterOutputs[cMaxNumSubFilters];
+
+  if ((mNumImpulseResponses != 1) || (numChannels > mMaxNumInputChannels) || (numChannels < 1) ||
+      (numSubFilters < 1) || (numSubFilters > cMaxNumSubFilters))
+  {
+    return 1;
+  }
+
+  // The sub-filters are not padded, so mFilterLength has to be a multiple of 4 here.
+  IAS_ASSERT((mFilterLength & 0x03) == 0);
+  uint32_t loop_num = mFilterLength/4;
+
+  uint32_t outputSample = 0;
+  while (outputSample < numOutputSamples)
+  {
+    IAS_ASSERT(inputDelays[outputSample] <= mMaxBlockLength);
+
+    // All output samples with the same input delay share the sub-filter outputs.
+    uint32_t numGroupSamples = 1;
+    while ((outputSample+numGroupSamples < numOutputSamples) &&
+           (inputDelays[outputSample+numGroupSamples] == inputDelays[outputSample]))
+    {
+      numGroupSamples++;
+    }
+    uint32_t index = (mRingBufferIndex + inputDelays[outputSample] + 1) % mRingBufferLength;
+
+    for (uint32_t chan=0; chan<numChannels; chan++)
+    {
+      subFilterConvolve(subFilterOutputs, &mRingBuffers[chan][index], subFilters, numSubFilters, loop_num);
+      for (uint32_t cnt=outputSample; cnt<outputSample+numGroupSamples; cnt++)
+      {
+        storeLowValue(&outputBuffers[chan][outputBufferIndices[cnt]],
+                      _mm_set_ss(evaluatePolynomial(subFilterOutputs, numSubFilters, tValues[cnt])));
+      }
+    }
+    outputSample += numGroupSamples;
+  }
 
   return 0;
 }
 
+void IasSrcFarrowFirFilter::subFilterConvolve(float       *subFilterOutputs,
+                                              float const *window,
+                                              float const * const *subFilters,
+                                              uint32_t    numSubFilters,
+                                              uint32_t    numBlocks)
+{
+  // The number of sub-filters is a template parameter of the kernels, so that the
+  // accumulators are kept in registers.
+  if (mUseAvx2)
+  {
+    switch (numSubFilters)
+    {
+      case 1:
+        subFilterConvolutionAvx2<1>(subFilterOutputs, window, subFilters, numBlocks);
+        break;
+      case 2:
+        subFilterConvolutionAvx2<2>(subFilterOutputs, window, subFilters, numBlocks);
+        break;
+      case 3:
+        subFilterConvolutionAvx2<3>(subFilterOutputs, window, subFilters, numBlocks);
+        break;
+      case 4:
+        subFilterConvolutionAvx2<4>(subFilterOutputs, window, subFilters, numBlocks);
+        break;
+      case 5:
+        subFilterConvolutionAvx2<5>(subFilterOutputs, window, subFilters, numBlocks);
+        break;
+      case 6:
+        subFilterConvolutionAvx2<6>(subFilterOutputs, window, subFilters, numBlocks);
+        break;
+      case 7:
+        subFilterConvolutionAvx2<7>(subFilterOutputs, window, subFilters, numBlocks);
+        break;
+      default:
+        subFilterConvolutionAvx2<8>(subFilterOutputs, window, subFilters, numBlocks);
+        break;
+    }
+  }
+  else
+  {
+    switch (numSubFilters)
+    {
+      case 1:
+        subFilterConvolution<1>(subFilterOutputs, window, subFilters, numBlocks);
+        break;
+      case 2:
+        subFilterConvolution<2>(subFilterOutputs, window, subFilters, numBlocks);
+        break;
+      case 3:
+        subFilterConvolution<3>(subFilterOutputs, window, subFilters, numBlocks);
+        break;
+      case 4:
+        subFilterConvolution<4>(subFilterOutputs, window, subFilters, numBlocks);
+        break;
+      case 5:
+        subFilterConvolution<5>(subFilterOutputs, window, subFilters, numBlocks);
+        break;
+      case 6:
+        subFilterConvolution<6>(subFilterOutputs, window, subFilters, numBlocks);
+        break;
+      case 7:
+        subFilterConvolution<7>(subFilterOutputs, window, subFilters, numBlocks);
+        break;
+      default:
+        subFilterConvolution<8>(subFilterOutputs, window, subFilters, numBlocks);
+        break;
+    }
+  }
+}
+
 #endif // #if IASSRCFARROWCONFIG_USE_SSE
 
 /*
@@ -711,4 +1363,52 @@ template int IasSrcFarrowFirFilter::multiInputProcessSample<int16_t>(int16_t   *
                                                                         uint32_t    outputBufferIndex,
                                                                         uint32_t    numChannels);
 
+template int IasSrcFarrowFirFilter::multiInputProcessBlock<float>(float         **outputBuffers,
+                                                                  uint32_t const *outputBufferIndices,
+                                                                  uint32_t const *inputDelays,
+                                                                  float    const * const *impulseResponses,
+                                                                  uint32_t        numOutputSamples,
+                                                                  uint32_t        numChannels);
+
+template int IasSrcFarrowFirFilter::multiInputProcessBlock<int32_t>(int32_t       **outputBuffers,
+                                                                    uint32_t const *outputBufferIndices,
+                                                                    uint32_t const *inputDelays,
+                                                                    float    const * const *impulseResponses,
+                                                                    uint32_t        numOutputSamples,
+                                                                    uint32_t        numChannels);
+
+template int IasSrcFarrowFirFilter::multiInputProcessBlock<int16_t>(int16_t       **outputBuffers,
+                                                                    uint32_t const *outputBufferIndices,
+                                                                    uint32_t const *inputDelays,
+                                                                    float    const * const *impulseResponses,
+                                                                    uint32_t        numOutputSamples,
+                                                                    uint32_t        numChannels);
+
+template int IasSrcFarrowFirFilter::multiInputProcessBlockFarrow<float>(float         **outputBuffers,
+                                                                        uint32_t const *outputBufferIndices,
+                                                                        uint32_t const *inputDelays,
+                                                                        float    const *tValues,
+                                                                        float    const * const *subFilters,
+                                                                        uint32_t        numSubFilters,
+                                                                        uint32_t        numOutputSamples,
+                                                                        uint32_t        numChannels);
+
+template int IasSrcFarrowFirFilter::multiInputProcessBlockFarrow<int32_t>(int32_t       **outputBuffers,
+                                                                          uint32_t const *outputBufferIndices,
+                                                                          uint32_t const *inputDelays,
+                                                                          float    const *tValues,
+                                                                          float    const * const *subFilters,
+                                                                          uint32_t        numSubFilters,
+                                                                          uint32_t        numOutputSamples,
+                                                                          uint32_t        numChannels);
+
+template int IasSrcFarrowFirFilter::multiInputProcessBlockFarrow<int16_t>(int16_t       **outputBuffers,
+                                                                          uint32_t const *outputBufferIndices,
+                                                                          uint32_t const *inputDelays,
+                                                                          float    const *tValues,
+                                                                          float    const * const *subFilters,
+                                                                          uint32_t        numSubFilters,
+                                                                          uint32_t        numOutputSamples,
+                                                                          uint32_t        numChannels);
+
 } // namespace IasAudio
@@ -129,7 +129,9 @@ enum IasRingbufferType
   eIasRingBufferUndef = 0,        //!< Undefined
   eIasRingBufferShared,           //!< Ring buffer located in shared memory
   eIasRingBufferLocalMirror,      //!< Ring buffer using the mmap'ed areas of an ALSA device
-  eIasRingBufferLocalReal         //!< Ring buffer located in local memory
+  eIasRingBufferLocalReal,        //!< Ring buffer located in local memory
+  eIasRingBufferLocalDoubleMapped //!< Ring buffer located in local memory, each channel is mapped twice back-to-back,
+                                  //!< so that an access never has to be split at the end of the buffer
 };
 
 /**
@@ -314,6 +316,67 @@ enum IasAudioCommonDataLayout
  */
 std::string toString(const IasAudioCommonDataLayout&  type);
 
+/**
+  * @brief Huge page usage for the memory of audio buffers
+  */
+enum IasHugePageMode
+{
+  eIasHugePagesNone = 0,      //!< Regular pages
+  eIasHugePagesTransparent    //!< Transparent huge pages via madvise(MADV_HUGEPAGE)
+};
+
+/**
+ * @brief Function to get a IasHugePageMode as string.
+ *
+ * @return Enum Member
+ * @return eIasHugePagesInvalid on unknown value.
+ */
+std::string toString(const IasHugePageMode&  type);
+
+/**
+ * @brief Options for the memory of audio buffers, to avoid page faults in the real-time threads
+ */
+struct IasMemoryOptions
+{
+  /**
+   * @brief Constructs the options with the default values, where nothing is applied.
+   */
+  inline IasMemoryOptions()
+    :prefault(false)
+    ,lock(false)
+    ,hugePages(eIasHugePagesNone)
+  {}
+
+  bool             prefault;    //!< Touch all pages when the memory is created or connected
+  bool             lock;        //!< Lock the pages into RAM via mlock
+  IasHugePageMode  hugePages;   //!< The wanted huge page usage
+};
+
+/**
+ * @brief Report of the memory options that have actually been applied
+ */
+struct IasMemoryReport
+{
+  /**
+   * @brief Constructs the report with nothing applied.
+   */
+  inline IasMemoryReport()
+    :size(0)
+    ,prefaulted(false)
+    ,locked(false)
+    ,hugePages(eIasHugePagesNone)
+    ,hugePagesRequested(false)
+    ,lockError(0)
+  {}
+
+  uint64_t         size;        //!< The size of the memory in bytes the options have been applied to
+  bool             prefaulted;  //!< All pages have been faulted in
+  bool             locked;      //!< All pages are locked into RAM
+  IasHugePageMode  hugePages;   //!< The huge page usage that is in effect, i.e. the kernel reports huge pages for the memory
+  bool             hugePagesRequested; //!< Transparent huge pages have been requested via madvise, they might not be in effect though
+  int32_t          lockError;   //!< The errno of a failed mlock call, e.g. EPERM or ENOMEM, 0 otherwise
+};
+
 /**
  * @brief Parameter for audio device configuration
  */
@@ -32,8 +32,9 @@ class __attribute__ ((visibility ("default"))) IasMemoryAllocator
      */
     enum IasOpenFlag
     {
-      eIasCreate,       //!< Create the shared or the heap memory
-      eIasConnect       //!< Connect to a previously created shared memory
+      eIasCreate,         //!< Create the shared or the heap memory
+      eIasConnect,        //!< Connect to a previously created shared memory
+      eIasConnectOrCreate //!< Connect to the shared memory or create it if it does not exist, it is never removed
     };
 
     /**
@@ -73,6 +74,44 @@ class __attribute__ ((visibility ("default"))) IasMemoryAllocator
      */
     IasAudioCommonResult init(IasOpenFlag flag, std::string *errorMsg);
 
+    /**
+     * @brief Initialize the memory allocator and apply the memory options to the whole memory block
+     *
+     * The memory options are applied on a best effort basis, i.e. the initialization doesn't fail
+     * if one of the options cannot be applied. Use getMemoryReport to find out what was applied.
+     *
+     * @param[in] flag The open flag
+     * @param[in] options The memory options, like prefaulting and locking the pages
+     * @param[out] errorMsg If an error occurred, a detailed message will be returned via this parameter
+     * @return The result of initializing the memory allocator
+     * @retval cOk Ok
+     * @retval cInvalidParam The heap memory does not allow eIasConnect as open flag
+     * @retval cInitFailed The directory in shared memory couldn't be created
+     */
+    IasAudioCommonResult init(IasOpenFlag flag, const IasMemoryOptions &options, std::string *errorMsg);
+
+    /**
+     * @brief Get the report of the memory options that have been applied during init
+     *
+     * @returns The memory report
+     */
+    const IasMemoryReport& getMemoryReport() const { return mMemoryReport; }
+
+    /**
+     * @brief Apply memory options to an arbitrary memory region
+     *
+     * Huge pages are applied as transparent huge pages to the existing mapping. The report shows what
+     * is in effect. The kernel accepts the request also for mappings it never backs with huge pages, e.g. shared
+     * memory without shmem_enabled, so eIasHugePagesTransparent is only reported if /proc/self/smaps
+     * shows huge pages for the mapping. Otherwise only hugePagesRequested is set.
+     *
+     * @param[in] address The start address of the memory region
+     * @param[in] size The size of the memory region in bytes
+     * @param[in] options The memory options
+     * @param[out] report The report of the options that have actually been applied
+     */
+    static void applyMemoryOptions(void *address, size_t size, const IasMemoryOptions &options, IasMemoryReport *report);
+
     /**
      * @brief Allocate aligned buffer(s)
      *
@@ -230,6 +269,7 @@ class __attribute__ ((visibility ("default"))) IasMemoryAllocator
     boost::interprocess::managed_shared_memory *mManaged_shm;       //!< Instance is used for shared memory management
     boost::interprocess::managed_heap_memory   *mManaged_heap;      //!< Instance is used for heap memory management
     IasOpenFlag                                 mOpenFlag;          //!< Remember the open flag for proper clean-up
+    IasMemoryReport                             mMemoryReport;      //!< The memory options that have been applied during init
 };
 
 template <class T>
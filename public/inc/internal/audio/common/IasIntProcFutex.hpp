@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2018 Intel Corporation.All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file   IasIntProcFutex.hpp
+ * @date   2018
+ * @brief
+ */
+
+#ifndef IASINTPROCFUTEX_HPP_
+#define IASINTPROCFUTEX_HPP_
+
+#include <atomic>
+
+#include "audio/common/IasAudioCommonTypes.hpp"
+
+namespace IasAudio {
+
+/**
+ * @brief This class provides a process shared wait/wake mechanism based on a futex
+ *
+ * A waiter registers itself together with a threshold of frames it is waiting for.
+ * The counterpart calls wake() with the number of frames that are currently available
+ * for the waiter. The futex is only woken up, if a waiter is registered and the threshold
+ * is reached, so the common case does not need a system call at all.
+ *
+ * The waiter has to use the following sequence to avoid lost wake-ups:
+ * registerWaiter(), then in a loop getSequence(), check the condition, wait(sequence),
+ * and finally unregisterWaiter().
+ */
+class __attribute__ ((visibility ("default"))) IasIntProcFutex
+{
+  public:
+    /**
+     * @brief The result type for the IasIntProcFutex methods
+     */
+    enum IasResult
+    {
+      eIasOk,                         //!< Operation successful
+      eIasTimeout,                    //!< Timeout while waiting for the futex
+      eIasFutexWaitFailed,            //!< FUTEX_WAIT failed
+      eIasFutexWakeFailed,            //!< FUTEX_WAKE failed
+    };
+
+    /**
+     * @brief Constructor
+     */
+    IasIntProcFutex();
+
+    /**
+     * @brief Destructor
+     */
+    virtual ~IasIntProcFutex();
+
+    /**
+     * @brief Register a waiter and publish the threshold it is waiting for
+     *
+     * @param[in] threshold The number of frames that have to be available to wake up the waiter
+     */
+    void registerWaiter(uint32_t threshold);
+
+    /**
+     * @brief Unregister a waiter that was registered via registerWaiter
+     */
+    void unregisterWaiter();
+
+    /**
+     * @brief Get the current wake-up sequence number
+     *
+     * This has to be read before the wait condition is checked and then be handed over to wait.
+     *
+     * @returns The current wake-up sequence number
+     */
+    inline uint32_t getSequence() const { return mSequence.load(); }
+
+    /**
+     * @brief Wait until the sequence number changes or the timeout expires
+     *
+     * @param[in] sequence The sequence number read via getSequence before the wait condition was checked
+     * @param[in] time_ms timespan to wait at maximum
+     *
+     * @returns The status of the method call
+     * @retval eIasOk The sequence number changed or the wait was interrupted
+     * @retval eIasTimeout Timeout while waiting for the futex
+     * @retval eIasFutexWaitFailed FUTEX_WAIT failed
+     */
+    IasResult wait(uint32_t sequence, uint64_t time_ms);
+
+    /**
+     * @brief Wake up the waiter, if one is registered and its threshold is reached
+     *
+     * @param[in] available The number of frames that are currently available for the waiter
+     *
+     * @returns The status of the method call
+     * @retval eIasOk Waiter was woken up or there was no need to wake up anybody
+     * @retval eIasFutexWakeFailed FUTEX_WAKE failed
+     */
+    IasResult wake(uint32_t available);
+
+    /**
+     * @brief Return the native result (errno) of the last futex system call
+     *
+     * This can be used for debugging purposes
+     *
+     * @returns The native error code of the last futex system call
+     */
+    inline int32_t nativeResult() const { return mNativeResult; }
+
+  private:
+    /**
+     * @brief Copy constructor, private unimplemented to prevent misuse.
+     */
+    IasIntProcFutex(IasIntProcFutex const &other);
+
+    /**
+     * @brief Assignment operator, private unimplemented to prevent misuse.
+     */
+    IasIntProcFutex& operator=(IasIntProcFutex const &other);
+
+    std::atomic<uint32_t>   mSequence;      //!< The futex word, incremented on every wake-up
+    std::atomic<uint32_t>   mThreshold;     //!< The wake-up threshold published by the waiter
+    std::atomic<uint32_t>   mNumWaiters;    //!< The number of registered waiters
+    std::atomic<int32_t>    mNativeResult;
+};
+
+/**
+ * @brief Function to get a IasIntProcFutex::IasResult as string.
+ * @return Enum Member as string
+ */
+std::string toString(const IasIntProcFutex::IasResult& type);
+
+
+} /* namespace IasAudio */
+
+#endif /* IASINTPROCFUTEX_HPP_ */
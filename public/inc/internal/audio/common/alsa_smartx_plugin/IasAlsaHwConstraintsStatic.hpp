@@ -76,6 +76,7 @@ struct IasAlsaHwConstraintsStatic
 
   /**
    * Struct contains the layout of the data as IasAudioCommonDataLayout, interleaved or non-interleaved.
+   * If only eIasLayoutInterleaved is listed, the shared ring buffer is created with the interleaved layout as well.
    */
   struct
   {
@@ -16,8 +16,11 @@
 #ifndef IAS_ALSAPLUGIN_SHMCONNECTION_HPP_
 #define IAS_ALSAPLUGIN_SHMCONNECTION_HPP_
 
+#include <atomic>
+
 #include "audio/common/IasAudioCommonTypes.hpp"
 #include "internal/audio/common/IasFdSignal.hpp"
+#include "internal/audio/common/audiobuffer/IasAudioRingBufferTypes.hpp"
 
 
 namespace IasAudio
@@ -61,10 +64,13 @@ class __attribute__ ((visibility ("default"))) IasAlsaPluginShmConnection
      *
      * @param[in] configStruct Configuration of the ring buffer. Not all values are needed only
      * period size, period number, channel number and format is used.
+     * @param[in] options Additional ring buffer options, like the synchronization mode. If the hw constraints
+     * only allow the interleaved layout, the ring buffer is always created with the interleaved layout.
      * @return IasAudio::IasAudioCommonResult IasResultOk if good
      * @return IasAudio::IasAudioCommonResult Results are returned from the factory create function.
      */
-    IasAudioCommonResult createRingBuffer ( const IasAudioDeviceParamsPtr configStruct );
+    IasAudioCommonResult createRingBuffer ( const IasAudioDeviceParamsPtr configStruct,
+                                            const IasAudioRingBufferOptions &options = IasAudioRingBufferOptions() );
 
     /**
      * @brief Function to search for a created connection.
@@ -118,9 +124,12 @@ class __attribute__ ((visibility ("default"))) IasAlsaPluginShmConnection
     }
 
     /**
-     * @brief Verify if the update Flag is set.
+     * @brief Verify if the ringbuffer generation changed.
      * Gets a pointer to the RingBuffer holding the sample areas for the different channels.
      *
+     * The ringbuffer is only looked up again if the server replaced it since the last call,
+     * otherwise this is a single atomic load. The stale ringbuffer is unmapped before the new one is mapped.
+     *
      * @return IasAudioRingBuffer* Pointer to the RingBuffer Instance.
      */
     IasAudioRingBuffer* verifyAndGetRingBuffer();
@@ -154,7 +163,8 @@ class __attribute__ ((visibility ("default"))) IasAlsaPluginShmConnection
     IasAlsaHwConstraintsStatic *mConstraints; //!< Contains the Hardware constrains that are read by the Plugin. Valid flag must be set in the constraints.
     std::string mRingBufferName;              //!< Name of the Ringbuffer
     IasAudioRingBuffer *mRingBuffer;          //!< Instance of a Ringbuffer.
-    bool *mUpdateAvailable;              //!< Pointer to a central flag that marks if there was a change of the ringbuffer
+    std::atomic<uint32_t> *mGeneration;       //!< Central ringbuffer generation in shm, incremented twice per ringbuffer replacement (odd while in progress)
+    uint32_t mRingBufferGeneration;           //!< The generation of mRingBuffer (only used by the client)
     IasMemoryAllocator *mAllocator;           //!< Allocator that allocates or find the instances of the connection.
     bool mIsCreator;                     //!< Bool flag if the class was the creator of the resources. If true, the class will delete the shm region in the destructor.
     IasFdSignal mFdSignal;                    //!< Signal buffer level changes using file descriptors.
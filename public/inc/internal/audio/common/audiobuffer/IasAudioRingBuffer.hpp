@@ -17,7 +17,9 @@
 #include "audio/common/IasAudioCommonTypes.hpp"
 
 #include "boost/interprocess/offset_ptr.hpp"
+#include <atomic>
 #include <map>
+#include <mutex>
 
 /*!
  * @brief namespace IasAudio
@@ -67,6 +69,8 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBuffer
      * @param[in]  shared          Specifies whether the ring buffer will be of type eIasRingBufferShared or eIasRingBufferLocalReal
      * @param[in]  metaData        ...
      * @param[in]  ringbufReal     pointer to the IaAudioRingBufferReal
+     * @param[in]  options         Additional options, like the synchronization mode
+     * @param[in]  doubleMapped    The data buffer maps each channel plane twice (eIasRingBufferLocalDoubleMapped)
      */
     IasAudioRingBufferResult init(uint32_t periodSize,
                                   uint32_t nPeriods,
@@ -75,7 +79,9 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBuffer
                                   void* dataBuf,
                                   bool shared,
                                   IasMetaData* metaData,
-                                  IasAudioRingBufferReal* ringbufReal);
+                                  IasAudioRingBufferReal* ringbufReal,
+                                  const IasAudioRingBufferOptions &options = IasAudioRingBufferOptions(),
+                                  bool doubleMapped = false);
 
     /*!
      * @brief Initialize an audio ring buffer. The ring buffer will be of type eIasRingBufferLocalMirror.
@@ -186,13 +192,43 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBuffer
      */
     IasAudioRingBufferResult beginAccess(IasRingBufferAccess access, IasAudioArea** area, uint32_t* offset, uint32_t* frames);
 
+    /*!
+     * @brief Request to access a portion of an mmap'ed area, which may wrap around the end of the buffer.
+     *
+     * In contrast to the other beginAccess method, the accessible portion is not clamped to the end
+     * of the buffer. It is returned as two regions instead: the head region starts at the current
+     * read/write offset and ends at the latest at the end of the buffer, the tail region continues
+     * at the beginning of the buffer. The tail region has 0 frames if no wrap-around is involved.
+     * Both regions are committed with one call of IasAudioRingBuffer::endAccess(), using the offset
+     * of the head region and the total number of processed frames.
+     *
+     * For the type @a eIasRingBufferLocalMirror the tail region is always empty.
+     *
+     * @returns       error code
+     * @retval        eIasRingBuffOk               on success
+     * @retval        eIasRingBuffInvalidParam     one of the parameters is not valid
+     * @retval        eIasRingBuffNotInitialized   component has not been initialized
+     * @retval        eIasRingBuffNotAllowed       access is already in progress
+     * @retval        eIasRingBuffAlsaError        ALSA error (only for type @a eIasRingBufferLocalMirror)
+     *
+     * @param[in]     access  Specifies the access type (either eIasRingBufferAccessRead or eIasRingBufferAccessWrite).
+     * @param[out]    area    Returned mmap areas (one area for each channel), valid for both regions.
+     * @param[out]    head    Returned first region, starting at the current read/write offset.
+     * @param[out]    tail    Returned second region, starting at the beginning of the buffer.
+     * @param[in,out] frames  mmap area portion size in frames (wanted on entry, available in both regions on exit).
+     */
+    IasAudioRingBufferResult beginAccess(IasRingBufferAccess access, IasAudioArea** area,
+                                         IasAudioRingBufferRegion* head, IasAudioRingBufferRegion* tail, uint32_t* frames);
+
     /*!
      * @brief Declare that we have finished accessing a portion of an mmap'ed area.
      *
      * You should pass this function the offset value that IasAudioRingBuffer::beginAccess()
      * returned. The frames parameter should hold the number of frames you have written or read
      * to/from the audio buffer. The frames parameter must never exceed the contiguous frames
-     * count that IasAudioRingBuffer::beginAccess() returned.
+     * count that IasAudioRingBuffer::beginAccess() returned. After a beginAccess() call that returned
+     * a head and a tail region, the offset of the head region and the number of frames processed in
+     * both regions have to be passed.
      *
      * Each call of IasAudioRingBuffer::beginAccess() must be followed by a call of
      * IasAudioRingBuffer::endAccess().
@@ -203,6 +239,8 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBuffer
      * @retval    eIasRingBuffNotInitialized   component has not been initialized
      * @retval    eIasRingBuffNotAllowed       access is already in progress
      * @retval    eIasRingBuffAlsaError        ALSA error (only for type @a eIasRingBufferLocalMirror)
+     * @retval    eIasRingBuffDataOverwritten  the read access is committed, but the writer has overwritten
+     *                                         (some of) its frames while they were read (eIasRingBuffOverrunOverwrite)
      *
      * @param[in] access  Specifies the access type (either eIasRingBufferAccessRead or eIasRingBufferAccessWrite).
      * @param[in] offset  Offset in area steps (== frames), must be equal to the offset value that
@@ -211,6 +249,213 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBuffer
      */
     IasAudioRingBufferResult endAccess(IasRingBufferAccess access, uint32_t offset, uint32_t frames);
 
+    /*!
+     * @brief Get read-only access to frames in the buffer without consuming them.
+     *
+     * In contrast to IasAudioRingBuffer::beginAccess() this does not start an access and does not
+     * move the read offset, so it can be used for look-ahead, e.g. for level analysis before the
+     * frames are routed. The frames have to be consumed via IasAudioRingBuffer::consume() or a regular
+     * read access afterwards. The returned region is contiguous, it is clamped to the end of the buffer
+     * unless the buffer is of type eIasRingBufferLocalDoubleMapped. Only supported for real buffers,
+     * the default reader is used. The read latency bound (see setReadLatencyBound()) and the skip of
+     * frames that have been overwritten in eIasRingBuffOverrunOverwrite mode are applied here, before the
+     * frames are inspected, and not by consume().
+     *
+     * The areas are updated if the buffer has been reconfigured. The returned region stays readable
+     * after a later reconfigure, until the next reconfigure that replaces the data memory again, but its
+     * content is undefined then. So the frames have to be consumed or peeked again before that.
+     *
+     * @returns       error code
+     * @retval        eIasRingBuffOk               on success
+     * @retval        eIasRingBuffInvalidParam     one of the parameters is not valid
+     * @retval        eIasRingBuffNotInitialized   component has not been initialized
+     * @retval        eIasRingBuffNotAllowed       a read access is in progress, a reconfigure is in progress
+     *                                             (only eIasRingBuffSyncModeLockFree), or not supported for mirror buffers
+     *
+     * @param[in]     offsetFromRead  Distance of the wanted region from the current read position in frames.
+     * @param[out]    area            Returned mmap areas (one area for each channel), must not be written.
+     * @param[out]    offset          Returned mmap area offset in area steps (== frames).
+     * @param[in,out] frames          Wanted number of frames on entry, readable number of frames on exit.
+     */
+    IasAudioRingBufferResult peek(uint32_t offsetFromRead, const IasAudioArea** area, uint32_t* offset, uint32_t* frames);
+
+    /*!
+     * @brief Consume frames from the buffer without accessing them.
+     *
+     * This is the counterpart of IasAudioRingBuffer::peek(). It advances the read offset like a read
+     * access of exactly @a frames frames, without dropping frames for the read latency bound.
+     *
+     * @returns       error code
+     * @retval        eIasRingBuffOk               on success
+     * @retval        eIasRingBuffDataOverwritten  the writer has overwritten some of the frames since they have been
+     *                                             peeked (eIasRingBuffOverrunOverwrite), the peeked content has to be
+     *                                             discarded. The frames are consumed anyway and counted as lost frames.
+     * @retval        eIasRingBuffInvalidParam     less than @a frames frames are in the buffer
+     * @retval        eIasRingBuffNotAllowed       a read access is in progress or not supported for mirror buffers
+     *
+     * @param[in]     frames  The number of frames to consume.
+     */
+    IasAudioRingBufferResult consume(uint32_t frames);
+
+    /*!
+     * @brief Attach an additional reader to the ring buffer (broadcast).
+     *
+     * Only supported for real buffers with the sync mode eIasRingBuffSyncModeLockFree. Up to
+     * cIasAudioRingBufferMaxReaders readers can be attached, each of them has its own read
+     * position, which starts at the current write position. The free space for the writer is
+     * limited by the slowest attached reader, detached readers are ignored.
+     *
+     * Reader 0 is the default reader, it is attached during init and it is the one that is used
+     * by the read accesses without reader id.
+     *
+     * @returns       error code
+     * @retval        eIasRingBuffOk               on success
+     * @retval        eIasRingBuffInvalidParam     readerId is nullptr
+     * @retval        eIasRingBuffNotAllowed       not supported by this buffer or all reader slots are in use
+     *
+     * @param[out]    readerId  Returned id of the reader, to be used for the reader specific methods.
+     */
+    IasAudioRingBufferResult attachReader(uint32_t* readerId);
+
+    /*!
+     * @brief Detach a reader that was attached via IasAudioRingBuffer::attachReader().
+     *
+     * Has to be called by the reader itself, while it has no read access in progress.
+     *
+     * @returns       error code
+     * @retval        eIasRingBuffOk               on success
+     * @retval        eIasRingBuffInvalidParam     invalid reader id
+     * @retval        eIasRingBuffNotAllowed       reader is not attached or has a read access in progress
+     *
+     * @param[in]     readerId  The id of the reader.
+     */
+    IasAudioRingBufferResult detachReader(uint32_t readerId);
+
+    /*!
+     * @brief Get the number of frames ready to be read by the given reader.
+     *
+     * @param[in]  readerId  The id of the reader.
+     * @param[out] samples   Returned number of samples that are ready to be read.
+     */
+    IasAudioRingBufferResult updateAvailableRead(uint32_t readerId, uint32_t* samples);
+
+    /*!
+     * @brief Request a read access for the given reader, see IasAudioRingBuffer::beginAccess().
+     *
+     * @param[in]     readerId  The id of the reader.
+     * @param[out]    area      Returned mmap areas (one area for each channel).
+     * @param[out]    offset    Returned mmap area offset in area steps (== frames).
+     * @param[in,out] frames    mmap area portion size in frames (wanted on entry, contiguous available on exit).
+     */
+    IasAudioRingBufferResult beginReadAccess(uint32_t readerId, IasAudioArea** area, uint32_t* offset, uint32_t* frames);
+
+    /*!
+     * @brief Finish a read access of the given reader, see IasAudioRingBuffer::endAccess().
+     *
+     * @param[in] readerId  The id of the reader.
+     * @param[in] offset    Offset in area steps (== frames), as returned by IasAudioRingBuffer::beginReadAccess().
+     * @param[in] frames    Number of frames that have been read.
+     */
+    IasAudioRingBufferResult endReadAccess(uint32_t readerId, uint32_t offset, uint32_t frames);
+
+    /*!
+     * @brief Request to access a range of channels of an mmap'ed area (channel group access).
+     *
+     * This allows several worker threads to process disjoint channel ranges of the same region in
+     * parallel, e.g. to spread the work for a buffer with many channels across cores. The first group
+     * that begins the access determines the region, all further groups get the same offset and number
+     * of frames. The region is released when all channels of the buffer have been committed via
+     * IasAudioRingBuffer::endChannelGroupAccess(), the number of released frames is the minimum of
+     * the frames committed by all groups.
+     *
+     * Only supported for real buffers with the sync mode eIasRingBuffSyncModeLockFree and at most
+     * cIasAudioRingBufferMaxGroupChannels channels. For read accesses the default reader is used.
+     *
+     * @returns       error code
+     * @retval        eIasRingBuffOk               on success
+     * @retval        eIasRingBuffInvalidParam     one of the parameters is not valid
+     * @retval        eIasRingBuffNotInitialized   component has not been initialized
+     * @retval        eIasRingBuffNotAllowed       not supported by this buffer, or some of the channels are
+     *                                             already accessed by another group
+     *
+     * @param[in]     access        Specifies the access type (either eIasRingBufferAccessRead or eIasRingBufferAccessWrite).
+     * @param[in]     firstChannel  The first channel of the group.
+     * @param[in]     numChannels   The number of channels of the group.
+     * @param[out]    area          Returned mmap areas (one area for each channel of the buffer).
+     * @param[out]    offset        Returned mmap area offset in area steps (== frames).
+     * @param[in,out] frames        mmap area portion size in frames (wanted on entry, contiguous available on exit).
+     */
+    IasAudioRingBufferResult beginChannelGroupAccess(IasRingBufferAccess access, uint32_t firstChannel, uint32_t numChannels,
+                                                     IasAudioArea** area, uint32_t* offset, uint32_t* frames);
+
+    /*!
+     * @brief Declare that a channel group has finished accessing its channels.
+     *
+     * @returns   error code
+     * @retval    eIasRingBuffOk               on success
+     * @retval    eIasRingBuffInvalidParam     one of the parameters is not valid
+     * @retval    eIasRingBuffNotAllowed       the group has not begun the access or has already committed
+     *
+     * @param[in] access        Specifies the access type (either eIasRingBufferAccessRead or eIasRingBufferAccessWrite).
+     * @param[in] firstChannel  The first channel of the group.
+     * @param[in] numChannels   The number of channels of the group.
+     * @param[in] frames        The number of frames that have been processed by this group.
+     */
+    IasAudioRingBufferResult endChannelGroupAccess(IasRingBufferAccess access, uint32_t firstChannel, uint32_t numChannels, uint32_t frames);
+
+    /*!
+     * @brief Bound the latency of the readers by dropping the oldest frames.
+     *
+     * If the fill level seen by a reader exceeds @a maxFillLevel at the beginning of a read access,
+     * the oldest frames are dropped, so that the reader continues at a period boundary with a fill level
+     * of at most @a maxFillLevel. This is useful for interactive audio, where a bounded latency is more
+     * important than the continuity of the samples, e.g. after a stalled reader. Optionally, the first
+     * @a crossfadeFrames frames behind the dropped frames are crossfaded with the dropped frames.
+     * The crossfade modifies the frames in the buffer, so it is only applied while a single reader is
+     * attached, and it is not supported together with eIasRingBuffOverrunOverwrite.
+     *
+     * This method is only relevant for real buffers.
+     *
+     * @param[in] maxFillLevel     The maximum tolerated fill level in frames, 0 disables the latency bound.
+     * @param[in] crossfadeFrames  The length of the crossfade in frames, 0 disables the crossfade.
+     *
+     * @returns eIasRingBuffOk on success, eIasRingBuffNotAllowed for a mirror buffer, or if @a crossfadeFrames
+     *          is not 0 and more than one reader is attached or the overrun mode is eIasRingBuffOverrunOverwrite
+     */
+    IasAudioRingBufferResult setReadLatencyBound(uint32_t maxFillLevel, uint32_t crossfadeFrames = 0);
+
+    /*!
+     * @brief Get the number of frames that have been dropped because of the read latency bound.
+     *
+     * @returns The number of dropped frames since the buffer was created, 0 for mirror buffers.
+     */
+    uint64_t getNumDroppedFrames() const;
+
+    /*!
+     * @brief Get the number of frames a reader has lost, because the writer has overwritten them.
+     *
+     * This only happens with IasAudioRingBufferOptions::overrunMode == eIasRingBuffOverrunOverwrite. A reader
+     * that was lapped by the writer continues with the oldest frames that are still valid.
+     * This method is only relevant for real buffers.
+     *
+     * @param[in]  readerId       The id of the reader, 0 for the default reader.
+     * @param[out] numLostFrames  The number of lost frames since the reader was attached.
+     */
+    IasAudioRingBufferResult getNumLostFrames(uint32_t readerId, uint64_t *numLostFrames) const;
+
+    /*!
+     * @brief Take a snapshot of the statistics of the buffer.
+     *
+     * The statistics are located in the control block of the buffer and are read without locking,
+     * so the snapshot does not delay the audio path.
+     * This method is only relevant for real buffers.
+     *
+     * @param[out] statistics The snapshot of the statistics.
+     *
+     * @returns eIasRingBuffOk on success, eIasRingBuffNotAllowed for mirror buffers.
+     */
+    IasAudioRingBufferResult getStatistics(IasAudioRingBufferStatistics *statistics) const;
+
     /*!
      * @brief Trigger the associated IasFdSignal.
      */
@@ -227,6 +472,23 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBuffer
      */
     IasAudioRingBufferResult getAreas(IasAudioArea** areas) const;
 
+    /*!
+     * @brief Get the user meta data entry of the period that contains a frame.
+     *
+     * There is one entry per period, located in the same memory as the buffer. The writer fills the entry
+     * of the period it writes into between beginAccess() and endAccess(), and a reader gets the same entry
+     * for the offset that its beginAccess() returned, together with the areas. The entry has to be casted
+     * to the user defined meta data struct (see IasMetaDataFactory).
+     * This method is only relevant for real buffers.
+     *
+     * @returns                 eIasRingBuffOk on success, otherwise an error code.
+     * @retval                  eIasRingBuffNotAllowed function is called for a mirror buffer, or the period has no entry
+     *
+     * @param[in]  offset       Offset of a frame in the buffer, e.g. the offset returned by beginAccess()
+     * @param[out] metaData     Returned address of the user meta data entry
+     */
+    IasAudioRingBufferResult getPeriodMetaData(uint32_t offset, void **metaData) const;
+
     /*!
      * @brief Get the data format that is used for representing the PCM samples.
      *
@@ -250,6 +512,15 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBuffer
      */
     IasAudioRingBufferResult waitRead(uint32_t numPeriods, uint32_t timeout_ms);
 
+    /*!
+     * @brief Same as waitRead, but waits for the fill level of the given reader.
+     *
+     * @param[in] readerId            the id of the reader
+     * @param[in] timeout_ms          timeout in ms, must be > 0
+     * @param[in] numPeriods          the desired buffer level, must be > 0 and >= total buffer size
+     */
+    IasAudioRingBufferResult waitRead(uint32_t readerId, uint32_t numPeriods, uint32_t timeout_ms);
+
     /*!
      * @brief function to write to ringbuffer (with timeout) when desired buffer space is available.
      *
@@ -313,6 +584,22 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBuffer
      */
     IasAudioRingBufferResult getTimestamp(IasRingBufferAccess access, IasAudioTimestamp *audioTimestamp) const;
 
+    /*!
+     * @brief Return the most recent period boundaries of the timestamp history.
+     *
+     * Each entry is a pair of frame position and CLOCK_MONOTONIC time in nanoseconds, recorded by the
+     * commit that crossed a period boundary. The history is read without locking and is meant for clock
+     * drift estimation or presentation time queries over the last periods.
+     * This method is only relevant for real buffers.
+     *
+     * @param[in]     access      Specifies whether the history of the read or the write access shall be returned.
+     * @param[out]    entries     Array that receives the entries, the newest entry first.
+     * @param[in,out] numEntries  The size of the array on entry, the number of valid entries on exit.
+     *
+     * @returns eIasRingBuffOk on success, eIasRingBuffNotAllowed for mirror buffers.
+     */
+    IasAudioRingBufferResult getTimestampHistory(IasRingBufferAccess access, IasAudioRingBufferTimestampEntry *entries, uint32_t *numEntries) const;
+
     /*!
      * @brief Set the streaming state of the ring buffer (supported only for real buffers).
      *
@@ -365,6 +652,18 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBuffer
      */
     int64_t getHwPtrWrite() const;
 
+    /*!
+     * @brief Get a consistent snapshot of the offsets, the fill level, the hw ptrs and the timestamps.
+     *
+     * The snapshot is read via a sequence lock, so it never blocks the reader or the writer of the buffer.
+     * Supported only for real buffers.
+     *
+     * @param[out] state The snapshot of the state.
+     *
+     * @returns eIasRingBuffOk on success, eIasRingBuffNotAllowed for mirror buffers.
+     */
+    IasAudioRingBufferResult getState(IasAudioRingBufferState *state) const;
+
     /*!
      * @brief Reset the readOffset and the writeOffset to zero, so that the ring buffer will be empty again.
      *
@@ -387,6 +686,13 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBuffer
      */
     void resetFromReader();
 
+    /*!
+     * @brief Discard all frames that are currently in the buffer for the given reader only.
+     *
+     * @param[in] readerId  The id of the reader.
+     */
+    void resetFromReader(uint32_t readerId);
+
     /*!
      * @brief Set the avail_min value
      *
@@ -449,10 +755,69 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBuffer
      * the content. This can be used in error situations, when a buffer is completely filled and we
      * are not able to insert another period. It would lead to playback of old samples when sometimes later
      * the client tries to read out samples from the buffer.
+     * In eIasRingBuffSyncModeLockFree the content is left unchanged if a read or write access is in progress,
+     * since the method never waits for the reader or the writer.
      */
     void zeroOut();
 
+    /**
+     * @brief Change the geometry of a real buffer in place, see IasAudioRingBufferReal::reconfigure
+     *
+     * Use IasAudioRingBufferFactory::reconfigureRingBuffer, which provides the data memory.
+     * The instances of the other processes update their areas on their next beginAccess.
+     *
+     * @param[in] periodSize The new period size in frames
+     * @param[in] nPeriods   The new number of periods
+     * @param[in] nChannels  The new number of channels
+     * @param[in] dataBuf    The data memory for the new geometry
+     */
+    IasAudioRingBufferResult reconfigure(uint32_t periodSize, uint32_t nPeriods, uint32_t nChannels, void* dataBuf);
+
+    /**
+     * @brief Get the generation of the geometry of a real buffer, 0 for a mirror buffer
+     */
+    uint32_t getGeneration() const;
+
   private:
+    friend class IasAudioRingBufferGroup;   //!< commits the real buffers of the group directly
+    friend class IasAudioRingBufferFactory; //!< binds pooled buffers to the generation of their slot
+
+    /**
+     * @brief Set up the areas for the current geometry of the real buffer
+     *
+     * The areas are allocated once for the maximum number of channels of the real buffer and only
+     * rewritten afterwards, so the pointer handed out by the accesses stays valid.
+     */
+    void updateAreas();
+
+    /**
+     * @brief Update the areas if the real buffer has been reconfigured since the last call
+     *
+     * Has to be called after the access has begun, so that the geometry cannot change until the access ends.
+     * The update is serialized by mMutexAreas, because the channel groups of one buffer may begin their
+     * accesses from several threads.
+     */
+    void checkGeneration();
+
+    /**
+     * @brief Bind the buffer to the generation of its slot in a ring buffer pool
+     *
+     * @param[in] poolGeneration The generation counter of the slot
+     * @param[in] generation     The generation of the slot when the buffer was created or found
+     */
+    void setPoolGeneration(const std::atomic<uint32_t> *poolGeneration, uint32_t generation);
+
+    /**
+     * @brief Check if the buffer has been erased from its pool, the accesses are refused then
+     *
+     * The memory of an erased buffer is kept until this instance is deleted, so the check
+     * cannot race with a concurrent erase.
+     */
+    bool isErasedFromPool() const
+    {
+      return (mPoolGeneration != nullptr) && (mPoolGeneration->load(std::memory_order_acquire) != mExpectedPoolGeneration);
+    }
+
     /*!
      *  @brief Copy constructor, private unimplemented to prevent misuse.
      */
@@ -469,6 +834,10 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBuffer
     bool                       mReal;              //!< flag to indicate if it is a mirror or real buffer
     uint32_t                   mNumChannels;       //!< the number of channels
     std::string                mName;              //!< the name of the ring buffer
+    std::atomic<uint32_t>      mGeneration;        //!< the generation of the real buffer the areas belong to
+    std::mutex                 mMutexAreas;        //!< serializes the updates of mAreas
+    const std::atomic<uint32_t> *mPoolGeneration;  //!< the generation counter of the pool slot, nullptr if not pooled
+    uint32_t                   mExpectedPoolGeneration; //!< the generation of the pool slot when the buffer was created or found
 };
 
 } // namespace Ias
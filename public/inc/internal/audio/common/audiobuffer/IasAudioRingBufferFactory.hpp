@@ -14,8 +14,12 @@
 #define IASAUDIORINGBUFFERFACTORY_HPP_
 
 
+#include <map>
+#include <vector>
 #include "audio/common/IasAudioCommonTypes.hpp"
 #include "internal/audio/common/IasAudioLogging.hpp"
+#include "internal/audio/common/audiobuffer/IasAudioRingBufferTypes.hpp"
+#include "internal/audio/common/audiobuffer/IasAudioRingBufferRegistry.hpp"
 
 namespace IasAudio
 {
@@ -26,8 +30,50 @@ class IasAudioRingBuffer;
 class IasMemoryAllocator;
 class IasAudioSampleBuffer;
 class IasMetaData;
+class IasAudioRingBufferPool;
+class IasAudioRingBufferReal;
 
+/**
+ * @brief The location of a ringbuffer in a pool
+ */
+struct IasPooledRingBuffer
+{
+  IasPooledRingBuffer()
+    :pool(nullptr)
+    ,slot(0)
+    ,generation(0)
+    ,owner(false)
+  {}
+
+  IasAudioRingBufferPool *pool;        //!< The pool that holds the ringbuffer
+  uint32_t                slot;        //!< The directory slot of the ringbuffer
+  uint32_t                generation;  //!< The generation of the slot when the ringbuffer was created or found
+  bool                    owner;       //!< True if the ringbuffer was created via this factory
+};
+
+/**
+ * @brief A ringbuffer of another process, which is kept mapped for the snapshots of its statistics
+ */
+struct IasStatisticsRingBuffer
+{
+  IasStatisticsRingBuffer()
+    :ringBuf(nullptr)
+    ,generation(0)
+  {}
+
+  IasAudioRingBuffer *ringBuf;     //!< The ringbuffer found via findRingBuffer
+  uint32_t            generation;  //!< The registry generation of its own shared memory, 0 for a pooled ringbuffer
+};
+
+using IasStatisticsKey = std::pair<std::string,std::string>; // the pool name (empty for an own shared memory) and the ringbuffer name
 using IasMemoryAllocatorMap = std::map<IasAudioRingBuffer*,IasMemoryAllocator*>;
+using IasDoubleMappedMemoryMap = std::map<IasAudioRingBuffer*,std::pair<void*,size_t>>;
+using IasMemoryReportMap = std::map<IasAudioRingBuffer*,IasMemoryReport>;
+using IasPooledRingBufferMap = std::map<IasAudioRingBuffer*,IasPooledRingBuffer>;
+using IasRingBufferPoolMap = std::map<std::string,IasAudioRingBufferPool*>;
+using IasRegisteredRingBufferMap = std::map<IasAudioRingBuffer*,uint32_t>;
+using IasRegisteredPoolMap = std::map<std::string,uint32_t>;
+using IasStatisticsRingBufferMap = std::map<IasStatisticsKey,IasStatisticsRingBuffer>;
 
 class __attribute__ ((visibility ("default"))) IasAudioRingBufferFactory
 {
@@ -50,6 +96,7 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBufferFactory
      * @param[in] dataLayout interleaved layout or de-interleaved
      * @param[in] shared flag to indicate if buffer shall be located in shared memory
      * @param[in] name the name of the shared memory
+     * @param[in] options additional options, like the synchronization mode or the data layout (ignored for eIasRingBufferLocalMirror)
      *
      * @return cInitFailed FileDescriptor could not be created.
      */
@@ -60,7 +107,33 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBufferFactory
                                           IasAudioCommonDataFormat dataFormat,
                                           IasRingbufferType form,
                                           std::string name,
-                                          std::string groupName = "ias_audio");
+                                          std::string groupName = "ias_audio",
+                                          const IasAudioRingBufferOptions &options = IasAudioRingBufferOptions());
+
+    /**
+     * @brief Change the period size, the number of periods and the number of channels of a ringbuffer in place
+     *
+     * The ringbuffer keeps its name, its shared memory and its fd signal, so the clients do not have
+     * to find it again. If the new geometry fits into the current data memory, that memory is reused,
+     * otherwise new data memory is allocated in the same shared memory segment or pool, which requires
+     * free space there (see IasAudioRingBufferOptions::reserveSize). The content of the ringbuffer is discarded.
+     * The replaced data memory is kept for readers that peeked before (see IasAudioRingBuffer::peek) and is
+     * only released by the next reconfigure that allocates new data memory, so the free space has to hold
+     * the data memory of two geometries in addition to the current one.
+     *
+     * @param[in] ringBuf     The ringbuffer created via createRingBuffer (not double mapped, not a mirror)
+     * @param[in] periodSize  The new period size in frames
+     * @param[in] numPeriods  The new number of periods
+     * @param[in] numChannels The new number of channels, at most IasAudioRingBufferOptions::maxChannels
+     *
+     * @returns eIasResultOk on success, eIasResultMemoryError if there is not enough free space,
+     *          eIasResultInvalidParam if numChannels exceeds the maximum number of channels,
+     *          eIasResultNotAllowed if the ringbuffer cannot be reconfigured right now or at all
+     */
+    IasAudioCommonResult reconfigureRingBuffer(IasAudioRingBuffer* ringBuf,
+                                               uint32_t periodSize,
+                                               uint32_t numPeriods,
+                                               uint32_t numChannels);
 
     /**
      * @brief the function destroys a ringbuffer
@@ -73,8 +146,119 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBufferFactory
      * @brief the function is used to find a ringbuffer in shared memory
      *
      * @param[in] name the name of the shared memory
+     * @param[in] memoryOptions options to prefault and lock the memory in the calling process
+     */
+    IasAudioRingBuffer* findRingBuffer(std::string name, const IasMemoryOptions &memoryOptions = IasMemoryOptions());
+
+    /**
+     * @brief Create a pool, i.e. one shared memory arena for many ringbuffers
+     *
+     * Ringbuffers are created in the pool by setting IasAudioRingBufferOptions::poolName. Creating
+     * or finding them does not need a new shared memory mapping, the name is looked up in the
+     * directory of the pool.
+     *
+     * @param[in] poolName      The name of the shared memory of the pool
+     * @param[in] numSlots      The maximum number of ringbuffers in the pool
+     * @param[in] arenaSize     The size of the arena for the ringbuffers in bytes
+     * @param[in] groupName     The group that gets access to the pool, empty to keep the group of the process
+     * @param[in] memoryOptions Prefaulting, locking and huge pages for the whole arena
+     *
+     * @returns eIasResultOk on success, eIasResultObjectAlreadyExists if the pool is already known to this factory
+     */
+    IasAudioCommonResult createRingBufferPool(const std::string &poolName,
+                                              uint32_t numSlots,
+                                              uint32_t arenaSize,
+                                              const std::string &groupName = "ias_audio",
+                                              const IasMemoryOptions &memoryOptions = IasMemoryOptions());
+
+    /**
+     * @brief Destroy a pool created via createRingBufferPool, or unmap a pool connected via findRingBuffer
+     *
+     * @param[in] poolName The name of the shared memory of the pool
+     *
+     * @returns eIasResultOk on success, eIasResultNotAllowed if ringbuffers of this pool are still in use
+     */
+    IasAudioCommonResult destroyRingBufferPool(const std::string &poolName);
+
+    /**
+     * @brief Find a ringbuffer in a pool
+     *
+     * The pool is mapped on the first call for this pool, all further calls are a lookup in its directory.
+     * Use loseRingBuffer to delete the returned instance. The memory of the ringbuffer is kept until the
+     * returned instance is deleted, even if the creator destroys the ringbuffer in the meantime. All
+     * accesses of the instance return eIasRingBuffNotAllowed then.
+     *
+     * @param[in] poolName The name of the shared memory of the pool
+     * @param[in] name     The name of the ringbuffer
+     *
+     * @returns The ringbuffer, or nullptr if there is no ringbuffer with this name in the pool
+     */
+    IasAudioRingBuffer* findRingBuffer(const std::string &poolName, const std::string &name);
+
+    /**
+     * @brief Check if a pooled ringbuffer has been destroyed or replaced since it was found
+     *
+     * The accesses of a stale ringbuffer are refused anyway, this allows a client to detect it
+     * before the next access and to lose the instance.
+     *
+     * @param[in] ringBuf The ringbuffer created or found via this factory
+     *
+     * @returns true if the directory slot of the ringbuffer changed its generation, false otherwise
+     *          and for ringbuffers that are not located in a pool
+     */
+    bool isStale(IasAudioRingBuffer* ringBuf) const;
+
+    /**
+     * @brief Get the report of the memory options that have been applied to a ringbuffer
+     *
+     * The memory options are given via IasAudioRingBufferOptions when the ringbuffer is created,
+     * or via findRingBuffer. They are applied on a best effort basis, e.g. mlock might fail because
+     * of RLIMIT_MEMLOCK, so the report shows what is actually in effect in the calling process.
+     *
+     * @param[in]  ringBuf The ringbuffer created by createRingBuffer or found by findRingBuffer
+     * @param[out] report  The memory report
+     *
+     * @returns eIasResultOk on success, eIasResultInvalidParam if the ringbuffer is unknown
+     */
+    IasAudioCommonResult getMemoryReport(IasAudioRingBuffer* ringBuf, IasMemoryReport *report) const;
+
+    /**
+     * @brief Get all ringbuffers of this process and the shared ringbuffers of all other processes
+     *
+     * Besides the ringbuffers created or found via this factory, the shared ringbuffers of the other
+     * processes are enumerated via the IasAudioRingBufferRegistry and the directories of their pools.
+     * They are mapped on the first call and kept mapped for the next calls, until they are destroyed
+     * by their creator. These instances are owned by the factory, they must not be lost or destroyed.
+     *
+     * @param[out] ringBuffers The ringbuffers, use IasAudioRingBuffer::getName to identify them
      */
-    IasAudioRingBuffer* findRingBuffer(std::string name);
+    void getRingBuffers(std::vector<IasAudioRingBuffer*> *ringBuffers);
+
+    /**
+     * @brief Take a snapshot of the statistics of a ringbuffer
+     *
+     * @param[in]  ringBuf    The ringbuffer created by createRingBuffer or found by findRingBuffer
+     * @param[out] statistics The snapshot of the statistics
+     *
+     * @returns eIasResultOk on success, eIasResultInvalidParam if the ringbuffer is unknown or a mirror buffer
+     */
+    IasAudioCommonResult getStatistics(IasAudioRingBuffer* ringBuf, IasAudioRingBufferStatistics *statistics) const;
+
+    /**
+     * @brief Take a snapshot of the statistics of a shared ringbuffer by its name
+     *
+     * If the ringbuffer is not known to this factory, e.g. because it was created by another process,
+     * it is looked up in the IasAudioRingBufferRegistry and in the directories of the registered pools.
+     * It is mapped for the first snapshot and kept mapped for the next ones, see getRingBuffers.
+     * The statistics are read without taking any lock of the ringbuffer, so this does not delay the
+     * processes using it.
+     *
+     * @param[in]  name       The name of the shared memory of the ringbuffer, or its name in a pool
+     * @param[out] statistics The snapshot of the statistics
+     *
+     * @returns eIasResultOk on success, eIasResultInvalidParam if no ringbuffer with this name exists
+     */
+    IasAudioCommonResult getStatistics(const std::string &name, IasAudioRingBufferStatistics *statistics);
 
     /**
      * @brief the function is used to "lose" a ringbuffer which was previously retrieved by findRingBuffer
@@ -109,8 +293,110 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBufferFactory
 
     IasAudioCommonResult createMirror(uint32_t numChannels);
 
+    /**
+     * @brief Create the data memory for a ring buffer of type eIasRingBufferLocalDoubleMapped
+     *
+     * The planes are backed by one anonymous memory file. Each plane is mapped
+     * twice back-to-back, so the distance between two planes is 2*planeSize.
+     *
+     * @param[in]  numPlanes   The number of planes (one per channel, or one for the interleaved layout)
+     * @param[in]  planeSize   The size of one plane in bytes, has to be a multiple of the page size
+     * @param[out] dataBuf     The start address of the mapping
+     * @param[out] mappingSize The size of the whole mapping in bytes
+     */
+    IasAudioCommonResult createDoubleMappedMemory(uint32_t numPlanes, size_t planeSize, void **dataBuf, size_t *mappingSize);
+
+    /**
+     * @brief Create a ringbuffer of type eIasRingBufferShared in a pool
+     */
+    IasAudioCommonResult createPooledRingBuffer(IasAudioRingBuffer **ringbuffer,
+                                                uint32_t periodSize,
+                                                uint32_t numPeriods,
+                                                uint32_t numChannels,
+                                                IasAudioCommonDataFormat dataFormat,
+                                                const std::string &name,
+                                                const IasAudioRingBufferOptions &options);
+
+    /**
+     * @brief Get a pool known to this factory, or connect to it
+     */
+    IasAudioRingBufferPool* getRingBufferPool(const std::string &poolName);
+
+    /**
+     * @brief Release the memory of a pooled ringbuffer, which has already been erased from the directory
+     */
+    void releasePooledMemory(IasAudioRingBufferPool *pool, IasAudioRingBufferReal *ringBufReal, IasMetaData *metaData, void *dataBuf);
+
+    /**
+     * @brief Get the registry of the shared memory segments, it is connected on the first call
+     *
+     * @returns The registry, nullptr if it is not available
+     */
+    IasAudioRingBufferRegistry* getRegistry();
+
+    /**
+     * @brief Add a segment created by this factory to the registry, see IasAudioRingBufferRegistry::add
+     *
+     * @returns The generation of the registry entry, 0 if the segment could not be registered
+     */
+    uint32_t registerSegment(const std::string &name, IasAudioRingBufferRegistry::IasSegmentType type);
+
+    /**
+     * @brief Map the shared ringbuffers of the other processes and lose the ones that have been destroyed
+     */
+    void updateStatisticsRingBuffers();
+
+    /**
+     * @brief Check if a ringbuffer has been created or found by this process, besides the mapping for the statistics
+     */
+    bool isLocalRingBuffer(const IasStatisticsKey &key) const;
+
+    /**
+     * @brief Check if a ringbuffer is only mapped for the statistics
+     */
+    bool isStatisticsRingBuffer(IasAudioRingBuffer *ringBuf) const;
+
+    /**
+     * @brief Get the mapping of a ringbuffer of another process for the statistics, map it if required
+     *
+     * @param[in] key        The pool and the name of the ringbuffer
+     * @param[in] generation The registry generation of the shared memory of the ringbuffer, 0 for a pooled ringbuffer
+     *
+     * @returns The ringbuffer, nullptr if it cannot be mapped
+     */
+    IasAudioRingBuffer* getStatisticsRingBuffer(const IasStatisticsKey &key, uint32_t generation);
+
+    /**
+     * @brief Look up a ringbuffer of another process by name in the registry and the registered pools
+     */
+    IasAudioRingBuffer* findStatisticsRingBuffer(const std::string &name);
+
+    /**
+     * @brief Get a registered pool for the statistics, it is connected again if it has been created again
+     */
+    IasAudioRingBufferPool* getStatisticsPool(const std::string &poolName, uint32_t generation);
+
+    /**
+     * @brief Lose the mapping of a ringbuffer for the statistics, if it exists
+     */
+    void loseStatisticsRingBuffer(const IasStatisticsKey &key);
+
+    /**
+     * @brief Lose the mappings for the statistics of all ringbuffers of a pool
+     */
+    void loseStatisticsRingBuffers(const std::string &poolName);
+
 
     IasMemoryAllocatorMap             mMemoryMap; //!< map where the allocated memories and the ringbuffer pointers are stored
+    IasDoubleMappedMemoryMap          mDoubleMappedMemoryMap; //!< map where the data mappings of double mapped ringbuffers are stored
+    IasMemoryReportMap                mMemoryReportMap; //!< map where the applied memory options of the ringbuffers are stored
+    IasPooledRingBufferMap            mPooledRingBufferMap; //!< map where the pool locations of the pooled ringbuffers are stored
+    IasRingBufferPoolMap              mRingBufferPoolMap; //!< map where the created and connected pools are stored
+    IasAudioRingBufferRegistry       *mRegistry;  //!< the registry of the shared memory segments, nullptr until it is needed
+    IasRegisteredRingBufferMap        mRegisteredRingBufferMap; //!< map where the registry generations of the created shared ringbuffers are stored
+    IasRegisteredPoolMap              mRegisteredPoolMap; //!< map where the registry generations of the created pools are stored
+    IasRegisteredPoolMap              mStatisticsPoolMap; //!< map where the registry generations of the pools of other processes are stored
+    IasStatisticsRingBufferMap        mStatisticsMap; //!< map where the ringbuffers of other processes mapped for the statistics are stored
     DltContext                       *mLog;       //!< The DLT log context
 };
 
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2018 Intel Corporation.All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file   IasAudioRingBufferGroup.hpp
+ * @date   2018
+ * @brief  Batched commit of the accesses to a set of real ring buffers.
+ */
+
+#ifndef IASAUDIORINGBUFFERGROUP_HPP_
+#define IASAUDIORINGBUFFERGROUP_HPP_
+
+#include <atomic>
+#include <map>
+#include <vector>
+
+#include "internal/audio/common/audiobuffer/IasAudioRingBufferTypes.hpp"
+#include "internal/audio/common/audiobuffer/IasAudioRingBufferResult.hpp"
+
+namespace IasAudio {
+
+class IasAudioRingBuffer;
+class IasAudioRingBufferReal;
+class IasFdSignal;
+
+/**
+ * @brief Commits the accesses to many real ring buffers of one processing period as a batch
+ *
+ * The accesses are begun as usual via IasAudioRingBuffer::beginAccess, but ended via endAccess of the
+ * group. All commits of one batch get the same timestamp, which is taken by the first commit. The
+ * counterparts are not notified by the commits. flush() notifies every buffer and access direction with
+ * pending commits once and writes every fd signal only once, even if several buffers share it.
+ *
+ * The group is used by a single thread, e.g. the worker thread of the switch matrix.
+ */
+class __attribute__ ((visibility ("default"))) IasAudioRingBufferGroup
+{
+  public:
+    /**
+     * @brief Constructor
+     */
+    IasAudioRingBufferGroup();
+
+    /**
+     * @brief Destructor, flushes the pending notifications
+     */
+    ~IasAudioRingBufferGroup();
+
+    /**
+     * @brief Add a ring buffer to the group
+     *
+     * @param[in] ringBuffer The ring buffer, only real buffers are supported
+     *
+     * @returns eIasRingBuffOk on success, eIasRingBuffInvalidParam if the buffer is already part of the group,
+     *          eIasRingBuffNotAllowed for mirror buffers
+     */
+    IasAudioRingBufferResult add(IasAudioRingBuffer *ringBuffer);
+
+    /**
+     * @brief Remove a ring buffer from the group, pending notifications of the buffer are flushed before
+     *
+     * @param[in] ringBuffer The ring buffer
+     */
+    IasAudioRingBufferResult remove(IasAudioRingBuffer *ringBuffer);
+
+    /**
+     * @brief Get the number of ring buffers of the group
+     */
+    uint32_t getNumRingBuffers() const { return static_cast<uint32_t>(mMembers.size()); };
+
+    /**
+     * @brief End the access to one ring buffer of the group, without notifying the counterpart
+     *
+     * @param[in] ringBuffer The ring buffer
+     * @param[in] access     The access type (read or write)
+     * @param[in] offset     The offset returned by beginAccess
+     * @param[in] frames     The number of frames to commit
+     *
+     * @returns The result of IasAudioRingBufferReal::endAccess, eIasRingBuffInvalidParam if the buffer is not part of the group,
+     *          eIasRingBuffNotAllowed if the buffer has been erased from its pool since it has been added
+     */
+    IasAudioRingBufferResult endAccess(IasAudioRingBuffer *ringBuffer, IasRingBufferAccess access, uint32_t offset, uint32_t frames);
+
+    /**
+     * @brief Notify the counterparts of all commits since the last flush and start a new batch
+     *
+     * Buffers that have been erased from their pool since the commit are not notified.
+     */
+    void flush();
+
+  private:
+    /**
+     * @brief Copy constructor, private unimplemented to prevent misuse.
+     */
+    IasAudioRingBufferGroup(IasAudioRingBufferGroup const &other);
+
+    /**
+     * @brief Assignment operator, private unimplemented to prevent misuse.
+     */
+    IasAudioRingBufferGroup& operator=(IasAudioRingBufferGroup const &other);
+
+    /**
+     * @brief A ring buffer of the group and its pending notifications
+     */
+    struct IasAudioRingBufferGroupMember
+    {
+      IasAudioRingBufferReal       *ringBufReal;            //!< the real buffer
+      const std::atomic<uint32_t>  *poolGeneration;         //!< the generation counter of the pool slot, nullptr if not pooled
+      uint32_t                      expectedPoolGeneration; //!< the generation of the pool slot when the buffer was added
+      bool                          readPending;            //!< frames have been read since the last flush
+      bool                          writePending;           //!< frames have been written since the last flush
+    };
+
+    /**
+     * @brief Check if the buffer of a member has been erased from its pool since it has been added
+     */
+    static bool isErasedFromPool(const IasAudioRingBufferGroupMember &member)
+    {
+      return (member.poolGeneration != nullptr) && (member.poolGeneration->load(std::memory_order_acquire) != member.expectedPoolGeneration);
+    }
+
+    using IasMemberIndexMap = std::map<IasAudioRingBuffer*, uint32_t>;
+
+    std::vector<IasAudioRingBufferGroupMember>  mMembers;       //!< the ring buffers of the group
+    IasMemberIndexMap                           mMemberIndex;   //!< index of each ring buffer in mMembers
+    std::vector<uint32_t>                       mPending;       //!< indices of the members with pending notifications
+    std::vector<IasFdSignal*>                   mFdSignals;     //!< fd signals to write in flush, each one once
+    uint64_t                                    mTimestamp;     //!< the timestamp of the current batch, 0 if no commit happened yet
+};
+
+} // namespace IasAudio
+
+#endif // IASAUDIORINGBUFFERGROUP_HPP_
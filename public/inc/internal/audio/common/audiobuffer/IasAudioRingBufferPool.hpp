@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2018 Intel Corporation.All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file   IasAudioRingBufferPool.hpp
+ * @date   2018
+ * @brief  Shared memory arena that holds many real ring buffers and a directory to find them by name.
+ */
+
+#ifndef IASAUDIORINGBUFFERPOOL_HPP_
+#define IASAUDIORINGBUFFERPOOL_HPP_
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <boost/interprocess/offset_ptr.hpp>
+
+#include "audio/common/IasAudioCommonTypes.hpp"
+#include "audio/common/audiobuffer/IasMemoryAllocator.hpp"
+#include "internal/audio/common/IasIntProcMutex.hpp"
+
+namespace IasAudio {
+
+class IasAudioRingBufferReal;
+class IasMetaData;
+
+/*
+ * Maximum length of the name of a ring buffer in a pool, including the terminating zero.
+ */
+static const uint32_t cIasAudioRingBufferPoolMaxNameLength = 64;
+
+/**
+ * @brief One shared memory segment (arena) for many real ring buffers
+ *
+ * The arena is created once with a fixed number of directory slots. The directory maps the
+ * names of the ring buffers to slots by open addressing, so a ring buffer is found by hashing
+ * its name and probing a few slots, without a new mapping and without a lock. Each slot has a
+ * generation counter, which is incremented whenever a ring buffer is inserted into or erased
+ * from the slot, so a cached handle can detect that it became stale. The memory of an erased ring
+ * buffer is only released when the last client that attached to its slot has detached, so a stale
+ * handle never accesses recycled memory.
+ */
+class __attribute__ ((visibility ("default"))) IasAudioRingBufferPool
+{
+  public:
+    /**
+     * @brief One entry of the directory, located in the arena
+     */
+    struct IasAudioRingBufferPoolSlot
+    {
+      IasAudioRingBufferPoolSlot();
+
+      std::atomic<uint32_t>                                    state;        //!< eIasSlotEmpty, eIasSlotUsed or eIasSlotErased
+      std::atomic<uint32_t>                                    generation;   //!< incremented on every insert and erase
+      uint32_t                                                 numClients;   //!< number of attached clients, protected by the mutex
+      uint32_t                                                 nameHash;     //!< hash of the name
+      char                                                     name[cIasAudioRingBufferPoolMaxNameLength];
+      boost::interprocess::offset_ptr<IasAudioRingBufferReal>  ringBufReal;  //!< the real ring buffer
+      boost::interprocess::offset_ptr<IasMetaData>             metaData;     //!< the meta data of the ring buffer
+      boost::interprocess::offset_ptr<void>                    dataBuf;      //!< the PCM data of the ring buffer
+    };
+
+    /**
+     * @brief The state of a directory slot
+     */
+    enum IasSlotState
+    {
+      eIasSlotEmpty = 0,  //!< never used, ends a probe sequence
+      eIasSlotUsed,       //!< holds a ring buffer
+      eIasSlotErased,     //!< held a ring buffer, does not end a probe sequence
+      eIasSlotRetired     //!< erased, but the memory is kept until the last client detached
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param[in] name The name of the shared memory segment
+     */
+    IasAudioRingBufferPool(const std::string &name);
+
+    /**
+     * @brief Destructor, unmaps the arena and removes it if it was created by this instance
+     */
+    ~IasAudioRingBufferPool();
+
+    /**
+     * @brief Create or connect to the arena
+     *
+     * @param[in] flag          eIasCreate to create the arena, eIasConnect to map an existing one
+     * @param[in] numSlots      The number of directory slots (only for eIasCreate)
+     * @param[in] arenaSize     The size of the arena in bytes (only for eIasCreate)
+     * @param[in] groupName     The group that gets access to the arena (only for eIasCreate)
+     * @param[in] memoryOptions Prefaulting, locking and huge pages for the arena
+     */
+    IasAudioCommonResult init(IasMemoryAllocator::IasOpenFlag flag, uint32_t numSlots, uint32_t arenaSize,
+                              const std::string &groupName, const IasMemoryOptions &memoryOptions);
+
+    /**
+     * @brief Get the memory allocator of the arena
+     */
+    IasMemoryAllocator* getAllocator() { return mMemory; };
+
+    /**
+     * @brief Insert a ring buffer into the directory
+     *
+     * @param[in]  name        The name of the ring buffer
+     * @param[in]  ringBufReal The real ring buffer, allocated in the arena
+     * @param[in]  metaData    The meta data, allocated in the arena
+     * @param[in]  dataBuf     The PCM data, allocated in the arena
+     * @param[out] slot        The index of the slot
+     * @param[out] generation  The generation of the slot after the insert
+     *
+     * @returns eIasResultOk on success, eIasResultAlreadyInitialized if the name is already used,
+     *          eIasResultMemoryError if all slots are used, eIasResultInvalidParam if the name is too long
+     */
+    IasAudioCommonResult insert(const std::string &name, IasAudioRingBufferReal *ringBufReal, IasMetaData *metaData,
+                                void *dataBuf, uint32_t *slot, uint32_t *generation);
+
+    /**
+     * @brief Find a ring buffer in the directory
+     *
+     * @param[in]  name        The name of the ring buffer
+     * @param[out] slot        The index of the slot
+     * @param[out] ringBufReal The real ring buffer
+     * @param[out] generation  The generation of the slot
+     *
+     * @returns eIasResultOk on success, eIasResultObjectNotFound if there is no ring buffer with this name
+     */
+    IasAudioCommonResult lookup(const std::string &name, uint32_t *slot, IasAudioRingBufferReal **ringBufReal, uint32_t *generation) const;
+
+    /**
+     * @brief Get the names of all ring buffers in the directory, e.g. to take snapshots of their statistics
+     *
+     * @param[out] names The names of the ring buffers, erased and retired ones are not included
+     */
+    void getNames(std::vector<std::string> *names) const;
+
+    /**
+     * @brief Erase a ring buffer from the directory
+     *
+     * The memory of the ring buffer is not released, the caller deallocates it via getAllocator.
+     * If clients are still attached to the slot, the slot is retired instead and all output
+     * parameters are set to nullptr. The memory is then handed out by the detach of the last client.
+     *
+     * @param[in]  slot        The index of the slot
+     * @param[out] ringBufReal The real ring buffer of the slot
+     * @param[out] metaData    The meta data of the slot
+     * @param[out] dataBuf     The PCM data of the slot
+     */
+    IasAudioCommonResult erase(uint32_t slot, IasAudioRingBufferReal **ringBufReal, IasMetaData **metaData, void **dataBuf);
+
+    /**
+     * @brief Attach a client to a slot, so that the memory of the slot is kept until the client detaches
+     *
+     * @param[in] slot       The index of the slot
+     * @param[in] generation The generation of the slot returned by lookup
+     *
+     * @returns eIasResultOk on success, eIasResultObjectNotFound if the ring buffer has been erased since the lookup
+     */
+    IasAudioCommonResult attach(uint32_t slot, uint32_t generation);
+
+    /**
+     * @brief Detach a client from a slot
+     *
+     * If the slot has been erased and this was the last client, the memory of the ring buffer is
+     * handed out and the caller deallocates it via getAllocator. Otherwise all output parameters
+     * are set to nullptr.
+     *
+     * @param[in]  slot        The index of the slot
+     * @param[out] ringBufReal The real ring buffer of the slot
+     * @param[out] metaData    The meta data of the slot
+     * @param[out] dataBuf     The PCM data of the slot
+     */
+    IasAudioCommonResult detach(uint32_t slot, IasAudioRingBufferReal **ringBufReal, IasMetaData **metaData, void **dataBuf);
+
+    /**
+     * @brief Replace the PCM data of a slot after the ring buffer has been reconfigured
+     *
+     * The generation is not changed, because the real ring buffer stays the same.
+     *
+     * @param[in] slot    The index of the slot
+     * @param[in] dataBuf The new PCM data, allocated in the arena
+     */
+    IasAudioCommonResult setDataBuffer(uint32_t slot, void *dataBuf);
+
+    /**
+     * @brief Get the current generation of a slot
+     */
+    uint32_t getGeneration(uint32_t slot) const;
+
+    /**
+     * @brief Get the generation counter of a slot, to check for a stale handle without a lookup
+     */
+    const std::atomic<uint32_t>* getGenerationCounter(uint32_t slot) const;
+
+    /**
+     * @brief Get a unique id for the names of the objects of a new ring buffer in the arena
+     *
+     * A retired ring buffer keeps its named objects until its last client detached, so the objects
+     * of a new ring buffer with the same name need other names.
+     */
+    uint32_t getNextObjectId();
+
+  private:
+    /**
+     * @brief Copy constructor, private unimplemented to prevent misuse.
+     */
+    IasAudioRingBufferPool(IasAudioRingBufferPool const &other);
+
+    /**
+     * @brief Assignment operator, private unimplemented to prevent misuse.
+     */
+    IasAudioRingBufferPool& operator=(IasAudioRingBufferPool const &other);
+
+    /**
+     * @brief The header of the directory, located in the arena
+     */
+    struct IasAudioRingBufferPoolHeader
+    {
+      IasAudioRingBufferPoolHeader();
+
+      uint32_t                numSlots;   //!< the number of slots
+      std::atomic<uint32_t>   objectId;   //!< the last id handed out by getNextObjectId
+      IasIntProcMutex         mutex;      //!< serializes insert, erase, attach and detach, lookup does not need it
+    };
+
+    /**
+     * @brief FNV-1a hash of the name
+     */
+    static uint32_t hashName(const std::string &name);
+
+    /**
+     * @brief Hand out the memory of a slot and mark it as erased, the mutex has to be locked
+     */
+    static void releaseSlot(IasAudioRingBufferPoolSlot &entry, IasAudioRingBufferReal **ringBufReal, IasMetaData **metaData, void **dataBuf);
+
+    std::string                   mName;      //!< the name of the shared memory segment
+    IasMemoryAllocator           *mMemory;    //!< the allocator of the arena
+    IasAudioRingBufferPoolHeader *mHeader;    //!< the header of the directory
+    IasAudioRingBufferPoolSlot   *mSlots;     //!< the slots of the directory
+};
+
+} // namespace IasAudio
+
+#endif // IASAUDIORINGBUFFERPOOL_HPP_
@@ -18,7 +18,7 @@
 
 #include "internal/audio/common/audiobuffer/IasAudioRingBufferTypes.hpp"
 #include "internal/audio/common/audiobuffer/IasAudioRingBufferResult.hpp"
-#include "internal/audio/common/IasIntProcCondVar.hpp"
+#include "internal/audio/common/IasIntProcFutex.hpp"
 #include "internal/audio/common/IasIntProcMutex.hpp"
 
 namespace IasAudio {
@@ -53,43 +53,327 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBufferReal
                                   IasAudioCommonDataFormat dataFormat,
                                   void* dataBuf,
                                   bool shared,
-                                  IasMetaData* metaData);
+                                  IasMetaData* metaData,
+                                  const IasAudioRingBufferOptions &options = IasAudioRingBufferOptions(),
+                                  bool doubleMapped = false);
 
     IasAudioRingBufferResult updateAvailable(IasRingBufferAccess access, uint32_t *samples);
 
-    IasAudioRingBufferResult beginAccess(IasRingBufferAccess access, uint32_t* offset, uint32_t* frames);
+    /**
+     * @brief Begin the access to the buffer
+     *
+     * @param[in]     access      The access type (read or write)
+     * @param[out]    offset      The offset of the accessible region in frames
+     * @param[in,out] frames      The wanted number of frames on entry, the accessible number of frames on exit
+     * @param[in]     wrapAround  If true, the accessible region may wrap around the end of the buffer,
+     *                            i.e. it is not clamped to the end of the buffer. The frames beyond the end
+     *                            are located at the beginning of the buffer.
+     */
+    IasAudioRingBufferResult beginAccess(IasRingBufferAccess access, uint32_t* offset, uint32_t* frames, bool wrapAround = false);
 
     IasAudioRingBufferResult endAccess(IasRingBufferAccess access, uint32_t offset, uint32_t frames);
 
+    /**
+     * @brief End the access to the buffer with a given timestamp and optionally without notifying the counterpart
+     *
+     * This is used by IasAudioRingBufferGroup to commit many buffers with one timestamp and to issue the
+     * notifications afterwards via notifyAccess.
+     *
+     * @param[in] access     The access type (read or write)
+     * @param[in] offset     The offset returned by beginAccess
+     * @param[in] frames     The number of frames to commit
+     * @param[in] timestamp  The timestamp of the commit in microseconds since epoch, see getCurrentTimestamp
+     * @param[in] notify     If false, the waiting counterpart is neither woken up nor signalled
+     */
+    IasAudioRingBufferResult endAccess(IasRingBufferAccess access, uint32_t offset, uint32_t frames, uint64_t timestamp, bool notify);
+
+    /**
+     * @brief Wake up the counterpart of a committed access, if its threshold is reached
+     *
+     * @param[in] access The access type of the commit (read or write)
+     *
+     * @returns The fd signal that has to be written to wake up the ALSA plugin client, or nullptr if
+     *          there is no need to signal. The caller writes it once, even if it is returned for several commits.
+     */
+    IasFdSignal* notifyAccess(IasRingBufferAccess access);
+
+    /**
+     * @brief Get the current time in microseconds since epoch, the time base of IasAudioTimestamp
+     */
+    static uint64_t getCurrentTimestamp();
+
+    /**
+     * @brief Get a region of readable frames without consuming them
+     *
+     * The read flag of the default reader is held while the region is determined, so the region always
+     * belongs to the returned generation. The call fails with eIasRingBuffNotAllowed if a read access is in
+     * progress, in eIasRingBuffSyncModeLockFree also during a reconfigure. Frames that exceed the read latency
+     * bound are dropped and overwritten frames are skipped here, like at the begin of a read access.
+     *
+     * @param[in]     offsetFromRead  The distance of the region from the current read position in frames
+     * @param[out]    offset          The offset of the region in frames
+     * @param[in,out] frames          The wanted number of frames on entry, the number of readable frames on exit.
+     *                                The region is clamped to the end of the buffer, unless the buffer is double mapped.
+     * @param[out]    generation      The generation of the geometry the region belongs to
+     */
+    IasAudioRingBufferResult peek(uint32_t offsetFromRead, uint32_t* offset, uint32_t* frames, uint32_t* generation);
+
+    /**
+     * @brief Consume frames without accessing them, e.g. after they have been read via peek
+     *
+     * Advances exactly over the given frames, no frames are dropped for the read latency bound. Returns
+     * eIasRingBuffDataOverwritten if the writer has overwritten frames of them since they have been peeked.
+     *
+     * @param[in] frames The number of frames to consume, must not exceed the fill level
+     */
+    IasAudioRingBufferResult consume(uint32_t frames);
+
+    /**
+     * @brief Attach an additional reader to the buffer (broadcast)
+     *
+     * Only supported for eIasRingBuffSyncModeLockFree. Each attached reader has its own read position,
+     * which starts at the current write position. The free space for the writer is limited by the slowest
+     * attached reader. Reader 0 is the default reader used by the read accesses without reader id, it is
+     * attached by init and may be detached, too.
+     *
+     * @param[out] readerId The id of the attached reader
+     *
+     * @returns eIasRingBuffOk on success, eIasRingBuffNotAllowed if the sync mode does not support several
+     *          readers or all reader slots are in use
+     */
+    IasAudioRingBufferResult attachReader(uint32_t *readerId);
+
+    /**
+     * @brief Detach a reader, so that it no longer limits the free space of the writer
+     *
+     * Has to be called by the reader itself, while it has no read access in progress.
+     *
+     * @param[in] readerId The id of the reader returned by attachReader
+     */
+    IasAudioRingBufferResult detachReader(uint32_t readerId);
+
+    /**
+     * @brief Reader specific variants of updateAvailable, beginAccess, endAccess, waitRead and resetFromReader
+     *
+     * These do the same as the methods without reader id, but use the read position of the given reader.
+     * In eIasRingBuffSyncModeMutex only reader 0 is available. The hw pointer and the read timestamp are
+     * only updated by reader 0.
+     */
+    IasAudioRingBufferResult updateAvailableRead(uint32_t readerId, uint32_t *samples);
+    IasAudioRingBufferResult beginReadAccess(uint32_t readerId, uint32_t* offset, uint32_t* frames, bool wrapAround = false);
+    IasAudioRingBufferResult endReadAccess(uint32_t readerId, uint32_t offset, uint32_t frames);
+    IasAudioRingBufferResult endReadAccess(uint32_t readerId, uint32_t offset, uint32_t frames, uint64_t timestamp, bool notify);
+    IasAudioRingBufferResult waitRead(uint32_t readerId, uint32_t numPeriods, uint32_t timeout_ms);
+    void resetFromReader(uint32_t readerId);
+
+    /**
+     * @brief Begin the access to a range of channels of the current period (channel group access)
+     *
+     * Several threads can access disjoint channel ranges of the same region in parallel. The first group
+     * that begins the access starts a regular access for all channels, all further groups get the same
+     * offset and number of frames. The access is committed when all channels of the buffer have been
+     * committed via endChannelGroupAccess, using the minimum number of frames of all groups.
+     * Only supported for eIasRingBuffSyncModeLockFree and for at most cIasAudioRingBufferMaxGroupChannels channels.
+     *
+     * @param[in]     access        The access type (read or write)
+     * @param[in]     firstChannel  The first channel of the group
+     * @param[in]     numChannels   The number of channels of the group
+     * @param[out]    offset        The offset of the accessible region in frames
+     * @param[in,out] frames        The wanted number of frames on entry (only used by the first group), the accessible number of frames on exit
+     */
+    IasAudioRingBufferResult beginChannelGroupAccess(IasRingBufferAccess access, uint32_t firstChannel, uint32_t numChannels,
+                                                     uint32_t* offset, uint32_t* frames);
+
+    /**
+     * @brief End the access to a range of channels that was started via beginChannelGroupAccess
+     *
+     * @param[in] access        The access type (read or write)
+     * @param[in] firstChannel  The first channel of the group
+     * @param[in] numChannels   The number of channels of the group
+     * @param[in] frames        The number of frames that have been processed for this group
+     */
+    IasAudioRingBufferResult endChannelGroupAccess(IasRingBufferAccess access, uint32_t firstChannel, uint32_t numChannels, uint32_t frames);
+
+    /**
+     * @brief Set the latency bound for the readers
+     *
+     * If the fill level seen by a reader exceeds maxFillLevel at the beginning of a read access, the
+     * oldest frames are dropped, so that the read position continues at a period boundary and the
+     * fill level is not above maxFillLevel anymore. Optionally the first crossfadeFrames frames after
+     * the dropped frames are crossfaded with the dropped frames to avoid a click.
+     * The crossfade modifies the frames in the buffer, so it is only applied while a single reader is
+     * attached, and it is not supported together with eIasRingBuffOverrunOverwrite.
+     *
+     * @param[in] maxFillLevel     The maximum tolerated fill level in frames, 0 disables the latency bound
+     * @param[in] crossfadeFrames  The length of the crossfade in frames, 0 disables the crossfade
+     *
+     * @returns eIasRingBuffOk on success, eIasRingBuffNotAllowed if crossfadeFrames is not 0 and more than
+     *          one reader is attached or the overrun mode is eIasRingBuffOverrunOverwrite
+     */
+    IasAudioRingBufferResult setReadLatencyBound(uint32_t maxFillLevel, uint32_t crossfadeFrames = 0);
+
+    /**
+     * @brief Get the number of frames that have been dropped by the read latency bound since init
+     */
+    uint64_t getNumDroppedFrames() const { return mNumDroppedFrames.load(std::memory_order_relaxed); };
+
+    /**
+     * @brief Get the number of frames a reader has lost, because the writer overwrote them (eIasRingBuffOverrunOverwrite)
+     *
+     * A reader that was lapped by the writer continues with the oldest frames that are still in the buffer.
+     * The skipped frames, as well as the frames of a read access that were overwritten while they were read
+     * (the end of such an access returns eIasRingBuffDataOverwritten), are counted here.
+     *
+     * @param[in]  readerId       The id of the reader, 0 for the default reader
+     * @param[out] numLostFrames  The number of frames lost since the reader was attached
+     */
+    IasAudioRingBufferResult getNumLostFrames(uint32_t readerId, uint64_t *numLostFrames) const;
+
     void triggerFdSignal();
 
     IasAudioRingBufferResult getDataFormat(IasAudioCommonDataFormat *dataFormat) const;
 
     uint32_t getNumChannels(){return mNumChannels;};
 
+    /**
+     * @brief Get the maximum number of channels, a reconfigure cannot exceed it
+     */
+    uint32_t getNumChannelsMax() const {return mNumChannelsMax;};
+
     void* getDataBuffer(){return mDataBuf.get();};
 
+    /**
+     * @brief Get the user meta data entry of the period that contains a frame
+     *
+     * The meta data array handed over to init provides one entry per period. The entry of a period belongs
+     * to the side that owns the frames of the period, just like the samples: the writer fills it between
+     * beginAccess and endAccess, and after the commit the readers get the same entry for the offset returned
+     * by their beginAccess. The entry has to be casted to the user defined struct, see IasMetaDataFactory.
+     *
+     * @param[in]  offset    The offset of a frame in the buffer, e.g. the offset returned by beginAccess
+     * @param[out] metaData  The address of the user meta data entry in the memory of the calling process
+     *
+     * @returns eIasRingBuffOk on success, eIasRingBuffNotAllowed if the period has no entry, because the
+     *          buffer was reconfigured to more periods than entries exist
+     */
+    IasAudioRingBufferResult getPeriodMetaData(uint32_t offset, void **metaData) const;
+
     uint32_t getSampleSize(){return mSampleSize;};
 
     uint32_t getPeriodSize() const;
 
     uint32_t getNumberPeriods() const;
 
+    /**
+     * @brief Get the distance between the first samples of two consecutive channels in bytes
+     */
+    uint32_t getPlaneStride() const;
+
+    /**
+     * @brief Get the distance between two consecutive samples of one channel in bytes
+     */
+    uint32_t getFrameStride() const;
+
+    /**
+     * @brief Get the padding between two channel planes in bytes, which is part of the plane stride
+     */
+    uint32_t getPlanePadding() const { return mPlanePadding; };
+
+    /**
+     * @brief Calculate the padding between two channel planes
+     *
+     * @param[in] planeSize      The size of one plane in bytes
+     * @param[in] requested      The requested padding in bytes, or cIasAudioRingBufferPlanePaddingAuto
+     *
+     * @returns The padding in bytes
+     */
+    static uint32_t calculatePlanePadding(uint32_t planeSize, uint32_t requested);
+
+    /**
+     * @brief Calculate the size of the data memory of a buffer in the non-interleaved layout, including the padding
+     *
+     * @param[in] planeSize      The size of one plane in bytes
+     * @param[in] numChannels    The number of channels
+     * @param[in] requested      The requested padding in bytes, or cIasAudioRingBufferPlanePaddingAuto
+     *
+     * @returns The size in bytes
+     */
+    static uint32_t calculateDataSize(uint32_t planeSize, uint32_t numChannels, uint32_t requested);
+
+    /**
+     * @brief Get the size of the data memory that is needed for a geometry with the data format, layout and padding of this buffer
+     *
+     * @param[in] periodSize The period size in frames
+     * @param[in] nPeriods   The number of periods
+     * @param[in] nChannels  The number of channels
+     *
+     * @returns The size in bytes
+     */
+    uint32_t getDataSize(uint32_t periodSize, uint32_t nPeriods, uint32_t nChannels) const;
+
+    IasAudioCommonDataLayout getDataLayout() const { return mDataLayout; };
+
+    /**
+     * @brief Returns true if each channel plane is mapped twice back-to-back (eIasRingBufferLocalDoubleMapped)
+     */
+    bool isDoubleMapped() const { return mDoubleMapped; };
+
+    IasAudioRingBufferSyncMode getSyncMode() const { return mSyncMode; };
+
     IasAudioRingBufferResult waitWrite(uint32_t numPeriods, uint32_t timeout_ms);
 
     IasAudioRingBufferResult waitRead(uint32_t numPeriods, uint32_t timeout_ms);
 
     IasAudioRingBufferResult getTimestamp(IasRingBufferAccess access, IasAudioTimestamp *audioTimestamp);
 
+    /**
+     * @brief Get the most recent entries of the timestamp history
+     *
+     * Each commit that moves the frame position of an access direction across a period boundary records
+     * the pair (frame position, CLOCK_MONOTONIC nanoseconds). In eIasRingBuffSyncModeLockFree the read
+     * history belongs to reader 0. The history can be read from any process without taking a lock, e.g.
+     * to estimate the clock drift by a regression over the last periods.
+     *
+     * @param[in]     access      The access type (read or write)
+     * @param[out]    entries     Array that receives the entries, the newest entry first
+     * @param[in,out] numEntries  The size of the array on entry, the number of valid entries on exit
+     */
+    IasAudioRingBufferResult getTimestampHistory(IasRingBufferAccess access, IasAudioRingBufferTimestampEntry *entries, uint32_t *numEntries) const;
+
+    IasAudioRingBufferClockSource getClockSource() const { return mClockSource; };
+
+    /**
+     * @brief Take a snapshot of the statistics of the buffer
+     *
+     * The counters are updated with relaxed atomics on the data path and are read without lock,
+     * so this can be called from any process that has mapped the buffer. The single counters are
+     * consistent by themselves, but not necessarily with each other.
+     *
+     * @param[out] statistics The snapshot of the statistics
+     */
+    IasAudioRingBufferResult getStatistics(IasAudioRingBufferStatistics *statistics) const;
+
     void setStreamingState(IasAudioRingBufferStreamingState streamingState) { mStreamingState = streamingState; };
 
     IasAudioRingBufferStreamingState getStreamingState() { return mStreamingState; };
 
-    uint32_t getReadOffset() { return mReadOffset; };
-    uint32_t getWriteOffset() { return mWriteOffset; };
+    /**
+     * @brief Get a consistent snapshot of offsets, fill level, hw pointers and timestamps
+     *
+     * The reader and the writer side publish their state through one sequence lock each and the fill
+     * level is derived from the frame counters, so this never blocks the reader or the writer of the
+     * buffer and can be called from any process. The fill level might be slightly newer than the
+     * offsets and the hw pointers.
+     *
+     * @param[out] state The snapshot of the state
+     */
+    IasAudioRingBufferResult getState(IasAudioRingBufferState *state) const;
+
+    uint32_t getReadOffset() const { return mPublishedRead.offset.load(std::memory_order_relaxed); };
+    uint32_t getWriteOffset() const { return mPublishedWrite.offset.load(std::memory_order_relaxed); };
 
-    int64_t getHwPtrRead() { return mHwPtrRead; };
-    int64_t getHwPtrWrite() { return mHwPtrWrite; };
+    int64_t getHwPtrRead() const { return mPublishedRead.hwPtr.load(std::memory_order_relaxed); };
+    int64_t getHwPtrWrite() const { return mPublishedWrite.hwPtr.load(std::memory_order_relaxed); };
 
     void resetFromWriter();
     void resetFromReader();
@@ -103,9 +387,51 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBufferReal
      * the content. This can be used in error situations, when a buffer is completely filled and we
      * are not able to insert another period. It would lead to playback of old samples when sometimes later
      * the client tries to read out samples from the buffer.
+     * In eIasRingBuffSyncModeLockFree the content is left unchanged if a read or write access is in progress,
+     * since the method never waits for the reader or the writer.
      */
     void zeroOut();
 
+    /**
+     * @brief Change the geometry of the buffer in place
+     *
+     * The new geometry is swapped in between two accesses, i.e. on a period boundary of the
+     * clients. The content of the buffer is discarded and the read and write positions restart at zero.
+     * The data format, the data layout and the synchronization mode are not changed. Every call
+     * increments the generation, which the IasAudioRingBuffer instances of all processes check on
+     * their next beginAccess to update their areas.
+     *
+     * In eIasRingBuffSyncModeMutex the call waits until the current read and write accesses are finished.
+     * In eIasRingBuffSyncModeLockFree it does not wait, but fails with eIasRingBuffNotAllowed if an
+     * access is in progress, so it can be retried after the next period. Accesses that begin while the
+     * geometry is swapped fail with eIasRingBuffNotAllowed as well.
+     *
+     * @param[in] periodSize The new period size in frames
+     * @param[in] nPeriods   The new number of periods
+     * @param[in] nChannels  The new number of channels, at most getNumChannelsMax()
+     * @param[in] dataBuf    The data memory for the new geometry, which may be the current data memory if it is large enough
+     *
+     * @returns eIasRingBuffOk on success, eIasRingBuffNotAllowed for a double mapped buffer or if an access is in progress,
+     *          eIasRingBuffInvalidParam if nChannels exceeds the maximum number of channels
+     */
+    IasAudioRingBufferResult reconfigure(uint32_t periodSize, uint32_t nPeriods, uint32_t nChannels, void* dataBuf);
+
+    /**
+     * @brief Get the generation of the geometry, incremented by every reconfigure
+     */
+    uint32_t getGeneration() const { return mGeneration.load(std::memory_order_acquire); };
+
+    /**
+     * @brief Get the data memory that has been replaced by a reconfigure
+     *
+     * A reader that peeked before the reconfigure may still read from it until it peeks again, so the
+     * creator releases it only on the next reconfigure that replaces the data memory, or together with
+     * the buffer.
+     *
+     * @returns The replaced data memory, nullptr if the data memory has never been replaced
+     */
+    void* getRetiredDataBuffer() { return mRetiredDataBuf.get(); };
+
     /*!
      * @brief Set the avail_min value
      *
@@ -159,6 +485,263 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBufferReal
      */
     IasAudioRingBufferReal& operator=(IasAudioRingBufferReal const &other);
 
+    /**
+     * @brief The state of one reader in eIasRingBuffSyncModeLockFree
+     */
+    struct IasAudioRingBufferReader
+    {
+      IasAudioRingBufferReader();
+
+      std::atomic<bool>       attached;        //!< the slot is used by a reader
+      std::atomic<bool>       readInProgress;  //!< a read access of this reader is in progress
+      bool                    wrapAround;      //!< the current read access may wrap around the end of the buffer
+      uint32_t                readOffset;      //!< the read offset of this reader (frames)
+      std::atomic<uint64_t>   readCount;       //!< monotonically increasing read position (frames)
+      uint64_t                readCountBegin;  //!< read position at the last beginAccess
+      std::atomic<uint64_t>   numLostFrames;   //!< frames overwritten by the writer before this reader got them
+      IasIntProcFutex         futex;           //!< wakes up this reader waiting in waitRead
+    };
+
+    /**
+     * @brief The state of the channel group accesses of one access type
+     */
+    struct IasAudioRingBufferChannelGroups
+    {
+      IasAudioRingBufferChannelGroups();
+
+      uint64_t                beganMask;        //!< the channels for which the access has begun
+      uint64_t                committedMask;    //!< the channels for which the access has been committed
+      uint32_t                offset;           //!< the offset of the common region
+      uint32_t                frames;           //!< the number of frames of the common region
+      uint32_t                committedFrames;  //!< the minimum number of frames committed by the groups so far
+    };
+
+    /**
+     * @brief One slot of the timestamp history
+     *
+     * The sequence is 0 while the slot is written and the running number of the entry (starting at 1)
+     * afterwards, so a reader can detect that the slot has been overwritten while it was read.
+     */
+    struct IasAudioRingBufferTimestampSlot
+    {
+      IasAudioRingBufferTimestampSlot();
+
+      std::atomic<uint64_t>   sequence;        //!< running number of the entry, 0 while the slot is written
+      std::atomic<uint64_t>   framePosition;   //!< see IasAudioRingBufferTimestampEntry
+      std::atomic<uint64_t>   timestampNs;     //!< see IasAudioRingBufferTimestampEntry
+    };
+
+    /**
+     * @brief The timestamp history of one access direction, written only by the committing side
+     */
+    struct IasAudioRingBufferTimestampHistory
+    {
+      IasAudioRingBufferTimestampHistory();
+
+      uint64_t                          framePosition;  //!< frames transferred since init
+      std::atomic<uint64_t>             numEntries;     //!< number of entries recorded since init
+      IasAudioRingBufferTimestampSlot   slots[cIasAudioRingBufferTimestampHistorySize];
+    };
+
+    /**
+     * @brief The copy of the state of one access direction, see IasAudioRingBufferState
+     *
+     * Each direction has its own sequence lock with a single writer, the reader or the writer side.
+     */
+    struct IasAudioRingBufferPublishedState
+    {
+      IasAudioRingBufferPublishedState();
+
+      std::atomic<uint32_t>   sequence;   //!< Sequence lock of the fields below, odd while they are written
+      std::atomic<uint32_t>   offset;
+      std::atomic<int64_t>    hwPtr;
+      std::atomic<uint64_t>   timestamp;
+      std::atomic<uint64_t>   frames;
+    };
+
+    /**
+     * @brief Publish the state of one access direction
+     *
+     * The reader side only writes the read state and the writer side only writes the write state,
+     * so a publisher never waits, neither for the other side nor for a snapshot reader.
+     * The fill level is not published, getState derives it from the frame counters.
+     *
+     * @param[in] access The access direction whose state has changed, eIasRingBufferAccessUndef for both
+     */
+    void publishState(IasRingBufferAccess access);
+
+    /**
+     * @brief Write the state of one access direction under its sequence lock
+     */
+    static void publishDirection(IasAudioRingBufferPublishedState &published, uint32_t offset, int64_t hwPtr,
+                                 const IasAudioTimestamp &timestamp);
+
+
+    /**
+     * @brief The counters of one access direction, see IasAudioRingBufferAccessStatistics
+     */
+    struct IasAudioRingBufferAccessCounters
+    {
+      IasAudioRingBufferAccessCounters();
+
+      std::atomic<uint64_t>   numCommits;
+      std::atomic<uint64_t>   numFrames;
+      std::atomic<uint64_t>   numXruns;
+      std::atomic<uint64_t>   numErrors;
+      std::atomic<uint64_t>   numWaits;
+      std::atomic<uint64_t>   numWaitTimeouts;
+      std::atomic<uint64_t>   waitTimeNs;
+      std::atomic<uint64_t>   maxWaitTimeNs;
+    };
+
+    /**
+     * @brief The statistics block of the buffer, see IasAudioRingBufferStatistics
+     */
+    struct IasAudioRingBufferStatisticsBlock
+    {
+      IasAudioRingBufferStatisticsBlock();
+
+      IasAudioRingBufferAccessCounters  read;
+      IasAudioRingBufferAccessCounters  write;
+      std::atomic<uint32_t>             fillLevelMin;   //!< UINT32_MAX as long as nothing has been committed
+      std::atomic<uint32_t>             fillLevelMax;
+      std::atomic<uint64_t>             fillLevelHistogram[cIasAudioRingBufferFillLevelBins];
+    };
+
+    /**
+     * @brief Update the statistics after a successful commit
+     *
+     * @param[in] access       The access type (read or write)
+     * @param[in] frames       The number of committed frames
+     * @param[in] bufferLevel  The fill level after the commit
+     */
+    void updateCommitStatistics(IasRingBufferAccess access, uint32_t frames, uint32_t bufferLevel);
+
+    /**
+     * @brief Count an access that was rejected and hand the result through
+     */
+    IasAudioRingBufferResult countError(IasRingBufferAccess access, IasAudioRingBufferResult result);
+
+    /**
+     * @brief Count an access that got fewer frames than requested because of the fill level
+     */
+    void countXrun(IasRingBufferAccess access);
+
+    /**
+     * @brief Advance the frame position of a history and record an entry if a period boundary was crossed
+     */
+    void recordTimestamp(IasAudioRingBufferTimestampHistory &history, uint32_t frames);
+
+    /**
+     * @brief Set mBoundary to the initial value for the current geometry
+     */
+    void initBoundary();
+
+    /**
+     * @brief Claim the in-progress flags of the writer and all reader slots (eIasRingBuffSyncModeLockFree)
+     *
+     * @returns true if all flags were claimed, false if an access is in progress (no flag is claimed then)
+     */
+    bool claimAccessFlags();
+
+    /**
+     * @brief Release the flags claimed via claimAccessFlags
+     */
+    void releaseAccessFlags();
+
+    /**
+     * @brief Get the current CLOCK_MONOTONIC time in nanoseconds from the configured clock source
+     */
+    uint64_t getTimeNs() const;
+
+    /**
+     * @brief Read variant of beginAccess for eIasRingBuffSyncModeMutex
+     *
+     * @param[in] peeked True if the frames have been peeked before and are consumed now, then no frames are
+     *                   dropped for the latency bound
+     */
+    IasAudioRingBufferResult beginReadMutex(uint32_t* offset, uint32_t* frames, bool wrapAround, bool peeked);
+
+    /**
+     * @brief Lock-free variants of beginAccess/endAccess, used for eIasRingBuffSyncModeLockFree
+     *
+     * For beginReadLockFree, peeked is true if the frames have been peeked before and are consumed now.
+     * Then neither frames are dropped for the latency bound nor overwritten frames are skipped.
+     */
+    IasAudioRingBufferResult beginWriteLockFree(uint32_t* offset, uint32_t* frames, bool wrapAround);
+    IasAudioRingBufferResult endWriteLockFree(uint32_t frames, uint64_t timestamp, bool notify);
+    IasAudioRingBufferResult beginReadLockFree(uint32_t readerId, uint32_t* offset, uint32_t* frames, bool wrapAround, bool peeked);
+    IasAudioRingBufferResult endReadLockFree(uint32_t readerId, uint32_t frames, uint64_t timestamp, bool notify);
+
+    /**
+     * @brief Move the read position of a reader that was lapped by the writer to the oldest valid frame
+     *
+     * Only used for eIasRingBuffOverrunOverwrite, called by beginReadLockFree and peek after readCountBegin was loaded.
+     *
+     * @param[in] readerId The id of the reader
+     */
+    void skipOverwrittenFrames(uint32_t readerId);
+
+    /**
+     * @brief Notify the counterpart of a commit and write the fd signal if frames have been committed
+     */
+    void signalAccess(IasRingBufferAccess access, uint32_t frames);
+
+    /**
+     * @brief Drop the frames that exceed the read latency bound, see setReadLatencyBound
+     *
+     * Has to be called with the read flag of the reader held (mMutexReadInProgress in eIasRingBuffSyncModeMutex),
+     * in eIasRingBuffSyncModeLockFree after readCountBegin was loaded.
+     *
+     * @param[in] readerId The id of the reader
+     */
+    void applyReadLatencyBound(uint32_t readerId);
+
+    /**
+     * @brief Get the number of frames to drop for the read latency bound
+     *
+     * @param[in] readOffset   The current read offset
+     * @param[in] bufferLevel  The current fill level seen by the reader
+     */
+    uint32_t getLatencyBoundDrop(uint32_t readOffset, uint32_t bufferLevel) const;
+
+    /**
+     * @brief Get the number of attached readers, always 1 for eIasRingBuffSyncModeMutex
+     */
+    uint32_t getNumAttachedReaders() const;
+
+    /**
+     * @brief Crossfade from the frames that are going to be dropped to the frames behind them
+     *
+     * Has to be called before the read position is moved, i.e. while the writer is not allowed
+     * to overwrite the dropped frames. Nothing is done while more than one reader is attached,
+     * since the other readers must not see the modified frames.
+     */
+    void crossfadeDroppedFrames(uint32_t readOffset, uint32_t dropFrames, uint32_t bufferLevel);
+
+    /**
+     * @brief Get the fill level of one reader for eIasRingBuffSyncModeLockFree
+     *
+     * The read counter is loaded first, so that the result is never negative.
+     */
+    uint32_t getReaderFillLevel(const IasAudioRingBufferReader &reader) const;
+
+    /**
+     * @brief Get the fill level seen by the writer for eIasRingBuffSyncModeLockFree
+     *
+     * This is the fill level of the slowest attached reader, or 0 if no reader is attached.
+     *
+     * @param[in] writeCount The current write counter
+     */
+    uint32_t getWriterFillLevel(uint64_t writeCount) const;
+
+    /**
+     * @brief Wait until at least numFrames frames are available for the given access type
+     *
+     * Common implementation of waitRead and waitWrite. The reader id is ignored for write access.
+     */
+    IasAudioRingBufferResult waitForFrames(IasRingBufferAccess access, uint32_t readerId, uint32_t numFrames, uint32_t timeout_ms);
+
     uint32_t                                           mPeriodSize;       //!< period size in samples
     uint32_t                                           mNumPeriods;       //!< number of periods that fit in the buffer
     uint32_t                                           mNumChannels;      //!< number of channels per period
@@ -170,16 +753,15 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBufferReal
     uint32_t                                           mBufferLevel;      //!< fill level in samples
     bool                                               mShared;           //!< flag to indicate if the buffer is in shared memory
     bool                                               mInitialized;      //!< this flag is true when init function was successful
-    std::atomic<bool>                                  mReadInProgress;
+    std::atomic<bool>                                  mReadInProgress;   //!< only used in mutex mode, see IasAudioRingBufferReader for lock-free mode
     std::atomic<bool>                                  mWriteInProgress;
+    bool                                               mReadWrapAround;   //!< the current read access may wrap around the end of the buffer (mutex mode)
+    bool                                               mWriteWrapAround;  //!< the current write access may wrap around the end of the buffer
     boost::interprocess::offset_ptr<void>              mDataBuf;          //!< the offset pointer to the data memory
     IasIntProcMutex                                    mMutex;
     IasIntProcMutex                                    mMutexReadInProgress;  //!< to avoid that reset is executed while reading from buffer
     IasIntProcMutex                                    mMutexWriteInProgress; //!< to avoid that reset is executed while writing into buffer
-    IasIntProcCondVar                                  mCondRead;
-    IasIntProcCondVar                                  mCondWrite;
-    uint32_t                                           mReadWaitLevel;
-    uint32_t                                           mWriteWaitLevel;
+    IasIntProcFutex                                    mFutexWrite;       //!< Wakes up the writer waiting in waitWrite
     IasAudioTimestamp                                  mAudioTimestampAccessRead;  //!< AudioTimestamp of the last read access to the buffer
     IasAudioTimestamp                                  mAudioTimestampAccessWrite; //!< AudioTimestamp of the last write access to the buffer
     IasAudioRingBufferStreamingState                   mStreamingState;            //!< straming state: running, stopWrite, stopRead
@@ -189,6 +771,36 @@ class __attribute__ ((visibility ("default"))) IasAudioRingBufferReal
     int64_t                                            mHwPtrRead;         //!< Continuously increasing hw ptr for ALSA IO-plug for read.
     int64_t                                            mHwPtrWrite;        //!< Continuously increasing hw ptr for ALSA IO-plug for write.
     uint64_t                                           mBoundary;          //!< The boundary as warp around point for the read and write hw_ptr.
+    IasAudioCommonDataLayout                           mDataLayout;        //!< the layout of the samples in the data buffer
+    bool                                               mDoubleMapped;      //!< each channel plane is followed by a second mapping of itself
+    IasAudioRingBufferSyncMode                         mSyncMode;          //!< Selects the mutex based or the lock-free data path
+    std::atomic<uint64_t>                              mWriteCount;        //!< Monotonically increasing write position (frames), in mutex mode only used for the fill level of getState
+    IasAudioRingBufferReader                           mReaders[cIasAudioRingBufferMaxReaders]; //!< The reader slots, the futex of reader 0 is also used in mutex mode
+    uint32_t                                           mMaxReadFillLevel;  //!< The read latency bound in frames, 0 if disabled
+    uint32_t                                           mReadCrossfadeFrames; //!< The length of the crossfade after dropping frames
+    std::atomic<uint64_t>                              mNumDroppedFrames;  //!< The number of frames dropped because of the read latency bound
+    IasAudioRingBufferOverrunMode                      mOverrunMode;       //!< Clamp the writer to the free space or overwrite the oldest frames
+    std::atomic<uint64_t>                              mWriteReserve;      //!< End of the region the writer may be writing right now (frames), eIasRingBuffOverrunOverwrite only
+    std::atomic<uint64_t>                              mNumOverwrittenFrames; //!< The number of frames lost by all readers because of eIasRingBuffOverrunOverwrite
+    IasIntProcMutex                                    mMutexChannelGroups; //!< Protects mReadGroups and mWriteGroups
+    IasAudioRingBufferChannelGroups                    mReadGroups;        //!< State of the channel group read access
+    IasAudioRingBufferChannelGroups                    mWriteGroups;       //!< State of the channel group write access
+    IasAudioRingBufferClockSource                      mClockSource;       //!< The clock source for the timestamp history
+    uint64_t                                           mTscBaseTicks;      //!< TSC value at mTscBaseNs (eIasRingBuffClockTsc)
+    uint64_t                                           mTscBaseNs;         //!< CLOCK_MONOTONIC time at mTscBaseTicks (eIasRingBuffClockTsc)
+    double                                             mTscNsPerTick;      //!< The calibrated TSC period in nanoseconds (eIasRingBuffClockTsc)
+    IasAudioRingBufferTimestampHistory                 mReadHistory;       //!< Timestamp history of the read direction
+    IasAudioRingBufferTimestampHistory                 mWriteHistory;      //!< Timestamp history of the write direction
+    IasAudioRingBufferStatisticsBlock                  mStatistics;        //!< The statistics of the buffer
+    IasAudioRingBufferPublishedState                   mPublishedRead;     //!< The read state for the lock-free snapshot readers
+    IasAudioRingBufferPublishedState                   mPublishedWrite;    //!< The write state for the lock-free snapshot readers
+    std::atomic<uint32_t>                              mGeneration;        //!< Generation of the geometry, incremented by reconfigure
+    boost::interprocess::offset_ptr<void>              mRetiredDataBuf;    //!< the data memory replaced by the last reconfigure, kept for peeking readers
+    uint32_t                                           mPlanePaddingOption; //!< The requested plane padding, see IasAudioRingBufferOptions::planePadding
+    uint32_t                                           mPlanePadding;      //!< The padding between two channel planes in bytes
+    boost::interprocess::offset_ptr<uint8_t>           mMetaData;          //!< the offset pointer to the user meta data entry of the first period
+    uint32_t                                           mMetaDataSize;      //!< the size of one user meta data entry in bytes
+    uint32_t                                           mNumMetaData;       //!< the number of user meta data entries
 };
 
 inline bool operator==( IasAudioRingBufferReal const & left, IasAudioRingBufferReal const & right)
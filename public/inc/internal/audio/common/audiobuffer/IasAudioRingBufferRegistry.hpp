@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2018 Intel Corporation.All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file   IasAudioRingBufferRegistry.hpp
+ * @date   2018
+ * @brief  Shared directory of the shared memory segments of ring buffers and ring buffer pools.
+ */
+
+#ifndef IASAUDIORINGBUFFERREGISTRY_HPP_
+#define IASAUDIORINGBUFFERREGISTRY_HPP_
+
+#include <string>
+#include <vector>
+
+#include "audio/common/IasAudioCommonTypes.hpp"
+#include "audio/common/audiobuffer/IasMemoryAllocator.hpp"
+#include "internal/audio/common/IasIntProcMutex.hpp"
+
+namespace IasAudio {
+
+/*
+ * The name of the shared memory of the registry.
+ */
+static const std::string cIasAudioRingBufferRegistryName = "ias_audio_ringbuffer_registry";
+
+/*
+ * Maximum number of segments in the registry.
+ */
+static const uint32_t cIasAudioRingBufferRegistryMaxSegments = 256;
+
+/*
+ * Maximum length of the name of a segment in the registry, including the terminating zero.
+ */
+static const uint32_t cIasAudioRingBufferRegistryMaxNameLength = 64;
+
+/**
+ * @brief Directory of the shared memory segments of all ring buffers and ring buffer pools
+ *
+ * The creator of a shared ring buffer with an own segment or of a ring buffer pool adds the name
+ * of the segment, so that other processes can enumerate them, e.g. to take snapshots of the
+ * statistics. The registry itself is a small shared memory segment, which is created by the first
+ * process that needs it and is never removed. Each added segment gets a new generation, so a
+ * process that mapped a segment can detect that it has been removed and created again.
+ * The segments of a process that terminated without removing them stay in the registry until
+ * their names are added again, so the users have to expect that a segment cannot be mapped.
+ */
+class __attribute__ ((visibility ("default"))) IasAudioRingBufferRegistry
+{
+  public:
+    /**
+     * @brief The type of a registered segment
+     */
+    enum IasSegmentType
+    {
+      eIasSegmentUnused = 0,   //!< the entry is free
+      eIasSegmentRingBuffer,   //!< the segment of a shared ring buffer, see IasAudioRingBufferFactory::findRingBuffer(std::string)
+      eIasSegmentPool          //!< the segment of a ring buffer pool, see IasAudioRingBufferPool
+    };
+
+    /**
+     * @brief A registered segment
+     */
+    struct IasSegment
+    {
+      std::string     name;        //!< the name of the shared memory
+      IasSegmentType  type;        //!< the type of the segment
+      uint32_t        generation;  //!< the generation of the entry, changes when the name is added again
+    };
+
+    /**
+     * @brief Constructor
+     */
+    IasAudioRingBufferRegistry();
+
+    /**
+     * @brief Destructor, unmaps the registry
+     */
+    ~IasAudioRingBufferRegistry();
+
+    /**
+     * @brief Connect to the registry, it is created if it does not exist yet
+     *
+     * @param[in] groupName The group that gets access to the registry if it is created by this call
+     */
+    IasAudioCommonResult init(const std::string &groupName);
+
+    /**
+     * @brief Add a segment, an entry with the same name is replaced
+     *
+     * @param[in]  name       The name of the shared memory
+     * @param[in]  type       The type of the segment
+     * @param[out] generation The generation of the new entry, required to remove it
+     *
+     * @returns eIasResultOk on success, eIasResultInvalidParam if the name is too long,
+     *          eIasResultMemoryError if the registry is full
+     */
+    IasAudioCommonResult add(const std::string &name, IasSegmentType type, uint32_t *generation);
+
+    /**
+     * @brief Remove a segment
+     *
+     * The entry is only removed if it still has the given generation, i.e. if the segment has not
+     * been created again by another process in the meantime.
+     *
+     * @param[in] name       The name of the shared memory
+     * @param[in] generation The generation returned by add
+     */
+    IasAudioCommonResult remove(const std::string &name, uint32_t generation);
+
+    /**
+     * @brief Get all registered segments
+     *
+     * @param[out] segments The segments
+     */
+    void getSegments(std::vector<IasSegment> *segments) const;
+
+  private:
+    /**
+     * @brief Copy constructor, private unimplemented to prevent misuse.
+     */
+    IasAudioRingBufferRegistry(IasAudioRingBufferRegistry const &other);
+
+    /**
+     * @brief Assignment operator, private unimplemented to prevent misuse.
+     */
+    IasAudioRingBufferRegistry& operator=(IasAudioRingBufferRegistry const &other);
+
+    /**
+     * @brief One entry of the registry, located in the shared memory
+     */
+    struct IasAudioRingBufferRegistryEntry
+    {
+      IasAudioRingBufferRegistryEntry();
+
+      uint32_t  type;        //!< the IasSegmentType, eIasSegmentUnused if the entry is free
+      uint32_t  generation;  //!< the generation of the entry
+      char      name[cIasAudioRingBufferRegistryMaxNameLength];
+    };
+
+    /**
+     * @brief The header of the registry, located in the shared memory
+     */
+    struct IasAudioRingBufferRegistryHeader
+    {
+      IasAudioRingBufferRegistryHeader();
+
+      uint32_t          generation;  //!< the last generation handed out by add
+      IasIntProcMutex   mutex;       //!< serializes all accesses to the entries
+    };
+
+    IasMemoryAllocator                *mMemory;   //!< the allocator of the registry
+    IasAudioRingBufferRegistryHeader  *mHeader;   //!< the header of the registry
+    IasAudioRingBufferRegistryEntry   *mEntries;  //!< the entries of the registry
+};
+
+} // namespace IasAudio
+
+#endif // IASAUDIORINGBUFFERREGISTRY_HPP_
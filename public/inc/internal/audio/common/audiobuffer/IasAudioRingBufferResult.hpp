@@ -29,6 +29,7 @@ enum IasAudioRingBufferResult
   eIasRingBuffTimeOut,            //!< timeout exceeded
   eIasRingBuffProbeError,         //!< Probe error
   eIasRingBuffCondWaitFailed,     //!< Cond wait failed
+  eIasRingBuffDataOverwritten,    //!< The frames of the read access were overwritten by the writer
 };
 
 std::string toString(const IasAudioRingBufferResult&  type);
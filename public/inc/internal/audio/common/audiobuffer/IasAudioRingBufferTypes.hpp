@@ -29,5 +29,205 @@ enum IasAudioRingBufferStreamingState
 
 std::string toString(const IasAudioRingBufferStreamingState&  type);
 
+/*
+ * Synchronization mode of a real ring buffer.
+ */
+enum IasAudioRingBufferSyncMode
+{
+  eIasRingBuffSyncModeMutex = 0,   //!< read/write offsets and fill level are protected by the process-shared mutexes
+  eIasRingBuffSyncModeLockFree     //!< single producer/single consumer, offsets are atomic counters, no locks on the data path
+};
+
+std::string toString(const IasAudioRingBufferSyncMode&  type);
+
+/*
+ * Clock source for the timestamp history of a real ring buffer.
+ */
+enum IasAudioRingBufferClockSource
+{
+  eIasRingBuffClockMonotonic = 0,  //!< clock_gettime(CLOCK_MONOTONIC), served by the vDSO
+  eIasRingBuffClockTsc             //!< time stamp counter, converted to CLOCK_MONOTONIC nanoseconds (x86 only, falls back to eIasRingBuffClockMonotonic)
+};
+
+std::string toString(const IasAudioRingBufferClockSource&  type);
+
+/*
+ * Behavior of a real ring buffer when the writer is faster than the reader.
+ */
+enum IasAudioRingBufferOverrunMode
+{
+  eIasRingBuffOverrunClamp = 0,    //!< the write access is clamped to the free space, the writer never overtakes a reader
+  eIasRingBuffOverrunOverwrite     //!< the writer always gets the requested frames and overwrites the oldest ones, a lapped reader skips ahead (only eIasRingBuffSyncModeLockFree)
+};
+
+std::string toString(const IasAudioRingBufferOverrunMode&  type);
+
+/*
+ * Number of period boundaries kept in the timestamp history of each access direction.
+ */
+static const uint32_t cIasAudioRingBufferTimestampHistorySize = 32;
+
+/*
+ * One entry of the timestamp history: the time when the frame position crossed a period boundary.
+ */
+struct IasAudioRingBufferTimestampEntry
+{
+  IasAudioRingBufferTimestampEntry()
+    :framePosition(0)
+    ,timestampNs(0)
+  {}
+
+  uint64_t framePosition;  //!< Number of frames transferred since init, including the commit that crossed the boundary
+  uint64_t timestampNs;    //!< CLOCK_MONOTONIC time of the commit in nanoseconds
+};
+
+/*
+ * Maximum number of readers that can be attached to one real ring buffer at the same time
+ * (only supported by eIasRingBuffSyncModeLockFree). Reader 0 is the default reader.
+ */
+static const uint32_t cIasAudioRingBufferMaxReaders = 8;
+
+/*
+ * Maximum number of channels of a real ring buffer that supports channel group accesses.
+ */
+static const uint32_t cIasAudioRingBufferMaxGroupChannels = 64;
+
+/*
+ * Consistent snapshot of the positions, the fill level and the timestamps of a real ring buffer.
+ */
+struct IasAudioRingBufferState
+{
+  IasAudioRingBufferState()
+    :readOffset(0)
+    ,writeOffset(0)
+    ,bufferLevel(0)
+    ,hwPtrRead(0)
+    ,hwPtrWrite(0)
+    ,timestampRead()
+    ,timestampWrite()
+  {}
+
+  uint32_t          readOffset;      //!< The read offset in frames
+  uint32_t          writeOffset;     //!< The write offset in frames
+  uint32_t          bufferLevel;     //!< The fill level in frames (seen by the default reader in eIasRingBuffSyncModeLockFree)
+  int64_t           hwPtrRead;       //!< The hw pointer of the read side for the ALSA ioplug
+  int64_t           hwPtrWrite;      //!< The hw pointer of the write side for the ALSA ioplug
+  IasAudioTimestamp timestampRead;   //!< The timestamp of the last read access
+  IasAudioTimestamp timestampWrite;  //!< The timestamp of the last write access
+};
+
+/*
+ * Number of bins of the fill level histogram, each bin covers an equal share of the buffer size.
+ */
+static const uint32_t cIasAudioRingBufferFillLevelBins = 8;
+
+/*
+ * Statistics of one access direction of a real ring buffer.
+ */
+struct IasAudioRingBufferAccessStatistics
+{
+  IasAudioRingBufferAccessStatistics()
+    :numCommits(0)
+    ,numFrames(0)
+    ,numXruns(0)
+    ,numErrors(0)
+    ,numWaits(0)
+    ,numWaitTimeouts(0)
+    ,waitTimeNs(0)
+    ,maxWaitTimeNs(0)
+  {}
+
+  uint64_t numCommits;       //!< Number of successful endAccess calls
+  uint64_t numFrames;        //!< Number of frames transferred
+  uint64_t numXruns;         //!< Number of accesses that got fewer frames than requested, because the buffer was empty (read) or full (write)
+  uint64_t numErrors;        //!< Number of accesses rejected with eIasRingBuffNotAllowed or eIasRingBuffInvalidParam
+  uint64_t numWaits;         //!< Number of calls of waitRead or waitWrite that had to block, because not enough frames were available
+  uint64_t numWaitTimeouts;  //!< Number of waits that timed out
+  uint64_t waitTimeNs;       //!< Total time spent waiting in nanoseconds
+  uint64_t maxWaitTimeNs;    //!< Longest single wait in nanoseconds
+};
+
+/*
+ * Snapshot of the statistics of a real ring buffer.
+ */
+struct IasAudioRingBufferStatistics
+{
+  IasAudioRingBufferStatistics()
+    :read()
+    ,write()
+    ,bufferSize(0)
+    ,fillLevelMin(0)
+    ,fillLevelMax(0)
+    ,fillLevelHistogram()
+    ,numDroppedFrames(0)
+    ,numOverwrittenFrames(0)
+  {}
+
+  IasAudioRingBufferAccessStatistics read;          //!< Statistics of the read accesses (all readers)
+  IasAudioRingBufferAccessStatistics write;         //!< Statistics of the write accesses
+  uint32_t bufferSize;                              //!< The size of the buffer in frames
+  uint32_t fillLevelMin;                            //!< Minimum fill level seen after a commit
+  uint32_t fillLevelMax;                            //!< Maximum fill level seen after a commit
+  uint64_t fillLevelHistogram[cIasAudioRingBufferFillLevelBins]; //!< Number of commits per fill level range
+  uint64_t numDroppedFrames;                        //!< Frames dropped because of the read latency bound
+  uint64_t numOverwrittenFrames;                    //!< Frames lost by the readers because the writer overwrote them (eIasRingBuffOverrunOverwrite)
+};
+
+/*
+ * Alignment of the data memory of a real ring buffer in bytes (one cache line).
+ */
+static const uint32_t cIasAudioRingBufferDataAlignment = 64;
+
+/*
+ * Value of IasAudioRingBufferOptions::planePadding that selects the padding automatically: the plane stride is
+ * rounded up to an odd number of cache lines, so that the channel planes do not start on the same cache sets.
+ */
+static const uint32_t cIasAudioRingBufferPlanePaddingAuto = 0xFFFFFFFFu;
+
+/*
+ * Optional settings for the creation of a real ring buffer.
+ */
+struct IasAudioRingBufferOptions
+{
+  /**
+   * @brief Constructs the options with the default values, which result in the classic mutex based ring buffer.
+   */
+  IasAudioRingBufferOptions()
+    :syncMode(eIasRingBuffSyncModeMutex)
+    ,dataLayout(eIasLayoutNonInterleaved)
+    ,memoryOptions()
+    ,clockSource(eIasRingBuffClockMonotonic)
+    ,poolName()
+    ,reserveSize(0)
+    ,planePadding(cIasAudioRingBufferPlanePaddingAuto)
+    ,overrunMode(eIasRingBuffOverrunClamp)
+    ,maxChannels(0)
+  {}
+
+  IasAudioRingBufferSyncMode    syncMode;       //!< The synchronization mode between the writer and the reader
+  IasAudioCommonDataLayout      dataLayout;     //!< The layout of the samples, one plane per channel or interleaved frames
+  IasMemoryOptions              memoryOptions;  //!< Prefaulting, locking and huge pages for the memory of the buffer
+  IasAudioRingBufferClockSource clockSource;    //!< The clock source for the timestamp history
+  std::string                   poolName;       //!< The pool created via IasAudioRingBufferFactory::createRingBufferPool, empty for an own shared memory segment (only eIasRingBufferShared)
+  uint32_t                      reserveSize;    //!< Additional bytes in the own memory segment for IasAudioRingBufferFactory::reconfigureRingBuffer to a larger geometry
+  uint32_t                      planePadding;   //!< Bytes between two channel planes, or cIasAudioRingBufferPlanePaddingAuto (ignored for the interleaved layout and double mapped buffers)
+  IasAudioRingBufferOverrunMode overrunMode;    //!< The behavior of the writer if the buffer is full, eIasRingBuffOverrunOverwrite requires eIasRingBuffSyncModeLockFree
+  uint32_t                      maxChannels;    //!< The maximum number of channels for IasAudioRingBufferFactory::reconfigureRingBuffer, 0 for the number of channels at creation
+};
+
+/*
+ * One contiguous region of a ring buffer, in frames.
+ */
+struct IasAudioRingBufferRegion
+{
+  IasAudioRingBufferRegion()
+    :offset(0)
+    ,frames(0)
+  {}
+
+  uint32_t offset;  //!< Offset of the region in area steps (== frames)
+  uint32_t frames;  //!< Number of frames of the region, 0 if the region is not used
+};
+
 }
 #endif
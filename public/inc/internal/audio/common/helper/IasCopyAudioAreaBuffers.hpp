@@ -74,6 +74,37 @@ __attribute__ ((visibility ("default"))) void zeroAudioAreaBuffers(IasAudioArea
                                          uint32_t               destinNumFrames);
 
 
+/**
+ * @brief Fuction to crossfade from one part of an audio (ring) buffer to another one, both described
+ *        by IasAudioArea structs with the same data format.
+ *
+ * The destination samples are replaced by a linear crossfade from the fade-out samples to the
+ * destination samples. The crossfade can be split into several calls, e.g. if the buffer wraps
+ * around, by means of the parameters fadePosition and fadeLength.
+ *
+ * @param[in]  destinAreas        Vector of audio areas of the samples that shall be faded in (modified in place).
+ * @param[in]  format             Data format of both buffers.
+ * @param[in]  destinOffset       Sample offset for the destination buffer.
+ * @param[in]  numChannels        Number of channels to be crossfaded.
+ * @param[in]  chanIdx            Start channel index of both areas.
+ * @param[in]  numFrames          Number of frames to be crossfaded by this call.
+ * @param[in]  fadeOutAreas       Vector of audio areas of the samples that shall be faded out.
+ * @param[in]  fadeOutOffset      Sample offset for the fade-out buffer.
+ * @param[in]  fadePosition       Position of the first frame of this call within the whole crossfade.
+ * @param[in]  fadeLength         Length of the whole crossfade in frames.
+ */
+__attribute__ ((visibility ("default"))) void crossfadeAudioAreaBuffers(IasAudioArea const       *destinAreas,
+                                         IasAudioCommonDataFormat  format,
+                                         uint32_t               destinOffset,
+                                         uint32_t               numChannels,
+                                         uint32_t               chanIdx,
+                                         uint32_t               numFrames,
+                                         IasAudioArea const       *fadeOutAreas,
+                                         uint32_t               fadeOutOffset,
+                                         uint32_t               fadePosition,
+                                         uint32_t               fadeLength);
+
+
 } //namespace IasAudio
 
 #endif // IASCOPYAUDIOAREABUFFERS_HPP
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2018 Intel Corporation.All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+/**
+ * @file   IasCpuFeatures.hpp
+ * @date   2018
+ * @brief  Runtime detection of the SIMD instruction sets, used to select the optimized kernels.
+ *
+ * The library is built for the SSE2 baseline. Kernels for wider instruction sets are compiled
+ * with the target attribute into the same binary and selected at runtime, depending on the
+ * instruction sets supported by the CPU. The selection can be limited by the environment
+ * variable IAS_AUDIO_SIMD (sse2 or avx2), e.g. for A/B comparisons. SSE2 is the floor, because
+ * the sample rate converter and the sample format conversions use SSE2 unconditionally.
+ */
+
+#ifndef IASCPUFEATURES_HPP_
+#define IASCPUFEATURES_HPP_
+
+#include "audio/common/IasAudioCommonTypes.hpp"
+
+namespace IasAudio {
+
+/**
+ * @brief The SIMD instruction sets, ordered by their capabilities
+ */
+enum IasSimdLevel
+{
+  eIasSimdSse2 = 0,     //!< SSE and SSE2, the baseline of the library
+  eIasSimdAvx2,         //!< AVX2 together with FMA
+};
+
+/**
+ * @brief Get the SIMD level that shall be used by the optimized kernels
+ *
+ * The level is determined once, when the function is called for the first time. It is the
+ * highest level supported by the CPU and the operating system, limited by IAS_AUDIO_SIMD.
+ * A warning is logged if IAS_AUDIO_SIMD has an unknown value or requests a level the CPU does not support.
+ *
+ * @returns The SIMD level to use
+ */
+__attribute__ ((visibility ("default"))) IasSimdLevel getSimdLevel();
+
+/**
+ * @brief Get the highest SIMD level supported by the CPU and the operating system
+ *
+ * @returns The detected SIMD level, not limited by IAS_AUDIO_SIMD
+ */
+__attribute__ ((visibility ("default"))) IasSimdLevel detectSimdLevel();
+
+/**
+ * @brief Function to get a IasSimdLevel as string.
+ * @return Enum Member as string
+ */
+__attribute__ ((visibility ("default"))) std::string toString(const IasSimdLevel& type);
+
+} //namespace IasAudio
+
+#endif /* IASCPUFEATURES_HPP_ */
@@ -86,6 +86,8 @@ class __attribute__ ((visibility ("default"))) IasSrcFarrow
         ,fsRatioInv(1.0)
         ,filterLength(0u)
         ,numFilters(0u)
+        ,numPhases(0u)
+        ,phaseStep(0u)
         ,inputBlocklen(0u)
         ,outputBlocklen(0u)
       {
@@ -100,6 +102,8 @@ class __attribute__ ((visibility ("default"))) IasSrcFarrow
       double  fsRatioInv;        //!< Conversion ratio: outputRate/inputRate
       uint32_t   filterLength;      //!< Length of the impulse responses used for this conversion rate.
       uint32_t   numFilters;        //!< Number of filters used for this conversion rate.
+      uint32_t   numPhases;         //!< outputRate/gcd(inputRate,outputRate) for an exact ratio with a short period, otherwise 0.
+      uint32_t   phaseStep;         //!< inputRate/gcd(inputRate,outputRate).
 
       // Member variables that are used for the command eIasDetunePitch.
       uint32_t   inputBlocklen;     //!< Block length that will be used at the SRC's input.
@@ -126,6 +130,12 @@ class __attribute__ ((visibility ("default"))) IasSrcFarrow
     /*!
      * @brief Set the conversion ratio.
      *
+     * If the reduced conversion ratio inputRate/outputRate has a denominator of
+     * at most 16 (e.g., 48000/16000, 48000/32000, 16000/48000), the t values of the
+     * output samples only take a few distinct values. The SSE variant then uses
+     * precomputed impulse responses for these phases, as long as the conversion
+     * ratio is not adjusted (ratioAdjustment == 1.0) and not detuned.
+     *
      * @param[in] inputRate   Sample rate at the input port.
      * @param[in] outputRate  Sample rate at the output port.
      */
@@ -371,12 +381,46 @@ class __attribute__ ((visibility ("default"))) IasSrcFarrow
      */
     void updateImpulseResponseN7(float *destination, float tValue) const;
 
+    /*!
+     *  @brief Private function to update the time variant impulse response, using numFilters prototype
+     *         impulse responses. AVX2/FMA variant, selected at runtime if the CPU supports it.
+     *  @param[out] Buffer for storing the time variant impulse response.
+     *              Must be big enough to carry mFilterLength coefficients.
+     */
+    template <uint32_t numFilters>
+    void updateImpulseResponseAvx2(float *destination, float tValue) const;
+
+    /*!
+     *  @brief Private function to generate the output samples of one block (SSE variant only).
+     *
+     *  The output samples are generated either by interpolating their impulse responses
+     *  or by means of the classic Farrow structure, whichever needs fewer operations for
+     *  the given number of channels, filter length and number of prototype impulse responses.
+     *
+     *  If @a usePhases is true, the impulse responses of the output samples have already
+     *  been selected from the precomputed phase impulse responses, so that they do not
+     *  have to be interpolated.
+     *
+     *  @param[in] numBlockInputSamples  Number of input samples inserted for this block.
+     *  @param[in] numBlockOutputSamples Number of output samples scheduled for this block.
+     *  @param[in] usePhases             True if the block has been scheduled with the exact phases.
+     */
+    template <typename T2>
+    IasResult processBlock(T2       **outputBuffers,
+                           uint32_t   numBlockInputSamples,
+                           uint32_t   numBlockOutputSamples,
+                           uint32_t   numChannels,
+                           bool       usePhases);
+
 
     /*!
      *  @brief Private constants.
      */
     uint32_t static const cMaxFilterLength = 128; //!< maximum length of the impulse responses
     uint32_t static const cMaxNumFilters   = 7;   //!< maximum number of impulse responses
+    uint32_t static const cBlockLength     = 32;  //!< maximum number of input and of output samples processed as one block
+    uint32_t static const cTimeVarImpRespStride = cMaxFilterLength+8; //!< distance between the time-variant impulse responses of one block
+    uint32_t static const cMaxNumPhases    = 16;  //!< maximum number of phases of an exact conversion ratio with precomputed impulse responses
 
     /*!
      *  @brief Member variables.
@@ -392,10 +436,17 @@ class __attribute__ ((visibility ("default"))) IasSrcFarrow
     uint32_t             mRingBufferIndex;   //!< index for accessing the ring buffer (write index for push-mode, read index for pull-mode)
     uint32_t             mFilterLength;      //!< Length of the impulse responses used for this conversion rate.
     uint32_t             mNumFilters;        //!< Number of filters used for this conversion rate.
+    uint32_t             mNumPhases;         //!< Number of phases of an exact conversion ratio, 0 if the impulse responses are always interpolated.
+    uint32_t             mPhaseStep;         //!< Phase increment per output sample (push mode), in units of 1/mNumPhases.
     bool               mIsInitialized;     //!< becomes true after IasSrcFarrow::init() has been called
 
     float const     *mImpulseResponses[cMaxNumFilters]; //!< vector with pointers to the prototype impulse responses
-    float           *mTimeVarImpResp;                   //!< pointer to buffer with time-variant impulse response
+    float           *mTimeVarImpResp;                   //!< pointer to buffer with time-variant impulse response (one per output sample of a block for the SSE variant)
+    float           *mPhaseImpResp;                     //!< impulse responses of the phases k/mNumPhases, k = 0..mNumPhases (SSE variant, part of the buffer of mTimeVarImpResp)
+    float const     *mBlockImpulseResponses[cBlockLength]; //!< impulse response of each output sample of a block
+    uint32_t         mBlockOutputIndices[cBlockLength]; //!< output buffer indices of the output samples of a block
+    uint32_t         mBlockInputDelays[cBlockLength];   //!< number of input samples of a block that are newer than each output sample
+    float            mBlockTValues[cBlockLength];       //!< t value of each output sample of a block
     IasSrcFarrowFirFilter  *mFirFilterMultiChan;               //!< pointer to the multi-channel FIR filter
     tbb::concurrent_queue<IasCommandQueueEntry> mCommandQueue; //!< internal queue for buffering commands.
 
@@ -83,6 +83,12 @@ class __attribute__ ((visibility ("default"))) IasSrcWrapper : public IasSrcWrap
                                         uint32_t srcOffset,
                                         uint32_t sinkOffset);
 
+    /**
+     * @brief Process function of sample rate converter wrapper for an input that wraps around,
+     *        see IasSrcWrapperBase
+     */
+    using IasSrcWrapperBase::process;
+
     /**
      * @brief Reset function of sample rate converter wrapper
      *
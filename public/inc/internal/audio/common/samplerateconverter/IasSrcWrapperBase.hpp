@@ -15,6 +15,7 @@
 
 
 #include "audio/common/IasAudioCommonTypes.hpp"
+#include "internal/audio/common/audiobuffer/IasAudioRingBufferTypes.hpp"
 
 namespace IasAudio{
 
@@ -114,6 +115,52 @@ class __attribute__ ((visibility ("default"))) IasSrcWrapperBase
                                         uint32_t srcOffset,
                                         uint32_t sinkOffset) = 0;
 
+    /**
+     * @brief Process function of sample rate converter wrapper for an input that wraps around
+     *
+     * The input is given as the head and the tail region returned by the two-region variant of
+     * IasAudioRingBuffer::beginAccess. The tail region is only processed, if the head region was
+     * consumed completely and the desired number of output samples is not generated yet.
+     * The default implementation calls the single-region process function for the head and then
+     * for the tail region.
+     *
+     * @params[out] numGeneratedSamples Number of generated samples by the sample rate converter
+     * @params[out] numConsumedSamples Number of consumed samples by the sample rate converter (head and tail)
+     * @params[in]  srcHead The first region of the source buffer
+     * @params[in]  srcTail The second region of the source buffer, may be empty
+     * @params[in]  numOutputSamples The number of sample that still needs to be processed
+     * @param[in]   sinkOffset The offset in the sink buffer
+     *
+     * @returns error code
+     * @retval eIasOk all went well
+     * @retval eIasFailed an error occurred
+     */
+    virtual IasSrcWrapperResult process(uint32_t *numGeneratedSamples,
+                                        uint32_t *numConsumedSamples,
+                                        const IasAudioRingBufferRegion &srcHead,
+                                        const IasAudioRingBufferRegion &srcTail,
+                                        uint32_t numOutputSamples,
+                                        uint32_t sinkOffset)
+    {
+      uint32_t generatedSamples = 0;
+      uint32_t consumedSamples = 0;
+      IasSrcWrapperResult res = process(&generatedSamples, &consumedSamples, srcHead.frames, numOutputSamples, srcHead.offset, sinkOffset);
+      *numGeneratedSamples = generatedSamples;
+      *numConsumedSamples = consumedSamples;
+
+      // Continue with the tail region only if the head region is used up, otherwise the
+      // converter has already generated all requested samples.
+      if ((res == eIasOk) && (srcTail.frames > 0) &&
+          (consumedSamples == srcHead.frames) && (generatedSamples < numOutputSamples))
+      {
+        res = process(&generatedSamples, &consumedSamples, srcTail.frames, numOutputSamples - generatedSamples,
+                      srcTail.offset, sinkOffset + generatedSamples);
+        *numGeneratedSamples += generatedSamples;
+        *numConsumedSamples += consumedSamples;
+      }
+      return res;
+    }
+
     /**
      * @brief Reset function of sample rate converter wrapper
      *